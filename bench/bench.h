@@ -0,0 +1,89 @@
+#ifndef LIBEDGE_BENCH_H
+#define LIBEDGE_BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief 单调纳秒时钟
+ */
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 周期计数器 (x86 为 TSC；其它平台退化为纳秒)
+ */
+static inline uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return bench_now_ns();
+#endif
+}
+
+/**
+ * @brief 阻止编译器把被测结果优化掉
+ */
+#define BENCH_KEEP(x) __asm__ __volatile__("" : : "r"(x) : "memory")
+
+/**
+ * @brief 被测操作：执行一次并返回处理的字节数
+ */
+typedef size_t (*bench_op_fn)(void *arg);
+
+typedef struct {
+    const char *name;
+    const char *layout;
+    size_t bytes;           // 单次操作的字节数
+    uint64_t iters;
+    double ns_per_op;
+    double ops_per_sec;
+    double cycles_per_byte;
+} bench_result_t;
+
+/**
+ * @brief 自动标定迭代次数 (单轮至少 min_ns)，取三轮中最快的一轮
+ */
+static inline bench_result_t bench_measure(const char *name, const char *layout, bench_op_fn fn, void *arg, uint64_t min_ns) {
+    bench_result_t r = { name, layout, 0, 1, 0, 0, 0 };
+    r.bytes = fn(arg);
+    for (;;) {
+        uint64_t t0 = bench_now_ns();
+        for (uint64_t i = 0; i < r.iters; i++) BENCH_KEEP(fn(arg));
+        if (bench_now_ns() - t0 >= min_ns / 4 || r.iters >= (1ull << 32)) break;
+        r.iters *= 2;
+    }
+    r.iters *= 4;
+    double best_ns = 0, best_cyc = 0;
+    for (int round = 0; round < 3; round++) {
+        uint64_t t0 = bench_now_ns(), c0 = bench_cycles();
+        for (uint64_t i = 0; i < r.iters; i++) BENCH_KEEP(fn(arg));
+        double ns = (double)(bench_now_ns() - t0), cyc = (double)(bench_cycles() - c0);
+        if (round == 0 || ns < best_ns) { best_ns = ns; best_cyc = cyc; }
+    }
+    r.ns_per_op = best_ns / (double)r.iters;
+    r.ops_per_sec = r.ns_per_op > 0 ? 1e9 / r.ns_per_op : 0;
+    r.cycles_per_byte = r.bytes ? best_cyc / (double)r.iters / (double)r.bytes : 0;
+    return r;
+}
+
+/**
+ * @brief 输出一条 JSON 记录 (first 为首条时不加逗号)
+ */
+static inline void bench_json_write(FILE *f, const bench_result_t *r, int first) {
+    fprintf(f, "%s\n    {\"name\": \"%s\", \"layout\": \"%s\", \"bytes\": %zu, \"iterations\": %llu, "
+               "\"ns_per_frame\": %.2f, \"frames_per_sec\": %.0f, \"cycles_per_byte\": %.3f}",
+            first ? "" : ",", r->name, r->layout, r->bytes, (unsigned long long)r->iters,
+            r->ns_per_op, r->ops_per_sec, r->cycles_per_byte);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include "bench.h"
+#include "common/crc.h"
+
+typedef uint16_t (*crc_fn)(const uint8_t *data, size_t length);
+
+static const struct { const char *name; crc_fn fn; } k_crcs[] = {
+    { "ccitt", edge_crc16_ccitt },
+    { "modbus", edge_crc16_modbus },
+    { "dnp3", edge_crc16_dnp3 },
+};
+
+static const edge_crc_engine_t k_engines[] = {
+    EDGE_CRC_ENGINE_BITWISE, EDGE_CRC_ENGINE_SLICE4, EDGE_CRC_ENGINE_SLICE8, EDGE_CRC_ENGINE_CLMUL,
+};
+
+static const size_t k_sizes[] = { 16, 64, 256, 4096 };
+
+int main(void) {
+    static uint8_t buf[4096];
+    for (size_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)(i * 31u + 7u);
+
+    printf("%-8s %-8s %6s %12s %12s\n", "crc", "engine", "bytes", "bytes/cycle", "MB/s");
+    for (size_t e = 0; e < sizeof(k_engines) / sizeof(k_engines[0]); e++) {
+        if (!edge_crc_set_engine(k_engines[e])) continue;
+        for (size_t c = 0; c < sizeof(k_crcs) / sizeof(k_crcs[0]); c++) {
+            for (size_t s = 0; s < sizeof(k_sizes) / sizeof(k_sizes[0]); s++) {
+                size_t len = k_sizes[s];
+                size_t iters = (64u << 20) / len / (k_engines[e] == EDGE_CRC_ENGINE_BITWISE ? 8 : 1);
+                uint64_t c0 = bench_cycles(), t0 = bench_now_ns();
+                for (size_t i = 0; i < iters; i++) {
+                    uint16_t r = k_crcs[c].fn(buf, len);
+                    BENCH_KEEP(r);
+                }
+                uint64_t c1 = bench_cycles(), t1 = bench_now_ns();
+                double bytes = (double)iters * (double)len;
+                printf("%-8s %-8s %6zu %12.3f %12.1f\n", k_crcs[c].name, edge_crc_engine_name(k_engines[e]), len,
+                       bytes / (double)(c1 - c0), bytes * 1e3 / (double)(t1 - t0));
+            }
+        }
+    }
+    edge_crc_set_engine(EDGE_CRC_ENGINE_AUTO);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "edge_core.h"
+#include "protocols/edge_dlt645.h"
+
+#define GARBAGE_LEN (1u << 20)
+
+/**
+ * @brief 旧实现：逐字节 read_u8 搜索同步头
+ */
+static size_t scan_bytewise(edge_cursor_t *c, const uint8_t *pat, size_t plen) {
+    uint8_t b, prev = 0; size_t n = 0;
+    while (edge_cursor_read_u8(c, &b) == EP_OK) {
+        n++;
+        if (plen == 1 ? b == pat[0] : (prev == pat[0] && b == pat[1])) break;
+        prev = b;
+    }
+    return n;
+}
+
+static void report(const char *name, const char *layout, size_t bytes, size_t iters, uint64_t ns, uint64_t cyc) {
+    printf("%-14s %-10s %10.1f MB/s %8.3f bytes/cycle\n", name, layout,
+           (double)bytes * (double)iters * 1e3 / (double)ns, (double)bytes * (double)iters / (double)cyc);
+}
+
+int main(void) {
+    uint8_t *buf = malloc(GARBAGE_LEN + 32);
+    uint32_t seed = 1;
+    // 噪声中不含 0x68/0x7E，但 0x05 频繁出现，模拟失步的 DNP3/DLT645 线路
+    for (size_t i = 0; i < GARBAGE_LEN; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint8_t b = (uint8_t)(seed >> 16);
+        buf[i] = (b == 0x68 || b == 0x7E) ? 0x00 : b;
+    }
+    static const uint8_t dlt645[] = { 0x68, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x68, 0x91, 0x04, 0x33, 0x33, 0x34, 0x33, 0x00, 0x16 };
+    memcpy(buf + GARBAGE_LEN, dlt645, sizeof(dlt645));
+    size_t total = GARBAGE_LEN + sizeof(dlt645);
+
+    struct iovec single = { buf, total };
+    static struct iovec frag[4096];
+    int nfrag = 0;
+    for (size_t off = 0; off < total; nfrag++) {
+        size_t len = 64 + (size_t)((nfrag * 977) % 1400);
+        if (off + len > total) len = total - off;
+        frag[nfrag].iov_base = buf + off; frag[nfrag].iov_len = len;
+        off += len;
+    }
+
+    static const uint8_t p1[] = { 0x68 }, p2[] = { 0x68, 0x01 };
+    const struct { const struct iovec *iov; int cnt; const char *name; } layouts[] = {
+        { &single, 1, "single" }, { frag, nfrag, "fragmented" },
+    };
+    const size_t iters = 32;
+    for (size_t l = 0; l < 2; l++) {
+        for (size_t plen = 1; plen <= 2; plen++) {
+            const uint8_t *pat = plen == 1 ? p1 : p2;
+            edge_cursor_t c;
+            uint64_t t0 = bench_now_ns(), c0 = bench_cycles();
+            for (size_t i = 0; i < iters; i++) {
+                edge_cursor_init(&c, layouts[l].iov, layouts[l].cnt);
+                size_t sk; edge_cursor_scan(&c, pat, plen, &sk); BENCH_KEEP(sk);
+            }
+            report(plen == 1 ? "scan1" : "scan2", layouts[l].name, total, iters, bench_now_ns() - t0, bench_cycles() - c0);
+
+            t0 = bench_now_ns(); c0 = bench_cycles();
+            for (size_t i = 0; i < iters; i++) {
+                edge_cursor_init(&c, layouts[l].iov, layouts[l].cnt);
+                size_t sk = scan_bytewise(&c, pat, plen); BENCH_KEEP(sk);
+            }
+            report(plen == 1 ? "bytewise1" : "bytewise2", layouts[l].name, total, iters, bench_now_ns() - t0, bench_cycles() - c0);
+        }
+
+        // DLT645 解析器在噪声后重同步
+        edge_dlt645_context_t ctx; edge_dlt645_init(&ctx, "000000000001");
+        uint64_t t0 = bench_now_ns(), c0 = bench_cycles();
+        for (size_t i = 0; i < iters; i++) {
+            edge_cursor_t c; edge_cursor_init(&c, layouts[l].iov, layouts[l].cnt);
+            uint32_t di; const uint8_t *data; size_t len;
+            edge_error_t err = edge_dlt645_parse_frame(&ctx, &c, &di, &data, &len); BENCH_KEEP(err);
+        }
+        report("dlt645_resync", layouts[l].name, total, iters, bench_now_ns() - t0, bench_cycles() - c0);
+    }
+    free(buf);
+    return EXIT_SUCCESS;
+}
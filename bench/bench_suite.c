@@ -0,0 +1,368 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "edge_core.h"
+#include "common/crc.h"
+#include "protocols/edge_modbus.h"
+#include "protocols/edge_dlt645.h"
+#include "protocols/edge_dlt698.h"
+#include "protocols/edge_dlms.h"
+#include "libedge/edge_iec104.h"
+#include "libedge/edge_dnp3.h"
+
+/*
+ * 全协议编解码基准：每个用例分别以单段输入与按 FRAG 字节切分的多段输入运行，
+ * 结果以 JSON 数组输出 (默认 stdout，或 --json <file>)，便于跨版本比对。
+ * 用法: bench_suite [--json out.json] [--min-ms N] [名称子串过滤]
+ * JSON 中的 "build" 记录构建形态 (split / amalgamated，附 +lto)，分别构建后对比即可看出跨单元内联的收益。
+ */
+
+#ifndef EDGE_BENCH_BUILD_FLAVOR
+#define EDGE_BENCH_BUILD_FLAVOR "unknown"
+#endif
+
+#define FRAG 7          // 多段布局的段长，模拟被 TCP/串口切碎的输入
+#define MAX_SEGS 512
+
+/* --- 输入夹具 --- */
+typedef struct {
+    uint8_t buf[2048];
+    size_t len;
+    struct iovec iov[MAX_SEGS];
+    int count;
+} fixture_t;
+
+static void fixture_set(fixture_t *f, const uint8_t *data, size_t len, bool fragmented) {
+    memcpy(f->buf, data, len); f->len = len; f->count = 0;
+    for (size_t off = 0; off < len; f->count++) {
+        size_t n = fragmented ? FRAG : len;
+        if (n > len - off) n = len - off;
+        f->iov[f->count].iov_base = f->buf + off; f->iov[f->count].iov_len = n;
+        off += n;
+    }
+}
+
+static void fixture_from_vector(fixture_t *f, const edge_vector_t *v, bool fragmented) {
+    uint8_t tmp[2048]; size_t n = 0;
+    edge_vector_flatten(v, tmp, sizeof(tmp), &n);
+    fixture_set(f, tmp, n, fragmented);
+}
+
+static fixture_t g_in;
+static uint8_t g_payload[1024];
+
+/* --- core 原语 --- */
+static size_t op_cursor_read_u8(void *arg) {
+    (void)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    uint8_t b, acc = 0;
+    while (edge_cursor_read_u8(&c, &b) == EP_OK) acc ^= b;
+    BENCH_KEEP(acc);
+    return g_in.len;
+}
+
+static size_t op_cursor_read_be16_array(void *arg) {
+    (void)arg;
+    static uint16_t out[512];
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    edge_cursor_read_be16_array(&c, out, g_in.len / 2);
+    return g_in.len;
+}
+
+static size_t op_cursor_scan(void *arg) {
+    (void)arg;
+    static const uint8_t pat[2] = { 0x05, 0x64 };
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    edge_cursor_scan(&c, pat, 2, NULL);
+    return g_in.len;
+}
+
+static size_t op_vector_put(void *arg) {
+    (void)arg;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    for (int i = 0; i < 32; i++) edge_vector_put_be16(&v, (uint16_t)i);
+    return v.total_len;
+}
+
+static size_t op_vector_ref_finalize(void *arg) {
+    (void)arg;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[32]; edge_vector_t v; edge_vector_init(&v, iov, 32);
+    for (int i = 0; i < 8; i++) { edge_vector_put_u8(&v, (uint8_t)i); edge_vector_append_ref(&v, g_payload + i * 8, 8); }
+    edge_vector_finalize(&v, NULL);
+    return v.total_len;
+}
+
+/* --- CRC：多段布局走 cursor 校验接口 --- */
+static size_t op_crc(void *arg) {
+    edge_check_kind_t kind = (edge_check_kind_t)(intptr_t)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    uint16_t out; edge_cursor_checksum(&c, kind, g_in.len, &out);
+    BENCH_KEEP(out);
+    return g_in.len;
+}
+
+/* --- 协议构建 --- */
+static edge_modbus_context_t g_mb_rtu, g_mb_tcp;
+static edge_dlt645_context_t g_645;
+static edge_hdlc_manager_t g_hdlc;
+static edge_iec104_context_t g_104;
+static edge_dnp3_context_t g_dnp3;
+static const uint8_t k_get_apdu[] = { 0xC0, 0x01, 0xC1, 0x00, 0x03, 0x01, 0x00, 0x01, 0x08, 0x00, 0xFF, 0x02, 0x00 };
+
+static size_t op_modbus_build(void *arg) {
+    edge_arena_thread_frame_begin();
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    edge_modbus_build_read_holding_req((edge_modbus_context_t *)arg, &v, 100, 10);
+    return v.total_len;
+}
+
+static size_t op_dlt645_build(void *arg) {
+    (void)arg;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    edge_dlt645_build_read_req(&g_645, &v, 0x00010000);
+    return v.total_len;
+}
+
+static size_t op_dlt698_build(void *arg) {
+    (void)arg;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    edge_d698_build_get_request(&v, 0x00100200);
+    return v.total_len;
+}
+
+static size_t op_hdlc_build(void *arg) {
+    (void)arg;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8);
+    edge_hdlc_build_iframe(&g_hdlc, &v, k_get_apdu, sizeof(k_get_apdu), true);
+    return v.total_len;
+}
+
+static size_t op_iec104_build(void *arg) {
+    (void)arg;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    edge_iec104_build_s_frame(&v, &g_104);
+    return v.total_len;
+}
+
+static size_t op_dnp3_build(void *arg) {
+    (void)arg;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[40]; edge_vector_t v; edge_vector_init(&v, iov, 40);
+    edge_dnp3_build_link_frame(&g_dnp3, &v, 0xC4, g_payload, 250);
+    return v.total_len;
+}
+
+/* --- 协议解析：输入来自 g_in --- */
+static size_t op_modbus_parse(void *arg) {
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    uint8_t fc; const uint8_t *data; size_t len;
+    edge_modbus_parse_response((edge_modbus_context_t *)arg, &c, &fc, &data, &len);
+    return g_in.len;
+}
+
+/* 从站：单元 1 的 125 个保持寄存器，读响应直接引用线路序镜像 */
+static uint8_t g_slave_image[EDGE_MODBUS_MAX_READ_REGS * 2];
+static edge_modbus_block_t g_slave_hr = { 0, EDGE_MODBUS_MAX_READ_REGS, g_slave_image };
+static edge_modbus_unit_map_t g_slave_unit = { .unit_id = 1, .blocks = { [EDGE_MODBUS_TABLE_HOLDING_REGISTERS] = &g_slave_hr },
+                                               .block_count = { [EDGE_MODBUS_TABLE_HOLDING_REGISTERS] = 1 } };
+static edge_modbus_slave_t g_slave;
+
+static size_t op_modbus_slave(void *arg) {
+    (void)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    edge_arena_thread_frame_begin();
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    edge_modbus_slave_handle_tcp(&g_slave, &c, &v);
+    return v.total_len;
+}
+
+static size_t op_dlt645_parse(void *arg) {
+    (void)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    uint32_t di; const uint8_t *data; size_t len;
+    edge_dlt645_parse_frame(&g_645, &c, &di, &data, &len);
+    return g_in.len;
+}
+
+static size_t op_dlt698_parse(void *arg) {
+    (void)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    d698_data_tag_t tag; const uint8_t *data; size_t len;
+    while (edge_d698_parse_data(&c, &tag, &data, &len) == EP_OK && edge_cursor_skip(&c, len) == EP_OK) {}
+    return g_in.len;
+}
+
+static size_t op_hdlc_parse(void *arg) {
+    (void)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    edge_cursor_t apdu; edge_dlms_variant_t var;
+    if (edge_hdlc_parse_slice(&g_hdlc, &c, &apdu) == EP_OK) {
+        edge_cursor_skip(&apdu, 4); // C4 01 C1 00
+        while (edge_dlms_decode_variant(&apdu, &var) == EP_OK && var.data) {}
+    }
+    return g_in.len;
+}
+
+static size_t op_iec104_parse(void *arg) {
+    (void)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    uint16_t c1, c2; edge_cursor_t asdu;
+    while (edge_iec104_parse_apdu(&c, &c1, &c2, &asdu) == EP_OK) {}
+    return g_in.len;
+}
+
+static size_t op_dnp3_parse(void *arg) {
+    (void)arg;
+    edge_cursor_t c; edge_cursor_init(&c, g_in.iov, g_in.count);
+    edge_dnp3_link_header_t hdr; struct iovec blocks[EDGE_DNP3_MAX_BLOCKS]; edge_cursor_t user;
+    edge_dnp3_link_unpack(&c, &hdr, blocks, EDGE_DNP3_MAX_BLOCKS, &user);
+    return g_in.len;
+}
+
+/* --- 解析输入 --- */
+static void make_modbus_resp(bool tcp, uint8_t *out, size_t *n) {
+    size_t p = 0;
+    if (tcp) { static const uint8_t mbap[] = { 0x00, 0x01, 0x00, 0x00, 0x00, 0xFD }; memcpy(out, mbap, 6); p = 6; }
+    out[p++] = 1; out[p++] = 0x03; out[p++] = 250;
+    for (int i = 0; i < 250; i++) out[p++] = (uint8_t)i;
+    if (!tcp) { uint16_t crc = edge_crc16_modbus(out, p); out[p++] = (uint8_t)crc; out[p++] = (uint8_t)(crc >> 8); }
+    *n = p;
+}
+
+static void make_dlt645_resp(uint8_t *out, size_t *n) {
+    static const uint8_t hdr[] = { 0x68, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x68, 0x91, 0x08, 0x33, 0x33, 0x34, 0x33 };
+    memcpy(out, hdr, sizeof(hdr));
+    size_t p = sizeof(hdr);
+    for (int i = 0; i < 4; i++) out[p++] = (uint8_t)(0x45 + i);
+    uint8_t cs = 0; for (size_t i = 0; i < p; i++) cs = (uint8_t)(cs + out[i]);
+    out[p++] = cs; out[p++] = 0x16;
+    *n = p;
+}
+
+static void make_dlt698_data(uint8_t *out, size_t *n) {
+    size_t p = 0;
+    for (int i = 0; i < 32; i++) {
+        out[p++] = D698_TAG_LONG_UNSIGNED; out[p++] = 0x12; out[p++] = (uint8_t)i;
+        out[p++] = D698_TAG_OCTET_STRING; out[p++] = 6;
+        for (int k = 0; k < 6; k++) out[p++] = (uint8_t)(i + k);
+    }
+    *n = p;
+}
+
+static void make_hdlc_resp(edge_vector_t *v) {
+    static uint8_t apdu[256];
+    size_t p = 0;
+    apdu[p++] = 0xC4; apdu[p++] = 0x01; apdu[p++] = 0xC1; apdu[p++] = 0x00;
+    while (p + 5 <= sizeof(apdu) - 8) { apdu[p++] = DLMS_TAG_DOUBLE_LONG_UNSIGNED; apdu[p++] = 0; apdu[p++] = 0; apdu[p++] = 1; apdu[p] = (uint8_t)(p + 1); p++; }
+    edge_hdlc_build_iframe(&g_hdlc, v, apdu, p, true);
+}
+
+static void make_iec104_stream(uint8_t *out, size_t *n) {
+    size_t p = 0;
+    for (int i = 0; i < 16; i++) {
+        static const uint8_t asdu[] = { 0x01, 0x01, 0x03, 0x00, 0x01, 0x00, 0x10, 0x00, 0x00, 0x01 };
+        out[p++] = 0x68; out[p++] = 4 + sizeof(asdu);
+        out[p++] = (uint8_t)(i << 1); out[p++] = 0; out[p++] = 0; out[p++] = 0;
+        memcpy(out + p, asdu, sizeof(asdu)); p += sizeof(asdu);
+    }
+    *n = p;
+}
+
+/* --- 用例表 --- */
+typedef enum { IN_NONE, IN_RAW, IN_MODBUS_RTU, IN_MODBUS_TCP, IN_MODBUS_REQ, IN_DLT645, IN_DLT698, IN_HDLC, IN_IEC104, IN_DNP3 } input_t;
+
+typedef struct {
+    const char *name;
+    bench_op_fn fn;
+    void *arg;
+    input_t input;
+} bench_case_t;
+
+static void prepare_input(input_t in, bool frag) {
+    uint8_t tmp[2048]; size_t n = 0;
+    edge_arena_thread_frame_begin();
+    struct iovec iov[64]; edge_vector_t v; edge_vector_init(&v, iov, 64);
+    switch (in) {
+        case IN_RAW: fixture_set(&g_in, g_payload, sizeof(g_payload), frag); break;
+        case IN_MODBUS_RTU: make_modbus_resp(false, tmp, &n); fixture_set(&g_in, tmp, n, frag); break;
+        case IN_MODBUS_TCP: make_modbus_resp(true, tmp, &n); fixture_set(&g_in, tmp, n, frag); break;
+        case IN_MODBUS_REQ: edge_modbus_build_read_holding_req(&g_mb_tcp, &v, 0, EDGE_MODBUS_MAX_READ_REGS); fixture_from_vector(&g_in, &v, frag); break;
+        case IN_DLT645: make_dlt645_resp(tmp, &n); fixture_set(&g_in, tmp, n, frag); break;
+        case IN_DLT698: make_dlt698_data(tmp, &n); fixture_set(&g_in, tmp, n, frag); break;
+        case IN_HDLC: make_hdlc_resp(&v); fixture_from_vector(&g_in, &v, frag); break;
+        case IN_IEC104: make_iec104_stream(tmp, &n); fixture_set(&g_in, tmp, n, frag); break;
+        case IN_DNP3: edge_dnp3_build_link_frame(&g_dnp3, &v, 0x44, g_payload, 250); fixture_from_vector(&g_in, &v, frag); break;
+        case IN_NONE: break;
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *json_path = NULL, *filter = NULL;
+    uint64_t min_ns = 50ull * 1000000ull;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc) json_path = argv[++i];
+        else if (!strcmp(argv[i], "--min-ms") && i + 1 < argc) min_ns = strtoull(argv[++i], NULL, 10) * 1000000ull;
+        else filter = argv[i];
+    }
+
+    for (size_t i = 0; i < sizeof(g_payload); i++) g_payload[i] = (uint8_t)(i * 31 + 7);
+    edge_modbus_init(&g_mb_rtu, 1, false);
+    edge_modbus_init(&g_mb_tcp, 1, true);
+    edge_dlt645_init(&g_645, "000000000001");
+    edge_hdlc_init(&g_hdlc, 0x10, 0x01);
+    edge_dnp3_init(&g_dnp3, 1, 1024);
+    edge_modbus_slave_init(&g_slave, &g_slave_unit, 1);
+
+    const bench_case_t cases[] = {
+        { "cursor.read_u8",         op_cursor_read_u8,         NULL, IN_RAW },
+        { "cursor.read_be16_array", op_cursor_read_be16_array, NULL, IN_RAW },
+        { "cursor.scan2",           op_cursor_scan,            NULL, IN_RAW },
+        { "vector.put_be16",        op_vector_put,             NULL, IN_NONE },
+        { "vector.ref_finalize",    op_vector_ref_finalize,    NULL, IN_NONE },
+        { "crc16.ccitt",            op_crc, (void *)(intptr_t)EDGE_CHECK_CRC16_CCITT,  IN_RAW },
+        { "crc16.modbus",           op_crc, (void *)(intptr_t)EDGE_CHECK_CRC16_MODBUS, IN_RAW },
+        { "crc16.dnp3",             op_crc, (void *)(intptr_t)EDGE_CHECK_CRC16_DNP3,   IN_RAW },
+        { "sum8",                   op_crc, (void *)(intptr_t)EDGE_CHECK_SUM8,         IN_RAW },
+        { "modbus_rtu.build",       op_modbus_build, &g_mb_rtu, IN_NONE },
+        { "modbus_rtu.parse",       op_modbus_parse, &g_mb_rtu, IN_MODBUS_RTU },
+        { "modbus_tcp.build",       op_modbus_build, &g_mb_tcp, IN_NONE },
+        { "modbus_tcp.parse",       op_modbus_parse, &g_mb_tcp, IN_MODBUS_TCP },
+        { "modbus_tcp.slave_read",  op_modbus_slave, NULL, IN_MODBUS_REQ },
+        { "dlt645.build",           op_dlt645_build, NULL, IN_NONE },
+        { "dlt645.parse",           op_dlt645_parse, NULL, IN_DLT645 },
+        { "dlt698.build",           op_dlt698_build, NULL, IN_NONE },
+        { "dlt698.parse",           op_dlt698_parse, NULL, IN_DLT698 },
+        { "hdlc_xdlms.build",       op_hdlc_build,   NULL, IN_NONE },
+        { "hdlc_xdlms.parse",       op_hdlc_parse,   NULL, IN_HDLC },
+        { "iec104.build",           op_iec104_build, NULL, IN_NONE },
+        { "iec104.parse",           op_iec104_parse, NULL, IN_IEC104 },
+        { "dnp3_link.build",        op_dnp3_build,   NULL, IN_NONE },
+        { "dnp3_link.parse",        op_dnp3_parse,   NULL, IN_DNP3 },
+    };
+
+    FILE *json = json_path ? fopen(json_path, "w") : stdout;
+    if (!json) { perror(json_path); return 1; }
+    fprintf(json, "{\n  \"crc_engine\": \"%s\",\n  \"build\": \"%s\",\n  \"results\": [",
+            edge_crc_engine_name(edge_crc_get_engine()), EDGE_BENCH_BUILD_FLAVOR);
+    int first = 1;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        if (filter && !strstr(cases[i].name, filter)) continue;
+        for (int frag = 0; frag <= (cases[i].input != IN_NONE); frag++) {
+            const char *layout = cases[i].input == IN_NONE ? "vector" : (frag ? "fragmented" : "single");
+            prepare_input(cases[i].input, frag);
+            bench_result_t r = bench_measure(cases[i].name, layout, cases[i].fn, cases[i].arg, min_ns);
+            bench_json_write(json, &r, first); first = 0;
+            fprintf(stderr, "%-24s %-10s %6zu B %10.1f ns/frame %12.0f frames/s %8.3f cycles/B\n",
+                    r.name, r.layout, r.bytes, r.ns_per_op, r.ops_per_sec, r.cycles_per_byte);
+        }
+    }
+    fprintf(json, "\n  ]\n}\n");
+    if (json != stdout) fclose(json);
+    return 0;
+}
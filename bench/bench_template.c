@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "edge_core.h"
+#include "protocols/edge_modbus.h"
+#include "protocols/edge_dlt645.h"
+#include "protocols/edge_dlms.h"
+
+#define POINTS 10000
+#define ROUNDS 50
+
+static void report(const char *name, const char *mode, uint64_t ns, uint64_t cyc) {
+    const double n = (double)POINTS * ROUNDS;
+    printf("%-12s %-9s %8.1f ns/req %8.1f cycles/req\n", name, mode, (double)ns / n, (double)cyc / n);
+}
+
+#define RUN(name, mode, body) do { \
+    uint64_t t0 = bench_now_ns(), c0 = bench_cycles(); \
+    for (int r = 0; r < ROUNDS; r++) for (uint32_t i = 0; i < POINTS; i++) { \
+        edge_arena_thread_frame_begin(); \
+        struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8); \
+        body; \
+        BENCH_KEEP(v.total_len); \
+    } \
+    report(name, mode, bench_now_ns() - t0, bench_cycles() - c0); \
+} while (0)
+
+int main(void) {
+    static uint8_t tbuf[256];
+    edge_frame_template_t t;
+
+    for (int tcp = 1; tcp >= 0; tcp--) {
+        const char *name = tcp ? "modbus-tcp" : "modbus-rtu";
+        edge_modbus_context_t ctx; edge_modbus_init(&ctx, 1, tcp);
+        RUN(name, "rebuild", edge_modbus_build_read_holding_req(&ctx, &v, (uint16_t)(i * 10), 10));
+        edge_template_init(&t, tbuf, sizeof(tbuf));
+        edge_modbus_template_read_holding(&ctx, &t, 0, 10);
+        RUN(name, "template", edge_modbus_template_emit(&ctx, &t, (uint16_t)(i * 10), 10, &v));
+    }
+
+    edge_dlt645_context_t meter; edge_dlt645_init(&meter, "000000000001");
+    RUN("dlt645", "rebuild", edge_dlt645_build_read_req(&meter, &v, 0x00010000 + i));
+    edge_template_init(&t, tbuf, sizeof(tbuf));
+    edge_dlt645_template_read_req(&meter, &t, 0x00010000);
+    RUN("dlt645", "template", edge_dlt645_template_emit(&t, 0x00010000 + i, &v));
+
+    static const uint8_t apdu[] = { 0xC0, 0x01, 0xC1, 0x00, 0x03, 0x01, 0x00, 0x01, 0x08, 0x00, 0xFF, 0x02, 0x00 };
+    edge_hdlc_manager_t mgr; edge_hdlc_init(&mgr, 0x10, 0x01);
+    RUN("hdlc-iframe", "rebuild", edge_hdlc_build_iframe(&mgr, &v, apdu, sizeof(apdu), true));
+    edge_template_init(&t, tbuf, sizeof(tbuf));
+    edge_hdlc_template_iframe(&mgr, &t, apdu, sizeof(apdu));
+    RUN("hdlc-iframe", "template", edge_hdlc_template_emit(&mgr, &t, &v));
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "bench.h"
+#include "edge_core.h"
+#include "libedge/edge_dnp3.h"
+
+#define ITERS 200000
+
+enum { TX_WRITEV, TX_FINALIZE, TX_FLAT };
+
+static int open_udp_pair(int *tx, int *rx) {
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    socklen_t alen = sizeof(addr);
+    *rx = socket(AF_INET, SOCK_DGRAM, 0);
+    *tx = socket(AF_INET, SOCK_DGRAM, 0);
+    if (*rx < 0 || *tx < 0) return -1;
+    if (bind(*rx, (struct sockaddr *)&addr, sizeof(addr)) < 0) return -1;
+    if (getsockname(*rx, (struct sockaddr *)&addr, &alen) < 0) return -1;
+    return connect(*tx, (struct sockaddr *)&addr, sizeof(addr));
+}
+
+/**
+ * @brief 每次迭代重新构建帧后发送，并立即收取以免接收队列溢出
+ */
+static void run(const char *name, int mode, size_t payload_len, int tx, int rx) {
+    static uint8_t payload[1024], flat[2048], sink[2048];
+    static uint8_t mem[4096];
+    memset(payload, 0x5A, sizeof(payload));
+    edge_dnp3_context_t ctx; edge_dnp3_init(&ctx, 1, 1024);
+    edge_arena_bump_t arena;
+    const edge_vector_cost_t cost = EDGE_VECTOR_COST_DEFAULT;
+    size_t segs = 0, bytes = 0;
+
+    uint64_t t0 = bench_now_ns(), c0 = bench_cycles();
+    for (int i = 0; i < ITERS; i++) {
+        struct iovec iov[64]; edge_vector_t v;
+        edge_arena_bump_init(&arena, mem, sizeof(mem));
+        edge_vector_init_arena(&v, iov, 64, &arena.base);
+        if (edge_dnp3_build_link_frame(&ctx, &v, 0xC4, payload, payload_len) != EP_OK) abort();
+        ssize_t sent;
+        if (mode == TX_FLAT) {
+            size_t n; edge_vector_flatten(&v, flat, sizeof(flat), &n);
+            sent = send(tx, flat, n, 0);
+        } else {
+            if (mode == TX_FINALIZE) edge_vector_finalize(&v, &cost);
+            sent = writev(tx, v.iovs, v.used_count);
+        }
+        if (sent < 0 || recv(rx, sink, sizeof(sink), 0) != sent) abort();
+        segs += (size_t)v.used_count; bytes += (size_t)sent;
+    }
+    uint64_t ns = bench_now_ns() - t0, cyc = bench_cycles() - c0;
+    printf("%-10s payload=%-5zu %5.1f iovs %8.1f ns/frame %10.0f cycles/frame %8.1f MB/s\n",
+           name, payload_len, (double)segs / ITERS, (double)ns / ITERS, (double)cyc / ITERS,
+           (double)bytes * 1e3 / (double)ns);
+}
+
+int main(void) {
+    int tx, rx;
+    if (open_udp_pair(&tx, &rx) < 0) { perror("loopback"); return 1; }
+    static const size_t sizes[] = { 4, 16, 64, 250 };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        run("writev", TX_WRITEV, sizes[s], tx, rx);
+        run("finalize", TX_FINALIZE, sizes[s], tx, rx);
+        run("flatten", TX_FLAT, sizes[s], tx, rx);
+    }
+    close(tx); close(rx);
+    return 0;
+}
@@ -0,0 +1,71 @@
+# 合并构建脚本：把核心库拼成单个 libedge_proto.c + libedge_proto.h
+#
+# 用法 (由 LIBEDGE_AMALGAMATE 自动调用，也可手动执行):
+#   cmake -DSOURCE_DIR=<repo> -DOUT_DIR=<dir> -DSOURCES="a.c|b.c" -DHEADERS="x.h|y.h" -P amalgamate.cmake
+#
+# 引号形式的 #include 按 (当前目录, include/, src/) 顺序查找并就地展开，每个文件只展开一次；
+# 尖括号的系统头保持原样。全部源文件落在同一编译单元中，各文件的 static 名字必须互不冲突。
+
+cmake_minimum_required(VERSION 3.14)
+
+foreach(var SOURCE_DIR OUT_DIR SOURCES HEADERS)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "amalgamate.cmake: ${var} is required")
+    endif()
+endforeach()
+string(REPLACE "|" ";" SOURCES "${SOURCES}")
+string(REPLACE "|" ";" HEADERS "${HEADERS}")
+set_property(GLOBAL PROPERTY AMALG_SEEN "")
+
+function(_amalg_inline path out_var)
+    get_property(seen GLOBAL PROPERTY AMALG_SEEN)
+    if(path IN_LIST seen)
+        set(${out_var} "" PARENT_SCOPE)
+        return()
+    endif()
+    set_property(GLOBAL APPEND PROPERTY AMALG_SEEN "${path}")
+
+    file(READ "${path}" text)
+    get_filename_component(dir "${path}" DIRECTORY)
+    string(REGEX MATCHALL "#include \"[^\"]+\"" incs "${text}")
+    foreach(inc IN LISTS incs)
+        string(REGEX REPLACE "#include \"([^\"]+)\"" "\\1" name "${inc}")
+        set(found "")
+        foreach(d "${dir}" "${SOURCE_DIR}/include" "${SOURCE_DIR}/src")
+            if(EXISTS "${d}/${name}")
+                get_filename_component(found "${d}/${name}" ABSOLUTE)
+                break()
+            endif()
+        endforeach()
+        if(NOT found)
+            message(FATAL_ERROR "amalgamate.cmake: cannot resolve ${inc} in ${path}")
+        endif()
+        _amalg_inline("${found}" sub)
+        string(REPLACE "${inc}" "${sub}" text "${text}")
+    endforeach()
+
+    file(RELATIVE_PATH rel "${SOURCE_DIR}" "${path}")
+    set(${out_var} "/* ---- ${rel} ---- */\n${text}\n" PARENT_SCOPE)
+endfunction()
+
+set(banner "/* 由 cmake/amalgamate.cmake 生成，请勿手工修改 */\n")
+
+# 公共头：对外 API 与分文件构建完全一致
+set(hdr "${banner}#ifndef LIBEDGE_PROTO_AMALGAMATED_H\n#define LIBEDGE_PROTO_AMALGAMATED_H\n\n")
+foreach(h IN LISTS HEADERS)
+    get_filename_component(h "${h}" ABSOLUTE BASE_DIR "${SOURCE_DIR}")
+    _amalg_inline("${h}" sub)
+    string(APPEND hdr "${sub}")
+endforeach()
+string(APPEND hdr "#endif\n")
+
+# 实现：公共头已由 libedge_proto.h 提供，内部头与各源文件按顺序展开
+set(src "${banner}#include \"libedge_proto.h\"\n\n")
+foreach(s IN LISTS SOURCES)
+    get_filename_component(s "${s}" ABSOLUTE BASE_DIR "${SOURCE_DIR}")
+    _amalg_inline("${s}" sub)
+    string(APPEND src "${sub}")
+endforeach()
+
+file(WRITE "${OUT_DIR}/libedge_proto.h" "${hdr}")
+file(WRITE "${OUT_DIR}/libedge_proto.c" "${src}")
@@ -33,40 +33,490 @@ typedef struct {
     int current_iov;
     size_t current_offset;
     size_t total_read;
+    size_t total_len;   // init 时缓存的 iovs 总长，remaining 为 O(1)
 } edge_cursor_t;
 
 void edge_cursor_init(edge_cursor_t *c, const struct iovec *iovs, int count);
-size_t edge_cursor_remaining(const edge_cursor_t *c);
 const void* edge_cursor_get_ptr(edge_cursor_t *c, size_t len);
 edge_error_t edge_cursor_read_bytes(edge_cursor_t *c, uint8_t *buf, size_t len);
-edge_error_t edge_cursor_read_u8(edge_cursor_t *c, uint8_t *val);
-edge_error_t edge_cursor_read_be16(edge_cursor_t *c, uint16_t *val);
-edge_error_t edge_cursor_read_le16(edge_cursor_t *c, uint16_t *val);
-edge_error_t edge_cursor_read_be32(edge_cursor_t *c, uint32_t *val);
+edge_error_t edge_cursor_skip(edge_cursor_t *c, size_t len);
 
-/* --- 3. Edge Vector (Zero-Copy Builder) --- */
-#define EDGE_VECTOR_SCRATCH_SIZE 128
+/**
+ * @brief [零拷贝] 以后续 len 字节构造有界子 cursor (共享 iovs，可跨段)，父 cursor 前进 len
+ * 子 cursor 的 remaining/读取/scan 均不会越过 len；用于把下层载荷直接交给上层解析。
+ */
+edge_error_t edge_cursor_slice(edge_cursor_t *c, size_t len, edge_cursor_t *sub);
+
+/**
+ * @brief [零拷贝] 把后续 len 字节所在的段描述写入 out (最多 max 段)，父 cursor 前进 len
+ * 用于拼接不连续的载荷 (如剥离 CRC 后的 DNP3 数据块)；段数不足时返回 EP_ERR_BUFFER_TOO_SMALL 且不前进。
+ */
+edge_error_t edge_cursor_slice_iov(edge_cursor_t *c, size_t len, struct iovec *out, int max, int *out_count);
+
+/**
+ * @brief 在剩余数据中查找 1/2 字节同步模式 (memchr/SSE2/AVX2/NEON，可跨 iovec 段)
+ * 找到时 cursor 停在模式首字节 (不消费) 并返回 EP_OK；否则返回 EP_ERR_INCOMPLETE_DATA，
+ * cursor 跳过所有不可能构成模式起点的字节 (2 字节模式保留末尾可能的首字节)。
+ * @param skipped 可选，输出被跳过的字节数
+ */
+edge_error_t edge_cursor_scan(edge_cursor_t *c, const uint8_t *pattern, size_t plen, size_t *skipped);
+
+/**
+ * @brief 批量读取 n 个数值并转换为主机字节序 (段内批量翻转，跨段元素单独处理)
+ * 数据不足时返回 EP_ERR_INCOMPLETE_DATA 且 cursor 不前进。
+ */
+edge_error_t edge_cursor_read_be16_array(edge_cursor_t *c, uint16_t *out, size_t n);
+edge_error_t edge_cursor_read_le16_array(edge_cursor_t *c, uint16_t *out, size_t n);
+edge_error_t edge_cursor_read_be32_array(edge_cursor_t *c, uint32_t *out, size_t n);
+edge_error_t edge_cursor_read_le32_array(edge_cursor_t *c, uint32_t *out, size_t n);
+
+/**
+ * @brief 翻转 n 个 16/32 位元素的字节序 (dst 可等于 src)
+ * 可用于一次性把寄存器镜像预转换为线路字节序，之后以 append_ref 零拷贝发送。
+ */
+void edge_bswap16_array(void *dst, const void *src, size_t n);
+void edge_bswap32_array(void *dst, const void *src, size_t n);
+
+static inline size_t edge_cursor_remaining(const edge_cursor_t *c) {
+    return c ? c->total_len - c->total_read : 0;
+}
+
+/**
+ * @brief [内联快速路径] 当前 iovec 段内足够 n 字节 (且不越过子 cursor 边界) 时直接返回指针并前进，
+ * 否则返回 NULL，由调用方退回跨段的 edge_cursor_read_bytes。
+ */
+static inline const uint8_t* _edge_cursor_fast(edge_cursor_t *c, size_t n) {
+    if (!c || c->current_iov >= c->count || c->total_len - c->total_read < n) return NULL;
+    const struct iovec *iov = &c->iovs[c->current_iov];
+    if (iov->iov_len - c->current_offset < n) return NULL;
+    const uint8_t *p = (const uint8_t *)iov->iov_base + c->current_offset;
+    c->current_offset += n; c->total_read += n;
+    if (c->current_offset == iov->iov_len) { c->current_iov++; c->current_offset = 0; }
+    return p;
+}
+
+static inline edge_error_t edge_cursor_read_u8(edge_cursor_t *c, uint8_t *val) {
+    const uint8_t *p = _edge_cursor_fast(c, 1);
+    if (!p) return edge_cursor_read_bytes(c, val, 1);
+    *val = p[0];
+    return EP_OK;
+}
+
+static inline edge_error_t edge_cursor_read_be16(edge_cursor_t *c, uint16_t *val) {
+    uint8_t tmp[2];
+    const uint8_t *p = _edge_cursor_fast(c, 2);
+    if (!p) { EP_ASSERT_OK(edge_cursor_read_bytes(c, tmp, 2)); p = tmp; }
+    *val = (uint16_t)((p[0] << 8) | p[1]);
+    return EP_OK;
+}
+
+static inline edge_error_t edge_cursor_read_le16(edge_cursor_t *c, uint16_t *val) {
+    uint8_t tmp[2];
+    const uint8_t *p = _edge_cursor_fast(c, 2);
+    if (!p) { EP_ASSERT_OK(edge_cursor_read_bytes(c, tmp, 2)); p = tmp; }
+    *val = (uint16_t)(p[0] | (p[1] << 8));
+    return EP_OK;
+}
+
+static inline edge_error_t edge_cursor_read_be32(edge_cursor_t *c, uint32_t *val) {
+    uint8_t tmp[4];
+    const uint8_t *p = _edge_cursor_fast(c, 4);
+    if (!p) { EP_ASSERT_OK(edge_cursor_read_bytes(c, tmp, 4)); p = tmp; }
+    *val = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    return EP_OK;
+}
+
+/* --- 3. Checksum Kinds --- */
+typedef enum {
+    EDGE_CHECK_CRC16_CCITT = 0, // HDLC HCS/FCS (X.25)
+    EDGE_CHECK_CRC16_MODBUS,    // Modbus RTU
+    EDGE_CHECK_CRC16_DNP3,      // DNP3 链路层
+    EDGE_CHECK_SUM8,            // DLT645 加和校验 (取低 8 位)
+} edge_check_kind_t;
+
+/* --- 4. Scratch Arena (Pluggable Copy Storage) --- */
+#define EDGE_ARENA_CHUNK 64             // bump arena 单次最小授予量
+#ifndef EDGE_ARENA_THREAD_SIZE
+#define EDGE_ARENA_THREAD_SIZE 16384    // 每线程 bump arena 容量
+#endif
+
+typedef struct edge_arena edge_arena_t;
+struct edge_arena {
+    /* 申请至少 min_len 字节的连续空间，*out_len 返回实际授予长度；失败返回 NULL */
+    uint8_t *(*grow)(edge_arena_t *a, size_t min_len, size_t *out_len);
+    void (*reset)(edge_arena_t *a);
+};
+
+/* 固定缓冲区上的 bump 分配：按帧 reset 即可复用整块缓冲区 */
+typedef struct {
+    edge_arena_t base;
+    uint8_t *buf;
+    size_t size;
+    size_t used;
+} edge_arena_bump_t;
+
+/* 等长 slab 池：vector 写满一个 slab 后链到下一个 slab (新 iovec 段) */
+typedef struct {
+    edge_arena_t base;
+    uint8_t *pool;
+    size_t slab_size;
+    uint32_t slab_count;
+    uint32_t next;
+} edge_arena_slab_t;
+
+void edge_arena_bump_init(edge_arena_bump_t *a, void *buf, size_t size);
+void edge_arena_slab_init(edge_arena_slab_t *a, void *pool, size_t slab_size, uint32_t slab_count);
+
+/**
+ * @brief 当前线程的 bump arena (EDGE_ARENA_THREAD_SIZE 字节，无 malloc)
+ * 由调用方在帧边界 edge_arena_reset，reset 前以其构建的所有 vector 须已发送完毕。
+ */
+edge_arena_t* edge_arena_thread(void);
+void edge_arena_reset(edge_arena_t *a);
+
+/**
+ * @brief 帧边界：回收当前线程 arena，等价于 edge_arena_reset(edge_arena_thread())
+ * 收发循环每轮开头调用一次；上一帧的 vector 须已发送完毕、指向其数据的 cursor 不再使用。
+ */
+void edge_arena_thread_frame_begin(void);
+
+/* 通用分配器：库内少数需要长期持有内存的场合 (如 HDLC 重组缓冲) 经由它申请，
+ * 可按上下文指定；NULL 表示全局默认 (libc malloc，LIBEDGE_NO_MALLOC 构建下恒失败) */
+typedef struct edge_allocator edge_allocator_t;
+struct edge_allocator {
+    void *(*alloc)(void *user, size_t size);
+    void (*free)(void *user, void *ptr, size_t size);
+    void *user;
+};
+
+void edge_allocator_set_default(const edge_allocator_t *a);  // NULL 恢复内置默认
+const edge_allocator_t *edge_allocator_default(void);
+void *edge_alloc(const edge_allocator_t *a, size_t size);
+void edge_free(const edge_allocator_t *a, void *ptr, size_t size);
+
+/* 定长块池：空闲链表，O(1) 分配/释放；超过 block_size 的请求失败 */
+typedef struct {
+    edge_allocator_t base;
+    uint8_t *pool;
+    size_t block_size;
+    uint32_t block_count;
+    void *free_list;
+} edge_pool_t;
+
+/* arena 分配器：从 edge_arena_t 顺序切分 (16 字节对齐)，free 为空操作，随 arena reset 整体回收 */
+typedef struct {
+    edge_allocator_t base;
+    edge_arena_t *arena;
+} edge_arena_allocator_t;
+
+void edge_pool_init(edge_pool_t *p, void *buf, size_t block_size, uint32_t block_count);
+void edge_arena_allocator_init(edge_arena_allocator_t *a, edge_arena_t *arena);
+
+/* --- 5. Edge Vector (Zero-Copy Builder) --- */
+#ifndef EDGE_VECTOR_SCRATCH_SIZE
+#define EDGE_VECTOR_SCRATCH_SIZE 0      // 内联 scratch 字节数；默认 0 即不内联，改用线程 arena
+#endif
 
 typedef struct {
     struct iovec *iovs;
     int max_capacity;
     int used_count;
     size_t total_len;
-    uint8_t scratch[EDGE_VECTOR_SCRATCH_SIZE];
+    /* 当前 scratch 窗口：内联缓冲区或 arena 授予的块 (vector 不可按值拷贝) */
+    uint8_t *scratch;
     size_t scratch_used;
+    size_t scratch_size;
+    edge_arena_t *arena;
     bool last_was_scratch;
+    /* 偏移定位：可选累积偏移索引 (offsets[i] 为第 i 段起始偏移) + 最近一次 patch 位置缓存 */
+    size_t *offsets;
+    int hint_idx;
+    size_t hint_base;
+    /* 增量校验：check_begin 之后追加的字节实时累加，无需回扫帧 */
+    edge_check_kind_t check_kind;
+    uint16_t check_state;
+    size_t check_start;
+    bool check_active;
+    bool check_dirty;
+#if EDGE_VECTOR_SCRATCH_SIZE > 0
+    uint8_t inline_scratch[EDGE_VECTOR_SCRATCH_SIZE];
+#endif
 } edge_vector_t;
 
+/**
+ * @brief 以线程 arena (edge_arena_thread) 存放拷贝数据初始化；EDGE_VECTOR_SCRATCH_SIZE 大于 0 时改用内联 scratch
+ * 默认模式下同一线程的所有 vector 共享该 arena，直到下一次 edge_arena_thread_frame_begin
+ * 才整体回收：调用方须在每帧开头调用它，否则累计 EDGE_ARENA_THREAD_SIZE 字节后
+ * 追加返回 EP_ERR_BUFFER_TOO_SMALL。内联模式下该调用只回收显式以线程 arena 构建的 vector，可无条件保留。
+ */
 void edge_vector_init(edge_vector_t *v, struct iovec *iovs, int max_capacity);
+
+/**
+ * @brief 使用调用方 arena 存放 append_copy/put_* 数据，帧长不再受内联 scratch 限制
+ */
+void edge_vector_init_arena(edge_vector_t *v, struct iovec *iovs, int max_capacity, edge_arena_t *arena);
+
+/**
+ * @brief 挂接累积偏移索引 (容量需不小于 max_capacity)，get_ptr/patch 变为 O(log n)
+ * 未挂接时从 头/缓存位置/尾 三者中最近的一处行走定位，尾部附近的回填为 O(1)。
+ */
+void edge_vector_attach_index(edge_vector_t *v, size_t *offsets);
 size_t edge_vector_length(const edge_vector_t *v);
 const uint8_t* edge_vector_get_ptr(const edge_vector_t *v, size_t offset);
 edge_error_t edge_vector_append_ref(edge_vector_t *v, const void *ptr, size_t len);
 edge_error_t edge_vector_append_copy(edge_vector_t *v, const void *data, size_t len);
 edge_error_t edge_vector_patch(edge_vector_t *v, size_t offset, const void *data, size_t len);
+
+/**
+ * @brief 截回到此前记下的长度 (如中途失败时撤销已写入的半帧)，len 超过当前长度返回 EP_ERR_OUT_OF_BOUNDS
+ */
+edge_error_t edge_vector_truncate(edge_vector_t *v, size_t len);
+
+/**
+ * @brief 在帧首插入 len 字节 (如事后才能确定的安全头/长度前缀)，已有各段不拷贝
+ * 占用一个 iovec 与 len 字节 scratch；增量校验进行中时返回 EP_ERR_INVALID_STATE。
+ */
+edge_error_t edge_vector_prepend_copy(edge_vector_t *v, const void *data, size_t len);
+
+/**
+ * @brief 取得第 idx 段的可写地址 (供原地变换，如加密)：段已在当前 scratch 窗口内时直接返回，
+ * 否则 (append_ref 引用的调用方内存或更早的 arena 块) 先拷入 scratch 并改指副本，原内存不被改写。
+ */
+edge_error_t edge_vector_own_segment(edge_vector_t *v, int idx, uint8_t **out);
 edge_error_t edge_vector_put_u8(edge_vector_t *v, uint8_t val);
 edge_error_t edge_vector_put_be16(edge_vector_t *v, uint16_t val);
 edge_error_t edge_vector_put_be32(edge_vector_t *v, uint32_t val);
 edge_error_t edge_vector_put_le16(edge_vector_t *v, uint16_t val);
 edge_error_t edge_vector_put_le32(edge_vector_t *v, uint32_t val);
 
+/**
+ * @brief 整个数组转换为线路字节序后一次写入 (SSSE3/AVX2/NEON 批量翻转)
+ * 源数据已是线路字节序且生命周期足够时，直接 append_ref 即可零拷贝 (见 edge_bswap16_array)。
+ */
+edge_error_t edge_vector_put_be16_array(edge_vector_t *v, const uint16_t *vals, size_t n);
+edge_error_t edge_vector_put_le16_array(edge_vector_t *v, const uint16_t *vals, size_t n);
+edge_error_t edge_vector_put_be32_array(edge_vector_t *v, const uint32_t *vals, size_t n);
+edge_error_t edge_vector_put_le32_array(edge_vector_t *v, const uint32_t *vals, size_t n);
+
+/**
+ * @brief 发送前合并代价模型
+ * iov_cost: 单个 iovec 的固定开销，折算为等价拷贝字节数；短于此值的相邻段合并
+ * max_iovs: 驱动可接受的最大段数 (0 为不限，1 即整帧压平)
+ */
+typedef struct {
+    size_t iov_cost;
+    int max_iovs;
+} edge_vector_cost_t;
+
+#define EDGE_VECTOR_COST_DEFAULT { 64, 0 }
+
+/**
+ * @brief [专家级 API] 按代价模型把小段拷入 scratch 合并，大的 append_ref 段保持零拷贝
+ * cost 为 NULL 时使用 EDGE_VECTOR_COST_DEFAULT；scratch 不足时返回错误且 vector 不变。
+ */
+edge_error_t edge_vector_finalize(edge_vector_t *v, const edge_vector_cost_t *cost);
+
+/**
+ * @brief 整帧拷入连续缓冲区 (串口等不支持 iovec 的驱动)
+ */
+edge_error_t edge_vector_flatten(const edge_vector_t *v, uint8_t *buf, size_t cap, size_t *out_len);
+
+/* --- 6. Checksums over Scatter Lists --- */
+uint16_t edge_check_init(edge_check_kind_t kind);
+uint16_t edge_check_update(edge_check_kind_t kind, uint16_t state, const void *data, size_t len);
+uint16_t edge_check_final(edge_check_kind_t kind, uint16_t state);
+
+/**
+ * @brief 计算 vector 中 [offset, offset+len) 区间的校验值 (跨 iovec)
+ */
+edge_error_t edge_vector_checksum(const edge_vector_t *v, edge_check_kind_t kind, size_t offset, size_t len, uint16_t *out);
+
+/**
+ * @brief 计算 cursor 之后 len 字节的校验值，不移动 cursor
+ */
+edge_error_t edge_cursor_checksum(const edge_cursor_t *c, edge_check_kind_t kind, size_t len, uint16_t *out);
+
+/**
+ * @brief 从当前长度开始增量跟踪校验值，后续 append/put 自动累加
+ */
+void edge_vector_check_begin(edge_vector_t *v, edge_check_kind_t kind);
+
+/**
+ * @brief 读取 check_begin 以来所有字节的校验值 (跟踪继续进行)
+ * 若跟踪区间被 patch 过，则退化为一次区间重算。
+ */
+uint16_t edge_vector_check_value(edge_vector_t *v);
+void edge_vector_check_end(edge_vector_t *v);
+
+/* --- 7. Frame Templates (Encode Once, Patch Per Cycle) --- */
+#define EDGE_TEMPLATE_MAX_FIELDS 4
+#define EDGE_TEMPLATE_MAX_CHECKS 2
+#define EDGE_TEMPLATE_MAX_VAR_BYTES 16  // 字段与校验输出字节总数上限
+
+typedef struct {
+    uint16_t offset;
+    uint8_t width;      // 1 / 2 / 4
+    bool big_endian;
+    uint8_t var_base;   // 在可变字节表中的起始下标
+} edge_template_field_t;
+
+typedef struct {
+    edge_check_kind_t kind;
+    uint16_t start;     // 覆盖区间 [start, start + len)
+    uint16_t len;
+    uint16_t at;        // 校验值位置 (CRC16 小端 2 字节，SUM8 1 字节)
+    uint8_t var_base;
+} edge_template_check_t;
+
+/**
+ * @brief 帧模板：帧只编码一次，之后仅改写声明过的可变字段，并按预计算的
+ * 逐位贡献表增量修正 CRC (SUM8 按差值修正)，无需回扫整帧。
+ */
+typedef struct {
+    uint8_t *buf;
+    size_t len;
+    size_t cap;
+    edge_template_field_t fields[EDGE_TEMPLATE_MAX_FIELDS];
+    int field_count;
+    edge_template_check_t checks[EDGE_TEMPLATE_MAX_CHECKS];
+    int check_count;
+    uint16_t var_pos[EDGE_TEMPLATE_MAX_VAR_BYTES];
+    int var_count;
+    /* contrib[k][i][b]：可变字节 i 的第 b 位翻转时校验 k 的变化量 */
+    uint16_t contrib[EDGE_TEMPLATE_MAX_CHECKS][EDGE_TEMPLATE_MAX_VAR_BYTES][8];
+} edge_frame_template_t;
+
+void edge_template_init(edge_frame_template_t *t, void *buf, size_t cap);
+
+/**
+ * @brief 把已构建的帧拷入模板缓冲区 (清空已声明的字段与校验)
+ */
+edge_error_t edge_template_capture(edge_frame_template_t *t, const edge_vector_t *v);
+
+/**
+ * @brief 声明可变字段，按声明顺序编号 (0, 1, ...)
+ */
+edge_error_t edge_template_add_field(edge_frame_template_t *t, size_t offset, size_t width, bool big_endian);
+
+/**
+ * @brief 声明校验：立即按当前内容重算并写入 at 处
+ * 按依赖顺序声明 (如 HDLC 先 HCS 后 FCS)：校验值不得落在先声明校验的覆盖区间内。
+ */
+edge_error_t edge_template_add_check(edge_frame_template_t *t, edge_check_kind_t kind, size_t start, size_t len, size_t at);
+
+/**
+ * @brief 改写字段 idx 并增量修正所有覆盖它的校验
+ */
+edge_error_t edge_template_set(edge_frame_template_t *t, int idx, uint32_t value);
+
+/**
+ * @brief 以 append_ref 零拷贝追加模板帧 (发送完成前不得再 set)
+ */
+edge_error_t edge_template_emit(const edge_frame_template_t *t, edge_vector_t *v);
+
+/* --- 8. Hot-Path Statistics (Optional, EDGE_ENABLE_STATS) --- */
+#ifndef EDGE_ENABLE_STATS
+#define EDGE_ENABLE_STATS 0
+#endif
+
+#if EDGE_ENABLE_STATS
+#define EDGE_STATS_SUB_BITS 2           // 每个 2 的幂区间再分 4 档 (相对误差 <= 25%)
+#define EDGE_STATS_HIST_BUCKETS 160     // 覆盖 0 ~ 2^40 ns
+
+typedef enum {
+    EDGE_STAT_FRAMES_RX = 0,
+    EDGE_STAT_FRAMES_TX,
+    EDGE_STAT_CHECKSUM_ERRORS,
+    EDGE_STAT_FRAME_ERRORS,
+    EDGE_STAT_RESYNC_BYTES,     // 为寻找帧头而跳过的字节
+    EDGE_STAT_SCRATCH_OVERFLOWS,
+    EDGE_STAT_BLOCK_RESTARTS,   // DLMS 分块传输在未完成时被重新开始
+    EDGE_STAT_WINDOW_STALLS,    // IEC104 发送窗口 (k) 已满
+    EDGE_STAT_COUNT
+} edge_stat_id_t;
+
+/**
+ * @brief 协议上下文内嵌的计数器与解析/构建时延直方图 (按缓存行对齐)
+ * 单写者 (持有上下文的线程) 以 seqlock 发布，其它线程经 edge_stats_snapshot 无锁读取。
+ * 内嵌本结构的上下文若在堆上分配，需使用 aligned_alloc(64, ...)。
+ */
+typedef struct {
+    uint32_t seq;
+    uint64_t counters[EDGE_STAT_COUNT];
+    uint32_t hist[EDGE_STATS_HIST_BUCKETS];
+} __attribute__((aligned(64))) edge_stats_t;
+
+/**
+ * @brief 时延值所在的对数分桶
+ */
+static inline int edge_stats_bucket(uint64_t ns) {
+    if (ns < (1u << EDGE_STATS_SUB_BITS)) return (int)ns;
+    int msb = 63 - __builtin_clzll(ns);
+    int idx = ((msb - EDGE_STATS_SUB_BITS + 1) << EDGE_STATS_SUB_BITS) +
+              (int)((ns >> (msb - EDGE_STATS_SUB_BITS)) & ((1u << EDGE_STATS_SUB_BITS) - 1));
+    return idx < EDGE_STATS_HIST_BUCKETS ? idx : EDGE_STATS_HIST_BUCKETS - 1;
+}
+
+static inline void edge_stats_write_begin(edge_stats_t *s) {
+    __atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void edge_stats_write_end(edge_stats_t *s) {
+    __atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELEASE);
+}
+
+static inline void edge_stats_add(edge_stats_t *s, edge_stat_id_t id, uint64_t n) {
+    if (!s || !n) return;
+    edge_stats_write_begin(s);
+    __atomic_store_n(&s->counters[id], s->counters[id] + n, __ATOMIC_RELAXED);
+    edge_stats_write_end(s);
+}
+
+/**
+ * @brief 记录一次解析/构建：成功计入 ok_id 与直方图，失败按错误码归类，
+ * EP_ERR_INCOMPLETE_DATA (等待更多数据) 不计数。
+ */
+static inline void edge_stats_record(edge_stats_t *s, edge_stat_id_t ok_id, edge_error_t err, uint64_t ns) {
+    if (!s || err == EP_ERR_INCOMPLETE_DATA) return;
+    edge_stat_id_t id;
+    switch (err) {
+        case EP_OK: id = ok_id; break;
+        case EP_ERR_CHECKSUM: id = EDGE_STAT_CHECKSUM_ERRORS; break;
+        case EP_ERR_BUFFER_TOO_SMALL:
+        case EP_ERR_OVERFLOW: id = EDGE_STAT_SCRATCH_OVERFLOWS; break;
+        default: id = EDGE_STAT_FRAME_ERRORS; break;
+    }
+    edge_stats_write_begin(s);
+    __atomic_store_n(&s->counters[id], s->counters[id] + 1, __ATOMIC_RELAXED);
+    if (err == EP_OK) {
+        int b = edge_stats_bucket(ns);
+        __atomic_store_n(&s->hist[b], s->hist[b] + 1, __ATOMIC_RELAXED);
+    }
+    edge_stats_write_end(s);
+}
+
+/**
+ * @brief 时钟源 (默认 CLOCK_MONOTONIC；无 POSIX 时钟的平台需自行设置，否则时延恒为 0)
+ */
+void edge_stats_set_clock(uint64_t (*now_ns)(void));
+uint64_t edge_stats_now_ns(void);
+
+/**
+ * @brief 无锁读取一致快照 (可与写者并发)
+ */
+void edge_stats_snapshot(const edge_stats_t *s, edge_stats_t *out);
+
+/**
+ * @brief 清零 (仅写者线程调用)
+ */
+void edge_stats_reset(edge_stats_t *s);
+
+/**
+ * @brief 快照中的时延分位数 (q ∈ [0,1])，返回所在分桶的上界 (ns)；无样本时返回 0
+ */
+uint64_t edge_stats_percentile(const edge_stats_t *snap, double q);
+const char *edge_stat_name(edge_stat_id_t id);
+#endif
+
 #endif
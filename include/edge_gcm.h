@@ -0,0 +1,88 @@
+#ifndef LIBEDGE_GCM_H
+#define LIBEDGE_GCM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief AES-128-GCM 计算引擎
+ * 启动时按 CPU 特性自动选择 (AES-NI+PCLMULQDQ / ARMv8 AES+PMULL 可用时为 HW，否则 PORTABLE)，
+ * 两种引擎结果逐位一致，可随时切换 (同一密钥无需重新展开)。两者均为常数时间：
+ * PORTABLE 为位切片 AES (4 分组并行) 与整数乘法拼出的无进位 GHASH，不做以密钥或数据为下标的查表。
+ */
+typedef enum {
+    EDGE_GCM_ENGINE_AUTO = 0,
+    EDGE_GCM_ENGINE_PORTABLE,
+    EDGE_GCM_ENGINE_HW,
+} edge_gcm_engine_t;
+
+#define EDGE_GCM_BLOCK_SIZE 16
+#define EDGE_GCM_IV_SIZE 12
+
+/**
+ * @brief 已展开的 AES-128 密钥与 GHASH 预计算表 (只读，可被多个并发会话共享)
+ */
+typedef struct {
+    uint8_t rk_bytes[11][16];     // 轮密钥字节，AESENC/AESE 直接加载
+    uint64_t rk_slice[11][8];     // 同一轮密钥的位切片形式 (4 分组通道复制)，可移植引擎使用
+    uint64_t h[2], h_rev[2];      // H (大端高/低 64 位) 及其逐字位反转，可移植 GHASH 使用
+    uint8_t h_pow[4][16];         // H^1..H^4 (字节反序)，HW 引擎 4 块聚合
+} edge_gcm_key_t;
+
+/**
+ * @brief 单条消息的 GCM 流式状态
+ * 调用顺序: start -> aad* -> encrypt*|decrypt* -> finish；
+ * aad/encrypt/decrypt 可按任意长度分多次调用 (适配 iovec 分段)，结果与一次性调用一致。
+ */
+typedef struct {
+    const edge_gcm_key_t *key;
+    uint8_t j0[16];               // 预计数块，finish 时加密后与 GHASH 异或得标签
+    uint8_t ctr[16];              // 下一个计数块
+    uint8_t y[16];                // GHASH 累加器
+    uint8_t ks[16];               // 当前密钥流块
+    uint8_t part[16];             // 未满 16 字节的 GHASH 输入 (AAD 或密文)
+    uint8_t ks_used;              // ks 中已消耗字节 (16 表示需生成新块)
+    uint8_t part_len;
+    bool in_text;                 // 已进入密文阶段 (AAD 已补零吸收)
+    uint64_t aad_len;
+    uint64_t text_len;
+} edge_gcm_t;
+
+/**
+ * @brief 构建 AES 查表并选择引擎 (GCC/Clang 下由构造函数自动调用，可重复调用)
+ */
+void edge_gcm_init(void);
+bool edge_gcm_engine_supported(edge_gcm_engine_t engine);
+edge_gcm_engine_t edge_gcm_get_engine(void);
+bool edge_gcm_set_engine(edge_gcm_engine_t engine);
+const char *edge_gcm_engine_name(edge_gcm_engine_t engine);
+
+void edge_gcm_set_key(edge_gcm_key_t *key, const uint8_t raw[16]);
+
+/**
+ * @brief 开始一条消息，iv 为 96 位 (DLMS: system title || IC)
+ */
+void edge_gcm_start(edge_gcm_t *g, const edge_gcm_key_t *key, const uint8_t iv[EDGE_GCM_IV_SIZE]);
+void edge_gcm_aad(edge_gcm_t *g, const void *aad, size_t len);
+
+/**
+ * @brief [原地] 加密/解密 data 并把密文计入 GHASH；16 字节对齐的整块走引擎批量路径
+ */
+void edge_gcm_encrypt(edge_gcm_t *g, void *data, size_t len);
+void edge_gcm_decrypt(edge_gcm_t *g, void *data, size_t len);
+
+/**
+ * @brief 输出 16 字节完整标签 (截断由调用方处理)，之后状态不可再用
+ */
+void edge_gcm_finish(edge_gcm_t *g, uint8_t tag[16]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
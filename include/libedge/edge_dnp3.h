@@ -7,6 +7,9 @@ typedef struct {
     uint16_t src_addr;
     uint16_t dest_addr;
     uint8_t control;
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
 } edge_dnp3_context_t;
 
 void edge_dnp3_init(edge_dnp3_context_t *ctx, uint16_t src, uint16_t dest);
@@ -17,4 +20,33 @@ void edge_dnp3_init(edge_dnp3_context_t *ctx, uint16_t src, uint16_t dest);
  */
 edge_error_t edge_dnp3_build_link_frame(edge_dnp3_context_t *ctx, edge_vector_t *v, uint8_t func, const void *payload, size_t len);
 
+#define EDGE_DNP3_MAX_BLOCKS 32 // 250 字节用户数据最多 16 块，每块至多跨两个 iovec 段
+
+typedef struct {
+    uint8_t length;
+    uint8_t control;
+    uint16_t dest_addr;
+    uint16_t src_addr;
+} edge_dnp3_link_header_t;
+
+/**
+ * @brief [零拷贝] 解析一个完整链路帧：校验头部与每块 CRC，
+ * blocks 收集剥离 CRC 后的数据块 (指向原始缓冲区)，user 为其上的 cursor。
+ * 帧未收全时返回 EP_ERR_INCOMPLETE_DATA 且不消费同步头之后的数据：流式调用方在新数据
+ * 到达后从该位置重新构造 cursor 再调用即可，无需另行缓存或拷贝半帧。
+ */
+edge_error_t edge_dnp3_link_unpack(edge_cursor_t *c, edge_dnp3_link_header_t *hdr,
+                                   struct iovec *blocks, int max_blocks, edge_cursor_t *user);
+
+/**
+ * @brief 同 edge_dnp3_link_unpack，并计入 ctx 的统计 (EDGE_ENABLE_STATS 关闭时仅转发)
+ */
+edge_error_t edge_dnp3_link_recv(edge_dnp3_context_t *ctx, edge_cursor_t *c, edge_dnp3_link_header_t *hdr,
+                                 struct iovec *blocks, int max_blocks, edge_cursor_t *user);
+
+/**
+ * @brief 读取传输层头 (TH)，app 为其后的应用层片段子 cursor
+ */
+edge_error_t edge_dnp3_transport_unpack(edge_cursor_t *user, uint8_t *th, edge_cursor_t *app);
+
 #endif // LIBEDGE_PROTOCOLS_DNP3_H
@@ -9,10 +9,35 @@ typedef struct {
     uint16_t v_a; // Acknowledged sequence number
     uint8_t  k;   // Max unacknowledged I-frames
     uint8_t  w;   // Max unacknowledged S-frames
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
 } edge_iec104_context_t;
 
 edge_error_t edge_iec104_parse_apci(edge_cursor_t *c, uint16_t *ctrl1, uint16_t *ctrl2);
+
+/**
+ * @brief [零拷贝] 解析 APCI，asdu 为按长度域界定的 ASDU 子 cursor，c 前进到下一帧
+ */
+edge_error_t edge_iec104_parse_apdu(edge_cursor_t *c, uint16_t *ctrl1, uint16_t *ctrl2, edge_cursor_t *asdu);
+edge_error_t edge_iec104_build_s_frame(edge_vector_t *v, edge_iec104_context_t *ctx);
+
+/**
+ * @brief 发送窗口是否允许再发 I 帧 (未确认数 < k，k 为 0 时取默认 12)；窗口已满计一次停顿
+ */
+bool edge_iec104_window_open(edge_iec104_context_t *ctx);
+
+/**
+ * @brief S 帧模板：仅 N(R) 为可变字段
+ */
+edge_error_t edge_iec104_template_s_frame(edge_iec104_context_t *ctx, edge_frame_template_t *t);
+edge_error_t edge_iec104_template_emit_s(edge_iec104_context_t *ctx, edge_frame_template_t *t, edge_vector_t *v);
 edge_error_t edge_iec104_build_type1(edge_vector_t *v, uint32_t ioa, bool val, uint8_t qds);
-edge_error_t edge_iec104_session_on_recv(edge_iec104_context_t *ctx, edge_cursor_t *c, edge_vector_t *resp);
+
+/**
+ * @brief 处理一帧 APDU：更新 V(R)/V(A)，需要时把应答写入 resp，c 前进到下一帧
+ * asdu_out (可为 NULL) 为按长度域界定的 ASDU 子 cursor，S/U 帧时为空；与 c 共享 iovs，须在其失效前解码。
+ */
+edge_error_t edge_iec104_session_on_recv(edge_iec104_context_t *ctx, edge_cursor_t *c, edge_vector_t *resp, edge_cursor_t *asdu_out);
 
 #endif
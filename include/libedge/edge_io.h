@@ -0,0 +1,75 @@
+#ifndef LIBEDGE_IO_H
+#define LIBEDGE_IO_H
+
+/*
+ * 可选的 I/O 伴随模块 (edge_proto_io)，核心库 edge_proto 仍不做任何系统调用。
+ */
+#include <sys/types.h>
+#include "edge_core.h"
+
+#define EDGE_IO_BATCH_MAX 64    // 单次 sendmmsg 提交的最大帧数
+
+/**
+ * @brief 批量发送项
+ * result: 已发送字节数；失败为 -errno，未尝试 (同一 fd 上前一帧受阻) 为 -EAGAIN
+ */
+typedef struct {
+    int fd;
+    const edge_vector_t *v;
+    ssize_t result;
+} edge_io_frame_t;
+
+/**
+ * @brief 一次批量提交多帧 (Linux 下为 sendmmsg，其余平台退化为逐帧 sendmsg)
+ * fd 相同的相邻帧合并为一次系统调用，调用方宜按 fd 排序；同一 fd 上出现短写或
+ * EAGAIN 后，其后续帧不再发送，以免流式连接上的报文交错。
+ * flags 透传给 sendmsg (如 MSG_DONTWAIT | MSG_NOSIGNAL)。
+ * @return 完整发送的帧数
+ */
+size_t edge_io_send_batch(edge_io_frame_t *frames, size_t count, int flags);
+
+/**
+ * @brief 镜像环形接收缓冲：同一段共享内存在虚拟地址上连续映射两次，
+ * 未读数据与空闲空间在任何时刻都是单段连续区域，解析器无需处理回绕。
+ * head 为读偏移 (< size)，used 为未读字节数；只允许单生产者/单消费者同线程使用。
+ */
+typedef struct {
+    uint8_t *base;          // 映射起点，[base, base + 2 * size) 可访问
+    size_t size;            // 环容量 (页大小整数倍)
+    size_t head;
+    size_t used;
+    struct iovec view;      // edge_stream_view 给出的 cursor 所引用的段
+} edge_stream_t;
+
+/**
+ * @brief 建立至少 min_size 字节的镜像环 (memfd_create，不可用时退化为 shm_open)
+ * @return 0 成功；否则为 -errno
+ */
+int edge_stream_init(edge_stream_t *s, size_t min_size);
+void edge_stream_destroy(edge_stream_t *s);
+
+/**
+ * @brief 空闲区首地址与可写长度 (供 io_uring、串口驱动等自行写入)，写入后以 commit 登记
+ */
+uint8_t *edge_stream_write_ptr(edge_stream_t *s, size_t *avail);
+void edge_stream_commit(edge_stream_t *s, size_t n);
+
+/**
+ * @brief 以一次 recv/read 填充空闲区
+ * @return 读入字节数；0 为对端关闭；环已满为 -ENOBUFS；其它失败为 -errno
+ */
+ssize_t edge_stream_recv(edge_stream_t *s, int fd, int flags);
+ssize_t edge_stream_read(edge_stream_t *s, int fd);
+
+/**
+ * @brief 以单段 cursor 覆盖全部未读数据 (解析器始终走连续快速路径)
+ * 在下一次 consume/recv 之前有效。
+ */
+void edge_stream_view(edge_stream_t *s, edge_cursor_t *c);
+
+/**
+ * @brief 释放已解析的 n 字节 (通常为 cursor 的 total_read)
+ */
+void edge_stream_consume(edge_stream_t *s, size_t n);
+
+#endif // LIBEDGE_IO_H
@@ -2,6 +2,7 @@
 #define LIBEDGE_PROTOCOLS_DLMS_H
 
 #include "edge_core.h"
+#include "edge_gcm.h"
 
 // --- 1. Enums ---
 typedef enum {
@@ -15,6 +16,7 @@ typedef enum {
     DLMS_TAG_OCTET_STRING       = 9,
     DLMS_TAG_VISIBLE_STRING     = 10,
     DLMS_TAG_UTF8_STRING        = 12,
+    DLMS_TAG_BCD                = 13,
     DLMS_TAG_INTEGER            = 15,
     DLMS_TAG_LONG               = 16,
     DLMS_TAG_UNSIGNED           = 17,
@@ -25,13 +27,19 @@ typedef enum {
     DLMS_TAG_FLOAT              = 23,
     DLMS_TAG_DOUBLE_LA          = 24,
     DLMS_TAG_DATE_TIME          = 25,
+    DLMS_TAG_DATE               = 26,
+    DLMS_TAG_TIME               = 27,
 } edge_dlms_tag_t;
 
 typedef enum {
     DLMS_APDU_INITIATE_REQUEST      = 1,
     DLMS_APDU_INITIATE_RESPONSE     = 8,
     DLMS_APDU_GET_REQUEST           = 192,
+    DLMS_APDU_SET_REQUEST           = 193,
+    DLMS_APDU_ACTION_REQUEST        = 195,
     DLMS_APDU_GET_RESPONSE          = 196,
+    DLMS_APDU_SET_RESPONSE          = 197,
+    DLMS_APDU_ACTION_RESPONSE       = 199,
 } edge_dlms_apdu_tag_t;
 
 #define DLMS_SERVICE_AARQ 0x60
@@ -42,8 +50,30 @@ typedef enum {
 typedef enum {
     DLMS_GET_NORMAL                 = 1,
     DLMS_GET_NEXT                   = 2,
+    DLMS_GET_WITH_LIST              = 3,
 } edge_dlms_service_type_t;
 
+#define DLMS_SET_NORMAL     1
+#define DLMS_SET_WITH_LIST  4
+#define DLMS_ACTION_NORMAL  1
+
+/**
+ * @brief Data-Access-Result (GET/SET 逐项结果)，ACTION 的 Action-Result 取值与之兼容
+ */
+typedef enum {
+    DLMS_DAR_SUCCESS                = 0,
+    DLMS_DAR_HARDWARE_FAULT         = 1,
+    DLMS_DAR_TEMPORARY_FAILURE      = 2,
+    DLMS_DAR_READ_WRITE_DENIED      = 3,
+    DLMS_DAR_OBJECT_UNDEFINED       = 4,
+    DLMS_DAR_TYPE_UNMATCHED         = 12,
+    DLMS_DAR_SCOPE_OF_ACCESS_VIOLATED = 13,
+    DLMS_DAR_LONG_GET_ABORTED       = 15,
+    DLMS_DAR_NO_LONG_GET_IN_PROGRESS = 16,
+    DLMS_DAR_DATA_BLOCK_NUMBER_INVALID = 19,
+    DLMS_DAR_OTHER_REASON           = 250,
+} edge_dlms_dar_t;
+
 typedef enum {
     EDGE_DLMS_SEC_NONE              = 0,
     EDGE_DLMS_SEC_AUTHENTICATED     = 1,
@@ -53,10 +83,21 @@ typedef enum {
 
 // --- 2. Structures (Core Metadata) ---
 
+/**
+ * @brief 安全控制字节 (SC)：低 4 位为套件号，仅支持套件 0 (AES-GCM-128) 的单播密钥
+ */
+#define DLMS_SC_AUTHENTICATION  0x10
+#define DLMS_SC_ENCRYPTION      0x20
+#define DLMS_SC_SUITE_MASK      0x0F
+#define DLMS_SECURITY_HEADER_LEN 5      // SC + IC
+#define DLMS_GCM_TAG_LEN        12
+
 typedef struct {
     uint8_t system_title[8];
     uint32_t invocation_counter;
     edge_dlms_security_policy_t policy;
+    uint8_t authentication_key[16];     // AK，计入每条消息的 AAD
+    edge_gcm_key_t block_cipher_key;    // 已展开的 EK (edge_dlms_security_set_keys)
 } edge_dlms_security_ctx_t;
 
 typedef struct {
@@ -92,6 +133,10 @@ typedef struct {
     uint8_t nr;
     uint8_t *reassembly_buf;
     size_t reassembly_size;
+    const edge_allocator_t *allocator;  // reassembly_buf 的来源，NULL 为全局默认
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
 } edge_hdlc_manager_t;
 
 typedef enum {
@@ -102,24 +147,117 @@ typedef enum {
 
 typedef edge_error_t (*dlms_object_access_fn)(const edge_dlms_object_t *obj, edge_dlms_variant_t *val, void *user_data);
 
+/**
+ * @brief 方法调用：params 为调用参数 (无参数时 tag 为 NULL_DATA)，有返回值时填 ret
+ */
+typedef edge_error_t (*dlms_method_fn)(const edge_dlms_object_t *obj, const edge_dlms_variant_t *params, edge_dlms_variant_t *ret, void *user_data);
+
+/**
+ * @brief 流式属性生成器：按需向 buf 写入至多 cap 字节的 A-XDR 编码 (含最外层标签)，写入量置于 *len
+ * first 为真时从头开始；全部写完后置 *done。服务端按 max_pdu_send 切块，内存只占一个块。
+ */
+typedef edge_error_t (*dlms_stream_fn)(const edge_dlms_object_t *obj, bool first, uint8_t *buf, size_t cap,
+                                       size_t *len, bool *done, void *user_data);
+
+/**
+ * @brief 服务端资源。variant 约定：基本类型 data 指向内容字节 (不含标签/长度)；
+ * ARRAY/STRUCTURE 的 data 为含标签的完整 A-XDR 编码，length 为其字节数。
+ * 返回 EP_ERR_NOT_SUPPORTED 回 read-write-denied，EP_ERR_INVALID_ARG 回 type-unmatched，
+ * EP_ERR_OUT_OF_BOUNDS 回 scope-of-access-violated，EP_ERR_INVALID_STATE 回 temporary-failure，其余回 hardware-fault。
+ */
 typedef struct {
     edge_dlms_object_t obj;
     dlms_object_access_fn on_get;
     dlms_object_access_fn on_set;
     void *user_data;
+    dlms_method_fn on_action;   // attribute_index 为 -方法号 的资源使用
+    dlms_stream_fn on_stream;   // 无 on_get 时 GET-Normal 经生成器应答，超出一个 PDU 则分块
 } edge_dlms_resource_t;
 
+/**
+ * @brief 资源索引槽：key 为 class_id(16) | OBIS(48)，index 为属性号 (方法以负数登记)
+ */
+typedef struct {
+    uint64_t key;
+    uint32_t res;       // resources 下标 + 1，0 表示空槽
+    int8_t   index;
+} edge_dlms_index_slot_t;
+
+/**
+ * @brief 资源索引 (开放寻址 + 线性探测)，槽由调用方提供，构建一次后只读
+ */
+typedef struct {
+    edge_dlms_index_slot_t *slots;
+    size_t cap;
+    const edge_dlms_resource_t *resources;
+} edge_dlms_index_t;
+
 typedef struct {
     edge_hdlc_manager_t hdlc;
     edge_cosem_state_t state;
     uint16_t max_pdu_send;
-    struct { bool active; uint32_t current_block; } block_ctx;
+    struct {
+        bool active; uint32_t current_block;
+        // 服务端流式应答：buf 只保存当前块，GET-Request-Next 时续跑生成器
+        const edge_dlms_resource_t *stream;
+        edge_dlms_object_t desc;
+        bool done;
+        uint8_t *buf;
+        size_t buf_size;
+        size_t block_len;
+    } block_ctx;
     const edge_dlms_resource_t *resources;
     size_t resource_count;
+    edge_dlms_index_t index;    // 未构建时分发退化为线性扫描
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
 } edge_dlms_context_t;
 
+/**
+ * @brief 客户端分块接收器：每块 raw-data 拷入经分配器申请的独立缓冲区，以 iovec 链串起
+ * 链即逻辑数据流，可在最后一块到达前开始 A-XDR 解码。
+ */
+typedef struct {
+    struct iovec *chain;
+    int chain_cap;
+    int chain_count;
+    size_t total_len;
+    uint32_t block;         // 最后收到的块号
+    uint8_t invoke_id;
+    bool last;
+    uint8_t dar;            // 服务端以 data-access-result 终止时的结果码
+    uint32_t generation;    // 每次 reset (含块号 1 重启) 递增，使此前发出的流 cursor 失效
+    const edge_allocator_t *allocator;
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
+} edge_dlms_block_rx_t;
+
 // --- 3. APIs ---
+/**
+ * @brief 设置套件 0 密钥，EK 只在此展开一次
+ */
+void edge_dlms_security_set_keys(edge_dlms_security_ctx_t *ctx, const uint8_t ek[16], const uint8_t ak[16]);
+
+/**
+ * @brief 安全套件 0 原地保护：v 为已编码的明文 APDU，完成后为 SC | IC | 密文 | 标签
+ * IV = system_title || IC。SC 含 0x20 时逐段加密：scratch 中的段原地加密，append_ref 引用的
+ * 调用方内存 (块缓冲区、常量表) 先拷入 scratch 再加密、原内存不被改写，引用大段时 v 须以
+ * edge_vector_init_arena 构建，否则返回 EP_ERR_BUFFER_TOO_SMALL (帧内容未变)。含 0x10 时追加
+ * 12 字节截断标签，AAD 为 SC || AK (仅认证时再加上明文 APDU)。IC 在密钥流生成前即递增，
+ * 此后的失败 (如标签追加不下) 也不回退，重试必然使用新 IV；IC 已到 0xFFFFFFFF 时返回
+ * EP_ERR_OVERFLOW。失败时 v 不可再用于发送。
+ */
 edge_error_t edge_dlms_encrypt_apdu(edge_dlms_security_ctx_t *ctx, edge_vector_t *v, uint8_t security_control);
+
+/**
+ * @brief 校验并原地解密 c 处剩余的 SC | IC | 密文 | 标签，IV 取发送方 system title
+ * 成功时 apdu 为明文上的有界子 cursor，c 移到末尾，*ic (可为 NULL) 为收到的 IC，重放检查由调用方负责。
+ * 标签不符返回 EP_ERR_CHECKSUM，此时各段已恢复为原密文。
+ */
+edge_error_t edge_dlms_decrypt_apdu(const edge_dlms_security_ctx_t *ctx, const uint8_t sender_title[8],
+                                    edge_cursor_t *c, edge_cursor_t *apdu, uint32_t *ic);
 void edge_dlms_encoder_init(edge_dlms_encoder_t *enc, edge_vector_t *v);
 edge_error_t edge_dlms_encode_begin_container(edge_dlms_encoder_t *enc, edge_dlms_tag_t tag);
 edge_error_t edge_dlms_encode_set_container_len(edge_dlms_encoder_t *enc, size_t count);
@@ -132,13 +270,96 @@ edge_error_t edge_dlms_decode_variant(edge_cursor_t *c, edge_dlms_variant_t *out
 
 void edge_hdlc_init(edge_hdlc_manager_t *mgr, uint32_t client_addr, uint32_t server_addr);
 void edge_hdlc_reset(edge_hdlc_manager_t *mgr);
+void edge_hdlc_set_allocator(edge_hdlc_manager_t *mgr, const edge_allocator_t *allocator);
 edge_error_t edge_hdlc_build_snrm(edge_hdlc_manager_t *mgr, edge_vector_t *v);
 edge_error_t edge_hdlc_build_iframe(edge_hdlc_manager_t *mgr, edge_vector_t *v, const void *apdu, size_t len, bool final);
 edge_error_t edge_hdlc_parse(edge_hdlc_manager_t *mgr, edge_cursor_t *c, uint8_t *apdu_out, size_t *apdu_len);
 
+/**
+ * @brief 把完整 I 帧 (含 APDU) 编码为帧模板：控制字节为可变字段，HCS/FCS 增量修正
+ * 需要改写 APDU 内字节 (如 invoke-id) 时，可再以 edge_template_add_field 声明 (偏移 8 起为 APDU)。
+ */
+edge_error_t edge_hdlc_template_iframe(edge_hdlc_manager_t *mgr, edge_frame_template_t *t, const void *apdu, size_t len);
+
+/**
+ * @brief 以当前 N(S)/N(R) 改写控制字节后零拷贝追加模板帧，N(S) 递增
+ */
+edge_error_t edge_hdlc_template_emit(edge_hdlc_manager_t *mgr, edge_frame_template_t *t, edge_vector_t *v);
+
+/**
+ * @brief [零拷贝] 解析一个完整 HDLC 帧并校验 HCS/FCS，以 apdu 子 cursor 指向 xDLMS 载荷 (可直接交给 edge_dlms_server_dispatch)
+ * 成功时 c 越过 FCS 与结束标志，停在下一帧处。帧未收全时返回 EP_ERR_INCOMPLETE_DATA，c 停在起始标志；
+ * HCS 不符时返回 EP_ERR_CHECKSUM 并只越过该标志以重新同步；FCS 不符或缺结束标志时越过整帧。
+ */
+edge_error_t edge_hdlc_parse_slice(edge_hdlc_manager_t *mgr, edge_cursor_t *c, edge_cursor_t *apdu);
+
 edge_error_t edge_dlms_build_aarq(edge_dlms_encoder_t *enc);
 edge_error_t edge_dlms_build_get_request(edge_dlms_encoder_t *enc, edge_dlms_service_type_t type, uint8_t invoke_id, const edge_dlms_object_t *obj);
 
+/**
+ * @brief GET-Request-Next，block 为已收到的最后块号 (edge_dlms_build_get_request 的 GET_NEXT 固定为 0)
+ */
+edge_error_t edge_dlms_build_get_next(edge_dlms_encoder_t *enc, uint8_t invoke_id, uint32_t block);
+
+/**
+ * @brief 初始化分块接收器；allocator 为 NULL 时使用全局默认
+ */
+void edge_dlms_block_rx_init(edge_dlms_block_rx_t *rx, struct iovec *chain, int chain_cap, const edge_allocator_t *allocator);
+
+/**
+ * @brief 释放所有块缓冲区，回到空状态
+ */
+void edge_dlms_block_rx_reset(edge_dlms_block_rx_t *rx);
+
+/**
+ * @brief 送入一个 GET-Response APDU (Normal 或 With-Datablock)
+ * 收齐返回 EP_OK；还需后续块返回 EP_ERR_INCOMPLETE_DATA (以 edge_dlms_block_rx_build_next 请求)；
+ * 服务端回 data-access-result 时返回 EP_ERR_GENERIC 且 rx->dar 为结果码。重复块被忽略，
+ * 块号为 1 时视为重新开始，跳号返回 EP_ERR_INVALID_FRAME。
+ */
+edge_error_t edge_dlms_block_rx_feed(edge_dlms_block_rx_t *rx, edge_cursor_t *apdu);
+
+/**
+ * @brief 以最后收到的块号构建 GET-Request-Next
+ */
+edge_error_t edge_dlms_block_rx_build_next(const edge_dlms_block_rx_t *rx, edge_dlms_encoder_t *enc);
+
+/**
+ * @brief 以块链初始化逻辑数据流 cursor，返回当前链代号；新块到达后以 extend 延长，已读位置不变
+ * reset 或块号 1 重启会释放块链，此后旧 cursor 作废：extend 返回 EP_ERR_INVALID_STATE，
+ * 调用方须丢弃已解析的部分并重新调用 edge_dlms_block_rx_cursor。
+ */
+uint32_t edge_dlms_block_rx_cursor(const edge_dlms_block_rx_t *rx, edge_cursor_t *c);
+edge_error_t edge_dlms_block_rx_extend(const edge_dlms_block_rx_t *rx, edge_cursor_t *c, uint32_t generation);
+
+/**
+ * @brief 服务端分发：GET-Normal/Next/With-List、SET-Normal/With-List、ACTION-Normal
+ * 列表请求逐项回结果，整体编码进同一个响应 APDU。流式资源超出一个 PDU 时以
+ * GET-Response-With-Datablock 应答，块数据零拷贝引用块缓冲区，须在下次分发前发出。请求格式错误时返回错误，此时 resp 内容无效。
+ */
 edge_error_t edge_dlms_server_dispatch(edge_dlms_context_t *ctx, edge_cursor_t *req, edge_vector_t *resp);
 
+/**
+ * @brief 提供流式应答的块缓冲区；单块原始数据取 buf_size 与 max_pdu_send 扣除块头后的较小者
+ */
+void edge_dlms_server_set_block_buffer(edge_dlms_context_t *ctx, uint8_t *buf, size_t buf_size);
+
+/**
+ * @brief 由资源表构建索引，slot_cap 须不小于 2 × count (负载不超过 1/2，探测链保持短)
+ * 资源的 attribute_index 为 0 时匹配该对象的全部属性，为负数时登记方法 (-attribute_index)。
+ * 重复登记返回 EP_ERR_INVALID_ARG。
+ */
+edge_error_t edge_dlms_index_build(edge_dlms_index_t *idx, edge_dlms_index_slot_t *slots, size_t slot_cap,
+                                   const edge_dlms_resource_t *resources, size_t count);
+
+/**
+ * @brief O(1) 查找属性 (index > 0) 或方法 (index < 0)；属性未精确登记时回退到属性 0 的资源
+ */
+const edge_dlms_resource_t *edge_dlms_index_find(const edge_dlms_index_t *idx, uint16_t class_id, const uint8_t obis[6], int8_t index);
+
+/**
+ * @brief 以 ctx->resources 构建分发索引，GET/SET/ACTION 共用
+ */
+edge_error_t edge_dlms_server_build_index(edge_dlms_context_t *ctx, edge_dlms_index_slot_t *slots, size_t slot_cap);
+
 #endif
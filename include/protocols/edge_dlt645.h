@@ -5,6 +5,9 @@
 
 typedef struct {
     uint8_t addr_bcd[6];
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
 } edge_dlt645_context_t;
 
 void edge_dlt645_init(edge_dlt645_context_t *ctx, const char *addr_str);
@@ -15,6 +18,16 @@ void edge_dlt645_init(edge_dlt645_context_t *ctx, const char *addr_str);
  */
 edge_error_t edge_dlt645_build_read_req(edge_dlt645_context_t *ctx, edge_vector_t *v, uint32_t di);
 
+/**
+ * @brief 把读数据请求编码为帧模板 (字段 0 为数据标识，附带 CS)
+ */
+edge_error_t edge_dlt645_template_read_req(edge_dlt645_context_t *ctx, edge_frame_template_t *t, uint32_t di);
+
+/**
+ * @brief 改写数据标识后零拷贝追加模板帧，CS 按差值修正
+ */
+edge_error_t edge_dlt645_template_emit(edge_frame_template_t *t, uint32_t di, edge_vector_t *v);
+
 /**
  * @brief 解析 DLT645 响应帧并提取数据域
  */
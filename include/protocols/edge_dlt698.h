@@ -0,0 +1,38 @@
+#ifndef LIBEDGE_PROTOCOLS_DLT698_H
+#define LIBEDGE_PROTOCOLS_DLT698_H
+
+#include "edge_core.h"
+
+/**
+ * @brief DL/T 698.45 Service Tags
+ */
+typedef enum {
+    D698_SERVICE_GET_REQUEST    = 0x05,
+    D698_SERVICE_GET_RESPONSE   = 0x85,
+    D698_SERVICE_SET_REQUEST    = 0x06,
+    D698_SERVICE_SET_RESPONSE   = 0x86,
+    D698_SERVICE_ACTION_REQUEST = 0x07,
+    D698_SERVICE_REPORT_NOTIF   = 0x88
+} d698_service_tag_t;
+
+/**
+ * @brief DL/T 698.45 Data Tags
+ */
+typedef enum {
+    D698_TAG_NULL       = 0,
+    D698_TAG_ARRAY      = 1,
+    D698_TAG_STRUCTURE  = 2,
+    D698_TAG_BOOL       = 3,
+    D698_TAG_BITSTRING  = 4,
+    D698_TAG_DOUBLE_LONG = 5, // int32
+    D698_TAG_OCTET_STRING = 9,
+    D698_TAG_LONG_UNSIGNED = 18, // uint16
+    D698_TAG_ENUM       = 22
+} d698_data_tag_t;
+
+edge_error_t edge_d698_encode_oad(edge_vector_t *v, uint32_t oad);
+edge_error_t edge_d698_parse_data(edge_cursor_t *c, d698_data_tag_t *tag, const uint8_t **payload, size_t *len);
+edge_error_t edge_d698_build_get_request(edge_vector_t *v, uint32_t oad);
+edge_error_t edge_d698_build_action_request(edge_vector_t *v, uint32_t omad, const uint8_t *data, size_t len);
+
+#endif // LIBEDGE_PROTOCOLS_DLT698_H
@@ -14,11 +14,23 @@
 #define MODBUS_FC_WRITE_SINGLE_REGISTER  0x06
 #define MODBUS_FC_WRITE_MULTIPLE_COILS   0x0F
 #define MODBUS_FC_WRITE_MULTIPLE_REGISTERS 0x10
+#define MODBUS_FC_READ_WRITE_MULTIPLE_REGISTERS 0x17
+
+/**
+ * @brief Modbus Exception Codes
+ */
+#define MODBUS_EX_ILLEGAL_FUNCTION      0x01
+#define MODBUS_EX_ILLEGAL_DATA_ADDRESS  0x02
+#define MODBUS_EX_ILLEGAL_DATA_VALUE    0x03
+#define MODBUS_EX_GATEWAY_TARGET_FAILED 0x0B
 
 typedef struct {
     uint8_t slave_id;
     bool is_tcp;
     uint16_t transaction_id;
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
 } edge_modbus_context_t;
 
 // --- API ---
@@ -30,9 +42,271 @@ void edge_modbus_init(edge_modbus_context_t *ctx, uint8_t slave_id, bool is_tcp)
  */
 edge_error_t edge_modbus_build_read_holding_req(edge_modbus_context_t *ctx, edge_vector_t *v, uint16_t addr, uint16_t quantity);
 
+/**
+ * @brief 构建 01-04 读请求 (线圈/离散输入/保持寄存器/输入寄存器)
+ */
+edge_error_t edge_modbus_build_read_req(edge_modbus_context_t *ctx, edge_vector_t *v, uint8_t fc, uint16_t addr, uint16_t quantity);
+
+/**
+ * @brief 把读保持寄存器请求编码为帧模板 (TCP: TID/地址/数量三个字段；RTU: 地址/数量 + CRC)
+ */
+edge_error_t edge_modbus_template_read_holding(edge_modbus_context_t *ctx, edge_frame_template_t *t, uint16_t addr, uint16_t quantity);
+
+/**
+ * @brief 改写地址/数量 (TCP 递增 TID) 后零拷贝追加模板帧，CRC 增量修正
+ */
+edge_error_t edge_modbus_template_emit(edge_modbus_context_t *ctx, edge_frame_template_t *t, uint16_t addr, uint16_t quantity, edge_vector_t *v);
+
 /**
  * @brief 解析 Modbus 响应报文
  */
 edge_error_t edge_modbus_parse_response(edge_modbus_context_t *ctx, edge_cursor_t *c, uint8_t *out_fc, const uint8_t **out_data, size_t *out_len);
 
+// --- Modbus TCP 流水线主站 ---
+
+#define EDGE_MODBUS_PIPE_SLOTS 64   // 事务表槽数 (2 的幂)，TID 低位直接索引
+#define EDGE_MODBUS_MBAP_LEN   7
+
+/**
+ * @brief 一条在途请求记录
+ */
+typedef struct {
+    uint16_t tid;
+    uint8_t unit_id;
+    uint8_t fc;
+    uint16_t addr;
+    uint16_t quantity;      // 01-04 为数量，05/06 为写入值
+    bool in_use;
+    uint64_t deadline_ms;
+    void *user;             // 调用方附带的请求上下文
+} edge_modbus_txn_t;
+
+/**
+ * @brief 流水线主站：同一连接上多个请求在途，乱序响应按 TID 以 O(1) 匹配
+ * 库内不取时间，超时判定使用调用方传入的 now_ms。
+ */
+typedef struct {
+    edge_modbus_txn_t slots[EDGE_MODBUS_PIPE_SLOTS];
+    uint8_t unit_inflight[256];
+    uint16_t next_tid;
+    uint16_t inflight;
+    uint16_t max_inflight;  // 整条连接的在途上限 (<= EDGE_MODBUS_PIPE_SLOTS)
+    uint8_t unit_limit;     // 每个单元标识的在途上限
+    uint32_t timeout_ms;
+    uint64_t next_deadline; // 最早的截止时间，expire 据此快速返回
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
+} edge_modbus_pipeline_t;
+
+/**
+ * @brief 匹配结果：exception 非 0 时为异常响应，data 为空
+ */
+typedef struct {
+    edge_modbus_txn_t txn;
+    uint8_t fc;
+    uint8_t exception;
+    edge_cursor_t data;     // [零拷贝] 读响应为字节计数之后的数据，写响应为回显的 addr/value (可跨段)
+} edge_modbus_pipe_result_t;
+
+/**
+ * @brief 初始化流水线 (max_inflight 为 0 或超过槽数时取槽数，unit_limit 为 0 时不限)
+ */
+void edge_modbus_pipeline_init(edge_modbus_pipeline_t *p, uint16_t max_inflight, uint8_t unit_limit, uint32_t timeout_ms);
+
+/**
+ * @brief 连接或该单元的在途数是否已达上限
+ */
+bool edge_modbus_pipeline_can_send(const edge_modbus_pipeline_t *p, uint8_t unit_id);
+
+/**
+ * @brief 分配 TID 并构建 01-06 请求 (MBAP + fc + addr + quantity/value)
+ * 达到在途上限时返回 EP_ERR_OVERFLOW，不写入 v；成功时 out_tid (可为 NULL) 返回所用 TID。
+ */
+edge_error_t edge_modbus_pipeline_send(edge_modbus_pipeline_t *p, edge_vector_t *v, uint8_t unit_id, uint8_t fc,
+                                       uint16_t addr, uint16_t quantity, uint64_t now_ms, void *user, uint16_t *out_tid);
+
+/**
+ * @brief 从流中解析一条响应并匹配在途记录，c 前进到下一帧
+ * 帧不完整时返回 EP_ERR_INCOMPLETE_DATA、MBAP 非法时返回 EP_ERR_INVALID_FRAME，两者 c 均不动；
+ * TID 不在表中 (如已超时) 时整帧丢弃并返回 EP_ERR_INVALID_STATE；
+ * 单元、功能码或数据长度与记录不符时整帧丢弃并返回 EP_ERR_INVALID_FRAME，记录保留等待正确响应。
+ */
+edge_error_t edge_modbus_pipeline_on_response(edge_modbus_pipeline_t *p, edge_cursor_t *c, edge_modbus_pipe_result_t *out);
+
+/**
+ * @brief 回收截止时间早于 now_ms 的请求，最多输出 max 条到 out (可为 NULL)，返回回收数
+ */
+size_t edge_modbus_pipeline_expire(edge_modbus_pipeline_t *p, uint64_t now_ms, edge_modbus_txn_t *out, size_t max);
+
+// --- 轮询计划：点表合并为最少的读请求 ---
+
+#define EDGE_MODBUS_MAX_READ_REGS 125
+#define EDGE_MODBUS_MAX_READ_BITS 2000
+
+typedef enum {
+    EDGE_MODBUS_POINT_BIT = 0,  // 线圈/离散输入
+    EDGE_MODBUS_POINT_U16,
+    EDGE_MODBUS_POINT_I16,
+    EDGE_MODBUS_POINT_U32,      // 32 位类型占两个寄存器，默认高字在前
+    EDGE_MODBUS_POINT_I32,
+    EDGE_MODBUS_POINT_F32,
+} edge_modbus_point_type_t;
+
+/**
+ * @brief 一个采集点：table 为读取它的功能码 (01-04)
+ */
+typedef struct {
+    uint8_t unit_id;
+    uint8_t table;
+    uint16_t addr;
+    uint8_t type;           // edge_modbus_point_type_t
+    bool word_swap;         // 32 位类型低字在前 (CDAB)
+} edge_modbus_point_t;
+
+typedef union {
+    bool bit;
+    uint16_t u16;
+    int16_t i16;
+    uint32_t u32;
+    int32_t i32;
+    float f32;
+} edge_modbus_value_t;
+
+/**
+ * @brief 解码表项：把响应中 offset 处的数据写到 values[point]
+ */
+typedef struct {
+    uint16_t point;         // 点在输入数组中的下标
+    uint16_t offset;        // 响应数据内的寄存器/位偏移
+    uint16_t addr;
+    uint8_t unit_id;
+    uint8_t table;
+    uint8_t type;
+    bool word_swap;
+} edge_modbus_decode_t;
+
+/**
+ * @brief 计划中的一条请求，对应解码表 map[first_map .. first_map + map_count)
+ */
+typedef struct {
+    uint8_t unit_id;
+    uint8_t fc;
+    uint16_t addr;
+    uint16_t quantity;
+    uint16_t first_map;
+    uint16_t map_count;
+} edge_modbus_poll_req_t;
+
+/**
+ * @brief 轮询计划：请求与解码表均为调用方提供的存储
+ * reg_gap / bit_gap 为允许一并读取的最大空洞 (寄存器数/位数)，多读几个无用寄存器通常比多一次往返便宜；
+ * 部分设备读到未定义地址会回异常 02，此时应保持为 0。
+ */
+typedef struct {
+    edge_modbus_poll_req_t *reqs;
+    size_t req_cap;
+    size_t req_count;
+    edge_modbus_decode_t *map;
+    size_t map_cap;
+    size_t map_count;
+    uint16_t max_regs;      // 默认 125，取值 2..EDGE_MODBUS_MAX_READ_REGS
+    uint16_t max_bits;      // 默认 2000，取值 1..EDGE_MODBUS_MAX_READ_BITS
+    uint16_t reg_gap;
+    uint16_t bit_gap;
+} edge_modbus_poll_plan_t;
+
+void edge_modbus_poll_plan_init(edge_modbus_poll_plan_t *plan, edge_modbus_poll_req_t *reqs, size_t req_cap,
+                                edge_modbus_decode_t *map, size_t map_cap);
+
+/**
+ * @brief 按 (单元, 功能码, 地址) 排序合并点表，生成最少的请求与解码表
+ * map_cap 须不小于 count；请求数超过 req_cap 时返回 EP_ERR_BUFFER_TOO_SMALL；
+ * 类型与功能码不匹配 (位点用于寄存器表或反之)、max_regs/max_bits 超出协议范围时返回 EP_ERR_INVALID_ARG。
+ */
+edge_error_t edge_modbus_poll_plan_compile(edge_modbus_poll_plan_t *plan, const edge_modbus_point_t *points, size_t count);
+
+/**
+ * @brief 构建计划中第 index 条请求
+ */
+edge_error_t edge_modbus_poll_build(const edge_modbus_poll_plan_t *plan, size_t index, edge_modbus_context_t *ctx, edge_vector_t *v);
+
+/**
+ * @brief 把第 index 条请求的响应数据 (字节计数之后的部分) 分散写入 values[点下标]
+ * 数据长度与请求数量不符时返回 EP_ERR_INVALID_FRAME。
+ */
+edge_error_t edge_modbus_poll_decode(const edge_modbus_poll_plan_t *plan, size_t index, edge_cursor_t *data, edge_modbus_value_t *values);
+
+// --- 从站数据模型 ---
+
+typedef enum {
+    EDGE_MODBUS_TABLE_COILS = 0,            // 读功能码 - 1
+    EDGE_MODBUS_TABLE_DISCRETE_INPUTS,
+    EDGE_MODBUS_TABLE_HOLDING_REGISTERS,
+    EDGE_MODBUS_TABLE_INPUT_REGISTERS,
+    EDGE_MODBUS_TABLE_COUNT
+} edge_modbus_table_t;
+
+/**
+ * @brief 一段连续地址的线路序镜像
+ * 寄存器表：count * 2 字节，大端，读响应直接 append_ref；位表：(count + 7) / 8 字节，起始地址为首字节最低位。
+ */
+typedef struct {
+    uint16_t start;
+    uint16_t count;
+    uint8_t *data;
+} edge_modbus_block_t;
+
+/**
+ * @brief 一个单元标识的四张表，每张表由按起始地址升序、互不重叠的若干段组成 (稀疏地址)
+ */
+typedef struct {
+    uint8_t unit_id;
+    edge_modbus_block_t *blocks[EDGE_MODBUS_TABLE_COUNT];
+    uint16_t block_count[EDGE_MODBUS_TABLE_COUNT];
+} edge_modbus_unit_map_t;
+
+/**
+ * @brief 主站写入后的通知 (可选)：addr/count 为被改写的范围
+ */
+typedef void (*edge_modbus_write_fn)(void *user, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, uint16_t count);
+
+typedef struct {
+    edge_modbus_unit_map_t *by_unit[256];
+    edge_modbus_write_fn on_write;
+    void *user;
+    uint8_t bit_buf[EDGE_MODBUS_MAX_READ_BITS / 8]; // 非字节对齐的位读取在此重新打包
+#if EDGE_ENABLE_STATS
+    edge_stats_t stats;
+#endif
+} edge_modbus_slave_t;
+
+/**
+ * @brief 登记各单元的数据模型 (校验段有序且不重叠，单元号不可重复)
+ */
+edge_error_t edge_modbus_slave_init(edge_modbus_slave_t *s, edge_modbus_unit_map_t *units, size_t count);
+
+/**
+ * @brief 应用侧读写镜像 (主机序寄存器值 / 单个位)，范围须落在同一段内
+ */
+edge_error_t edge_modbus_slave_set_regs(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, const uint16_t *vals, size_t n);
+edge_error_t edge_modbus_slave_get_regs(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, uint16_t *vals, size_t n);
+edge_error_t edge_modbus_slave_set_bit(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, bool val);
+edge_error_t edge_modbus_slave_get_bit(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, bool *val);
+
+/**
+ * @brief 从站 PDU 处理器：01/02/03/04/05/06/0F/10/17，非法请求回对应异常码
+ * req 为功能码起的 PDU；读响应零拷贝引用镜像 (或 s->bit_buf)，在镜像被改写或下次调用前发送。
+ * 单元号未登记时返回 EP_ERR_NOT_SUPPORTED 且不写 resp (RTU 从站应保持沉默)。
+ */
+edge_error_t edge_modbus_slave_handle_pdu(edge_modbus_slave_t *s, uint8_t unit_id, edge_cursor_t *req, edge_vector_t *resp);
+
+/**
+ * @brief 处理流中的一帧 Modbus TCP 请求并构建带 MBAP 的响应，c 前进到下一帧
+ * 帧不完整时返回 EP_ERR_INCOMPLETE_DATA、MBAP 非法时返回 EP_ERR_INVALID_FRAME，两者 c 均不动；
+ * 单元号未登记时回异常 0B (网关目标无响应)。其余失败 (如 resp 容量不足) 时 resp 截回调用前长度、
+ * c 同样不动，不会留下半个 MBAP 头，换更大的 resp 即可重试。
+ */
+edge_error_t edge_modbus_slave_handle_tcp(edge_modbus_slave_t *s, edge_cursor_t *c, edge_vector_t *resp);
+
 #endif // LIBEDGE_PROTOCOLS_MODBUS_H
\ No newline at end of file
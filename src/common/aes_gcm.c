@@ -0,0 +1,672 @@
+#include "edge_gcm.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EDGE_GCM_HAVE_AESNI 1
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define EDGE_GCM_HAVE_ARMV8 1
+#endif
+
+/**
+ * @brief 引擎原语
+ * 上层 (start/aad/encrypt/finish) 只负责分段拼接与长度记账，整块运算都经由这三个入口。
+ */
+typedef struct {
+    void (*block)(const edge_gcm_key_t *k, const uint8_t in[16], uint8_t out[16]);
+    void (*ghash)(const edge_gcm_key_t *k, uint8_t y[16], const uint8_t *p, size_t nblocks);
+    void (*ctr)(const edge_gcm_key_t *k, uint8_t ctr[16], uint8_t *p, size_t nblocks);   // p ^= E(ctr++)
+} _gcm_ops_t;
+
+static volatile bool g_gcm_ready = false;
+static edge_gcm_engine_t g_gcm_engine = EDGE_GCM_ENGINE_PORTABLE;
+static const _gcm_ops_t *g_gcm_ops;
+
+static inline uint32_t _gcm_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void _gcm_put_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24); p[1] = (uint8_t)(v >> 16); p[2] = (uint8_t)(v >> 8); p[3] = (uint8_t)v;
+}
+
+static inline uint64_t _gcm_be64(const uint8_t *p) {
+    return ((uint64_t)_gcm_be32(p) << 32) | _gcm_be32(p + 4);
+}
+
+static inline void _gcm_put_be64(uint8_t *p, uint64_t v) {
+    _gcm_put_be32(p, (uint32_t)(v >> 32)); _gcm_put_be32(p + 4, (uint32_t)v);
+}
+
+static inline void _gcm_inc32(uint8_t ctr[16]) {
+    _gcm_put_be32(ctr + 12, _gcm_be32(ctr + 12) + 1);
+}
+
+static inline void _gcm_xor16(uint8_t *dst, const uint8_t *src) {
+    for (int i = 0; i < 16; i++) dst[i] ^= src[i];
+}
+
+// --- 1. 可移植实现 (位切片 AES + 无表 GHASH，常数时间) ---
+
+/*
+ * 不查任何以密钥/数据为下标的表：AES 以 4 个分组为一批位切片，8 个 64 位平面中
+ * 平面 j 的第 16b+i 位为分组 b 字节 i 的第 j 位；S 盒为 Boyar-Peralta 113 门电路，
+ * ShiftRows/MixColumns 化为平面内的定长移位。GHASH 用带空洞的整数乘法拼出无进位乘法。
+ */
+#define _GCM_REP16(v) ((uint64_t)(v) * 0x0001000100010001ull)
+
+static inline uint64_t _gcm_le64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+static inline void _gcm_put_le64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++, v >>= 8) p[i] = (uint8_t)v;
+}
+
+// 8x8 位矩阵转置：字节 i 的第 j 位 <-> 字节 j 的第 i 位
+static inline uint64_t _gcm_tr8x8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull; x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull; x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull; x ^= t ^ (t << 28);
+    return x;
+}
+
+static void _gcm_ct_pack(uint64_t q[8], const uint8_t *in, int nblk) {
+    for (int j = 0; j < 8; j++) q[j] = 0;
+    for (int b = 0; b < nblk; b++) {
+        uint64_t lo = _gcm_tr8x8(_gcm_le64(in + 16 * b)), hi = _gcm_tr8x8(_gcm_le64(in + 16 * b + 8));
+        for (int j = 0; j < 8; j++) q[j] |= (((lo >> (8 * j)) & 0xFF) | (((hi >> (8 * j)) & 0xFF) << 8)) << (16 * b);
+    }
+}
+
+static void _gcm_ct_unpack(const uint64_t q[8], uint8_t *out, int nblk) {
+    for (int b = 0; b < nblk; b++) {
+        uint64_t lo = 0, hi = 0;
+        for (int j = 0; j < 8; j++) {
+            lo |= ((q[j] >> (16 * b)) & 0xFF) << (8 * j);
+            hi |= ((q[j] >> (16 * b + 8)) & 0xFF) << (8 * j);
+        }
+        _gcm_put_le64(out + 16 * b, _gcm_tr8x8(lo));
+        _gcm_put_le64(out + 16 * b + 8, _gcm_tr8x8(hi));
+    }
+}
+
+// S 盒 (q[7] 为最高位)：GF(2^8) 求逆 + 仿射变换的布尔电路，与输入无关的固定指令序列
+static void _gcm_ct_sbox(uint64_t q[8]) {
+    uint64_t x0 = q[7], x1 = q[6], x2 = q[5], x3 = q[4], x4 = q[3], x5 = q[2], x6 = q[1], x7 = q[0];
+    uint64_t y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    uint64_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17;
+    uint64_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    uint64_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29, t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    uint64_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49, t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    uint64_t t60, t61, t62, t63, t64, t65, t66, t67;
+    uint64_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    // 顶层线性变换
+    y14 = x3 ^ x5; y13 = x0 ^ x6; y9 = x0 ^ x3; y8 = x0 ^ x5; t0 = x1 ^ x2; y1 = t0 ^ x7; y4 = y1 ^ x3;
+    y12 = y13 ^ y14; y2 = y1 ^ x0; y5 = y1 ^ x6; y3 = y5 ^ y8; t1 = x4 ^ y12; y15 = t1 ^ x5; y20 = t1 ^ x1;
+    y6 = y15 ^ x7; y10 = y15 ^ t0; y11 = y20 ^ y9; y7 = x7 ^ y11; y17 = y10 ^ y11; y19 = y10 ^ y8;
+    y16 = t0 ^ y11; y21 = y13 ^ y16; y18 = x0 ^ y16;
+
+    // 非线性部分 (GF(2^4) 塔域求逆)
+    t2 = y12 & y15; t3 = y3 & y6; t4 = t3 ^ t2; t5 = y4 & x7; t6 = t5 ^ t2; t7 = y13 & y16; t8 = y5 & y1;
+    t9 = t8 ^ t7; t10 = y2 & y7; t11 = t10 ^ t7; t12 = y9 & y11; t13 = y14 & y17; t14 = t13 ^ t12;
+    t15 = y8 & y10; t16 = t15 ^ t12; t17 = t4 ^ t14; t18 = t6 ^ t16; t19 = t9 ^ t14; t20 = t11 ^ t16;
+    t21 = t17 ^ y20; t22 = t18 ^ y19; t23 = t19 ^ y21; t24 = t20 ^ y18;
+    t25 = t21 ^ t22; t26 = t21 & t23; t27 = t24 ^ t26; t28 = t25 & t27; t29 = t28 ^ t22; t30 = t23 ^ t24;
+    t31 = t22 ^ t26; t32 = t31 & t30; t33 = t32 ^ t24; t34 = t23 ^ t33; t35 = t27 ^ t33; t36 = t24 & t35;
+    t37 = t36 ^ t34; t38 = t27 ^ t36; t39 = t29 & t38; t40 = t25 ^ t39;
+    t41 = t40 ^ t37; t42 = t29 ^ t33; t43 = t29 ^ t40; t44 = t33 ^ t37; t45 = t42 ^ t41;
+    z0 = t44 & y15; z1 = t37 & y6; z2 = t33 & x7; z3 = t43 & y16; z4 = t40 & y1; z5 = t29 & y7;
+    z6 = t42 & y11; z7 = t45 & y17; z8 = t41 & y10; z9 = t44 & y12; z10 = t37 & y3; z11 = t33 & y4;
+    z12 = t43 & y13; z13 = t40 & y5; z14 = t29 & y2; z15 = t42 & y9; z16 = t45 & y14; z17 = t41 & y8;
+
+    // 底层线性变换 (含仿射常数 0x63)
+    t46 = z15 ^ z16; t47 = z10 ^ z11; t48 = z5 ^ z13; t49 = z9 ^ z10; t50 = z2 ^ z12; t51 = z2 ^ z5;
+    t52 = z7 ^ z8; t53 = z0 ^ z3; t54 = z6 ^ z7; t55 = z16 ^ z17; t56 = z12 ^ t48; t57 = t50 ^ t53;
+    t58 = z4 ^ t46; t59 = z3 ^ t54; t60 = t46 ^ t57; t61 = z14 ^ t57; t62 = t52 ^ t58; t63 = t49 ^ t58;
+    t64 = z4 ^ t59; t65 = t61 ^ t62; t66 = z1 ^ t63; s0 = t59 ^ t63; s6 = t56 ^ ~t62; s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65; s3 = t53 ^ t66; s4 = t51 ^ t66; s5 = t47 ^ t65; s1 = t64 ^ ~s3; s2 = t55 ^ ~t67;
+
+    q[7] = s0; q[6] = s1; q[5] = s2; q[4] = s3; q[3] = s4; q[2] = s5; q[1] = s6; q[0] = s7;
+}
+
+// 16 位通道内循环右移 s 位 (s 为 4 的倍数时保持行号不变)
+static inline uint64_t _gcm_ct_rot16(uint64_t x, int s) {
+    return ((x >> s) & _GCM_REP16(0xFFFFu >> s)) | ((x << (16 - s)) & _GCM_REP16((0xFFFFu << (16 - s)) & 0xFFFFu));
+}
+
+// 字节 i = 4c + r 位于通道内第 i 位：第 r 行向左循环 r 列 = 行内位右移 4r
+static void _gcm_ct_shift_rows(uint64_t q[8]) {
+    for (int j = 0; j < 8; j++) {
+        uint64_t x = q[j];
+        q[j] = (x & _GCM_REP16(0x1111)) | _gcm_ct_rot16(x & _GCM_REP16(0x2222), 4) |
+               _gcm_ct_rot16(x & _GCM_REP16(0x4444), 8) | _gcm_ct_rot16(x & _GCM_REP16(0x8888), 12);
+    }
+}
+
+// 列内第 r 行取第 r+1 / r+2 行
+static inline uint64_t _gcm_ct_col1(uint64_t x) {
+    return ((x >> 1) & _GCM_REP16(0x7777)) | ((x << 3) & _GCM_REP16(0x8888));
+}
+
+static inline uint64_t _gcm_ct_col2(uint64_t x) {
+    return ((x >> 2) & _GCM_REP16(0x3333)) | ((x << 2) & _GCM_REP16(0xCCCC));
+}
+
+// out_r = 2·(a_r ^ a_{r+1}) ^ a_{r+1} ^ a_{r+2} ^ a_{r+3}；乘 2 为平面间的移位与异或
+static void _gcm_ct_mix_columns(uint64_t q[8]) {
+    uint64_t a1[8], t[8];
+    for (int j = 0; j < 8; j++) { a1[j] = _gcm_ct_col1(q[j]); t[j] = q[j] ^ a1[j]; }
+    uint64_t hi = t[7];
+    q[0] = hi ^ a1[0] ^ _gcm_ct_col2(t[0]);
+    q[1] = t[0] ^ hi ^ a1[1] ^ _gcm_ct_col2(t[1]);
+    q[2] = t[1] ^ a1[2] ^ _gcm_ct_col2(t[2]);
+    q[3] = t[2] ^ hi ^ a1[3] ^ _gcm_ct_col2(t[3]);
+    q[4] = t[3] ^ hi ^ a1[4] ^ _gcm_ct_col2(t[4]);
+    q[5] = t[4] ^ a1[5] ^ _gcm_ct_col2(t[5]);
+    q[6] = t[5] ^ a1[6] ^ _gcm_ct_col2(t[6]);
+    q[7] = t[6] ^ a1[7] ^ _gcm_ct_col2(t[7]);
+}
+
+static inline void _gcm_ct_add_key(uint64_t q[8], const uint64_t rk[8]) {
+    for (int j = 0; j < 8; j++) q[j] ^= rk[j];
+}
+
+// 至多 4 个分组并行加密
+static void _gcm_ct_encrypt(const edge_gcm_key_t *k, const uint8_t *in, uint8_t *out, int nblk) {
+    uint64_t q[8];
+    _gcm_ct_pack(q, in, nblk);
+    _gcm_ct_add_key(q, k->rk_slice[0]);
+    for (int r = 1; r < 10; r++) {
+        _gcm_ct_sbox(q);
+        _gcm_ct_shift_rows(q);
+        _gcm_ct_mix_columns(q);
+        _gcm_ct_add_key(q, k->rk_slice[r]);
+    }
+    _gcm_ct_sbox(q);
+    _gcm_ct_shift_rows(q);
+    _gcm_ct_add_key(q, k->rk_slice[10]);
+    _gcm_ct_unpack(q, out, nblk);
+}
+
+static void _gcm_soft_block(const edge_gcm_key_t *k, const uint8_t in[16], uint8_t out[16]) {
+    _gcm_ct_encrypt(k, in, out, 1);
+}
+
+// 位反转 (GHASH 乘积高半部分经反转后的低半部分求得)
+static inline uint64_t _gcm_rev64(uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+    x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((x & 0x0F0F0F0F0F0F0F0Full) << 4);
+    x = ((x >> 8) & 0x00FF00FF00FF00FFull) | ((x & 0x00FF00FF00FF00FFull) << 8);
+    x = ((x >> 16) & 0x0000FFFF0000FFFFull) | ((x & 0x0000FFFF0000FFFFull) << 16);
+    return (x >> 32) | (x << 32);
+}
+
+/*
+ * 64x64 无进位乘积的低 64 位：操作数按位号模 4 拆成 4 份，整数乘法中同组的位间隔 4 位，
+ * 低 64 位内每个位置至多 16 项相加，进位只会越出第 63 位而被截掉，不会污染相邻的有效位。
+ */
+static inline uint64_t _gcm_bmul64(uint64_t x, uint64_t y) {
+    const uint64_t m0 = 0x1111111111111111ull, m1 = m0 << 1, m2 = m0 << 2, m3 = m0 << 3;
+    uint64_t x0 = x & m0, x1 = x & m1, x2 = x & m2, x3 = x & m3;
+    uint64_t y0 = y & m0, y1 = y & m1, y2 = y & m2, y3 = y & m3;
+    uint64_t z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    uint64_t z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    uint64_t z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    uint64_t z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+    return (z0 & m0) | (z1 & m1) | (z2 & m2) | (z3 & m3);
+}
+
+/*
+ * x <- x·H：大端载入后系数 i 位于第 127-i 位 (位反射域)，Karatsuba 三次 64 位乘得 255 位乘积，
+ * 左移 1 位对齐后低 128 位 L 按 x^128 = x^7 + x^2 + x + 1 折叠两次 (第二次吸收右移移出的位)。
+ */
+static void _gcm_soft_mult(const edge_gcm_key_t *k, uint8_t x[16]) {
+    uint64_t a1 = _gcm_be64(x), a0 = _gcm_be64(x + 8);
+    uint64_t b1 = k->h[0], b0 = k->h[1], b1r = k->h_rev[0], b0r = k->h_rev[1];
+    uint64_t a1r = _gcm_rev64(a1), a0r = _gcm_rev64(a0);
+
+    uint64_t lo_lo = _gcm_bmul64(a0, b0), lo_hi = _gcm_rev64(_gcm_bmul64(a0r, b0r)) >> 1;
+    uint64_t hi_lo = _gcm_bmul64(a1, b1), hi_hi = _gcm_rev64(_gcm_bmul64(a1r, b1r)) >> 1;
+    uint64_t md_lo = _gcm_bmul64(a0 ^ a1, b0 ^ b1), md_hi = _gcm_rev64(_gcm_bmul64(a0r ^ a1r, b0r ^ b1r)) >> 1;
+    md_lo ^= lo_lo ^ hi_lo; md_hi ^= lo_hi ^ hi_hi;
+
+    // 乘积 p3:p2:p1:p0 左移 1 位
+    uint64_t p3 = hi_hi, p2 = hi_lo ^ md_hi, p1 = lo_hi ^ md_lo, p0 = lo_lo;
+    p3 = (p3 << 1) | (p2 >> 63); p2 = (p2 << 1) | (p1 >> 63); p1 = (p1 << 1) | (p0 >> 63); p0 <<= 1;
+
+    // 溢出位 O = L<<127 ^ L<<126 ^ L<<121 (只落在高字)，与 L 一并折叠
+    uint64_t o = (p0 << 63) ^ (p0 << 62) ^ (p0 << 57);
+    uint64_t l1 = p1 ^ o, l0 = p0;
+    uint64_t r1 = l1 ^ (l1 >> 1) ^ (l1 >> 2) ^ (l1 >> 7);
+    uint64_t r0 = l0 ^ ((l0 >> 1) | (l1 << 63)) ^ ((l0 >> 2) | (l1 << 62)) ^ ((l0 >> 7) | (l1 << 57));
+    _gcm_put_be64(x, p3 ^ r1);
+    _gcm_put_be64(x + 8, p2 ^ r0);
+}
+
+static void _gcm_soft_ghash(const edge_gcm_key_t *k, uint8_t y[16], const uint8_t *p, size_t n) {
+    for (; n; n--, p += 16) {
+        _gcm_xor16(y, p);
+        _gcm_soft_mult(k, y);
+    }
+}
+
+static void _gcm_soft_ctr(const edge_gcm_key_t *k, uint8_t ctr[16], uint8_t *p, size_t n) {
+    uint8_t cb[64], ks[64];
+    while (n) {
+        int m = n < 4 ? (int)n : 4;
+        for (int b = 0; b < m; b++) { memcpy(cb + 16 * b, ctr, 16); _gcm_inc32(ctr); }
+        _gcm_ct_encrypt(k, cb, ks, m);
+        for (int i = 0; i < 16 * m; i++) p[i] ^= ks[i];
+        p += 16 * m; n -= (size_t)m;
+    }
+}
+
+static const _gcm_ops_t k_gcm_soft_ops = { _gcm_soft_block, _gcm_soft_ghash, _gcm_soft_ctr };
+
+// --- 2. 硬件实现 (AES-NI + PCLMULQDQ / ARMv8 AES + PMULL) ---
+
+/*
+ * GHASH 在字节反序域内做无进位乘法 (Intel CLMUL 白皮书算法 5)：
+ * 256 位乘积整体左移 1 位补偿位反射，再按 x^128 + x^7 + x^2 + x + 1 两阶段归约。
+ * 乘法与归约拆开，4 块聚合 Y' = (Y^X1)·H^4 ^ X2·H^3 ^ X3·H^2 ^ X4·H 只归约一次。
+ */
+#if defined(EDGE_GCM_HAVE_AESNI)
+#define _GCM_X86 __attribute__((target("aes,pclmul,ssse3")))
+
+_GCM_X86 static inline __m128i _gcm_x86_bswap(__m128i x) {
+    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+_GCM_X86 static inline void _gcm_x86_mul(__m128i a, __m128i b, __m128i *lo, __m128i *hi) {
+    __m128i t0 = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i t1 = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i t2 = _mm_clmulepi64_si128(a, b, 0x11);
+    *lo = _mm_xor_si128(*lo, _mm_xor_si128(t0, _mm_slli_si128(t1, 8)));
+    *hi = _mm_xor_si128(*hi, _mm_xor_si128(t2, _mm_srli_si128(t1, 8)));
+}
+
+_GCM_X86 static inline __m128i _gcm_x86_reduce(__m128i lo, __m128i hi) {
+    __m128i c_lo = _mm_srli_epi32(lo, 31), c_hi = _mm_srli_epi32(hi, 31);
+    lo = _mm_or_si128(_mm_slli_epi32(lo, 1), _mm_slli_si128(c_lo, 4));
+    hi = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(hi, 1), _mm_slli_si128(c_hi, 4)), _mm_srli_si128(c_lo, 12));
+
+    __m128i a = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    lo = _mm_xor_si128(lo, _mm_slli_si128(a, 12));
+    __m128i b = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    b = _mm_xor_si128(b, _mm_srli_si128(a, 4));
+    return _mm_xor_si128(hi, _mm_xor_si128(lo, b));
+}
+
+_GCM_X86 static void _gcm_x86_ghash(const edge_gcm_key_t *k, uint8_t y[16], const uint8_t *p, size_t n) {
+    const __m128i h1 = _mm_loadu_si128((const __m128i *)k->h_pow[0]);
+    __m128i acc = _gcm_x86_bswap(_mm_loadu_si128((const __m128i *)y));
+    if (n >= 4) {
+        const __m128i h2 = _mm_loadu_si128((const __m128i *)k->h_pow[1]);
+        const __m128i h3 = _mm_loadu_si128((const __m128i *)k->h_pow[2]);
+        const __m128i h4 = _mm_loadu_si128((const __m128i *)k->h_pow[3]);
+        for (; n >= 4; n -= 4, p += 64) {
+            __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+            _gcm_x86_mul(_mm_xor_si128(acc, _gcm_x86_bswap(_mm_loadu_si128((const __m128i *)p))), h4, &lo, &hi);
+            _gcm_x86_mul(_gcm_x86_bswap(_mm_loadu_si128((const __m128i *)(p + 16))), h3, &lo, &hi);
+            _gcm_x86_mul(_gcm_x86_bswap(_mm_loadu_si128((const __m128i *)(p + 32))), h2, &lo, &hi);
+            _gcm_x86_mul(_gcm_x86_bswap(_mm_loadu_si128((const __m128i *)(p + 48))), h1, &lo, &hi);
+            acc = _gcm_x86_reduce(lo, hi);
+        }
+    }
+    for (; n; n--, p += 16) {
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        _gcm_x86_mul(_mm_xor_si128(acc, _gcm_x86_bswap(_mm_loadu_si128((const __m128i *)p))), h1, &lo, &hi);
+        acc = _gcm_x86_reduce(lo, hi);
+    }
+    _mm_storeu_si128((__m128i *)y, _gcm_x86_bswap(acc));
+}
+
+_GCM_X86 static void _gcm_x86_block(const edge_gcm_key_t *k, const uint8_t in[16], uint8_t out[16]) {
+    __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), _mm_loadu_si128((const __m128i *)k->rk_bytes[0]));
+    for (int r = 1; r < 10; r++) b = _mm_aesenc_si128(b, _mm_loadu_si128((const __m128i *)k->rk_bytes[r]));
+    _mm_storeu_si128((__m128i *)out, _mm_aesenclast_si128(b, _mm_loadu_si128((const __m128i *)k->rk_bytes[10])));
+}
+
+/*
+ * 计数块整体字节反序后，大端 32 位计数器落在最低双字，_mm_add_epi32 即 inc32 (模 2^32 回绕)。
+ * 8 路交错隐藏 AESENC 延迟。
+ */
+_GCM_X86 static void _gcm_x86_ctr(const edge_gcm_key_t *k, uint8_t ctr[16], uint8_t *p, size_t n) {
+    __m128i rk[11];
+    for (int r = 0; r < 11; r++) rk[r] = _mm_loadu_si128((const __m128i *)k->rk_bytes[r]);
+    const __m128i one = _mm_set_epi32(0, 0, 0, 1);
+    __m128i c = _gcm_x86_bswap(_mm_loadu_si128((const __m128i *)ctr));
+    for (; n >= 8; n -= 8, p += 128) {
+        __m128i b[8];
+        for (int j = 0; j < 8; j++) {
+            b[j] = _mm_xor_si128(_gcm_x86_bswap(c), rk[0]);
+            c = _mm_add_epi32(c, one);
+        }
+        for (int r = 1; r < 10; r++) {
+            for (int j = 0; j < 8; j++) b[j] = _mm_aesenc_si128(b[j], rk[r]);
+        }
+        for (int j = 0; j < 8; j++) {
+            __m128i *q = (__m128i *)(p + 16 * j);
+            _mm_storeu_si128(q, _mm_xor_si128(_mm_loadu_si128(q), _mm_aesenclast_si128(b[j], rk[10])));
+        }
+    }
+    for (; n; n--, p += 16) {
+        __m128i b = _mm_xor_si128(_gcm_x86_bswap(c), rk[0]);
+        c = _mm_add_epi32(c, one);
+        for (int r = 1; r < 10; r++) b = _mm_aesenc_si128(b, rk[r]);
+        _mm_storeu_si128((__m128i *)p, _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), _mm_aesenclast_si128(b, rk[10])));
+    }
+    _mm_storeu_si128((__m128i *)ctr, _gcm_x86_bswap(c));
+}
+
+static bool _gcm_cpu_has_hw(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+}
+
+static const _gcm_ops_t k_gcm_hw_ops = { _gcm_x86_block, _gcm_x86_ghash, _gcm_x86_ctr };
+#elif defined(EDGE_GCM_HAVE_ARMV8)
+#define _GCM_ARM __attribute__((target("+crypto")))
+
+// 与 x86 路径逐条对应：_mm_slli_si128/_mm_srli_si128 以 vextq_u8 拼接零向量实现
+#define _GCM_SHL32(x, n) vreinterpretq_u8_u32(vshlq_n_u32(vreinterpretq_u32_u8(x), n))
+#define _GCM_SHR32(x, n) vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(x), n))
+#define _GCM_SHL128(x, n) vextq_u8(vdupq_n_u8(0), (x), 16 - (n))
+#define _GCM_SHR128(x, n) vextq_u8((x), vdupq_n_u8(0), (n))
+#define _GCM_PMULL(a, la, b, lb) vreinterpretq_u8_p128(vmull_p64((poly64_t)vgetq_lane_u64(vreinterpretq_u64_u8(a), la), \
+                                                                (poly64_t)vgetq_lane_u64(vreinterpretq_u64_u8(b), lb)))
+
+_GCM_ARM static inline uint8x16_t _gcm_arm_bswap(uint8x16_t x) {
+    x = vrev64q_u8(x);
+    return vextq_u8(x, x, 8);
+}
+
+_GCM_ARM static inline void _gcm_arm_mul(uint8x16_t a, uint8x16_t b, uint8x16_t *lo, uint8x16_t *hi) {
+    uint8x16_t t0 = _GCM_PMULL(a, 0, b, 0);
+    uint8x16_t t1 = veorq_u8(_GCM_PMULL(a, 0, b, 1), _GCM_PMULL(a, 1, b, 0));
+    uint8x16_t t2 = _GCM_PMULL(a, 1, b, 1);
+    *lo = veorq_u8(*lo, veorq_u8(t0, _GCM_SHL128(t1, 8)));
+    *hi = veorq_u8(*hi, veorq_u8(t2, _GCM_SHR128(t1, 8)));
+}
+
+_GCM_ARM static inline uint8x16_t _gcm_arm_reduce(uint8x16_t lo, uint8x16_t hi) {
+    uint8x16_t c_lo = _GCM_SHR32(lo, 31), c_hi = _GCM_SHR32(hi, 31);
+    lo = vorrq_u8(_GCM_SHL32(lo, 1), _GCM_SHL128(c_lo, 4));
+    hi = vorrq_u8(vorrq_u8(_GCM_SHL32(hi, 1), _GCM_SHL128(c_hi, 4)), _GCM_SHR128(c_lo, 12));
+
+    uint8x16_t a = veorq_u8(veorq_u8(_GCM_SHL32(lo, 31), _GCM_SHL32(lo, 30)), _GCM_SHL32(lo, 25));
+    lo = veorq_u8(lo, _GCM_SHL128(a, 12));
+    uint8x16_t b = veorq_u8(veorq_u8(_GCM_SHR32(lo, 1), _GCM_SHR32(lo, 2)), _GCM_SHR32(lo, 7));
+    b = veorq_u8(b, _GCM_SHR128(a, 4));
+    return veorq_u8(hi, veorq_u8(lo, b));
+}
+
+_GCM_ARM static void _gcm_arm_ghash(const edge_gcm_key_t *k, uint8_t y[16], const uint8_t *p, size_t n) {
+    const uint8x16_t h1 = vld1q_u8(k->h_pow[0]);
+    uint8x16_t acc = _gcm_arm_bswap(vld1q_u8(y));
+    if (n >= 4) {
+        const uint8x16_t h2 = vld1q_u8(k->h_pow[1]), h3 = vld1q_u8(k->h_pow[2]), h4 = vld1q_u8(k->h_pow[3]);
+        for (; n >= 4; n -= 4, p += 64) {
+            uint8x16_t lo = vdupq_n_u8(0), hi = vdupq_n_u8(0);
+            _gcm_arm_mul(veorq_u8(acc, _gcm_arm_bswap(vld1q_u8(p))), h4, &lo, &hi);
+            _gcm_arm_mul(_gcm_arm_bswap(vld1q_u8(p + 16)), h3, &lo, &hi);
+            _gcm_arm_mul(_gcm_arm_bswap(vld1q_u8(p + 32)), h2, &lo, &hi);
+            _gcm_arm_mul(_gcm_arm_bswap(vld1q_u8(p + 48)), h1, &lo, &hi);
+            acc = _gcm_arm_reduce(lo, hi);
+        }
+    }
+    for (; n; n--, p += 16) {
+        uint8x16_t lo = vdupq_n_u8(0), hi = vdupq_n_u8(0);
+        _gcm_arm_mul(veorq_u8(acc, _gcm_arm_bswap(vld1q_u8(p))), h1, &lo, &hi);
+        acc = _gcm_arm_reduce(lo, hi);
+    }
+    vst1q_u8(y, _gcm_arm_bswap(acc));
+}
+
+// AESE = AddRoundKey + SubBytes + ShiftRows，末轮后再异或最后一个轮密钥
+_GCM_ARM static inline uint8x16_t _gcm_arm_encrypt(const uint8x16_t rk[11], uint8x16_t b) {
+    for (int r = 0; r < 9; r++) b = vaesmcq_u8(vaeseq_u8(b, rk[r]));
+    return veorq_u8(vaeseq_u8(b, rk[9]), rk[10]);
+}
+
+_GCM_ARM static void _gcm_arm_block(const edge_gcm_key_t *k, const uint8_t in[16], uint8_t out[16]) {
+    uint8x16_t rk[11];
+    for (int r = 0; r < 11; r++) rk[r] = vld1q_u8(k->rk_bytes[r]);
+    vst1q_u8(out, _gcm_arm_encrypt(rk, vld1q_u8(in)));
+}
+
+_GCM_ARM static void _gcm_arm_ctr(const edge_gcm_key_t *k, uint8_t ctr[16], uint8_t *p, size_t n) {
+    uint8x16_t rk[11];
+    for (int r = 0; r < 11; r++) rk[r] = vld1q_u8(k->rk_bytes[r]);
+    uint32x4_t base = vreinterpretq_u32_u8(vld1q_u8(ctr));
+    uint32_t c = _gcm_be32(ctr + 12);
+    for (; n >= 4; n -= 4, p += 64) {
+        uint8x16_t b0 = vreinterpretq_u8_u32(vsetq_lane_u32(__builtin_bswap32(c), base, 3));
+        uint8x16_t b1 = vreinterpretq_u8_u32(vsetq_lane_u32(__builtin_bswap32(c + 1), base, 3));
+        uint8x16_t b2 = vreinterpretq_u8_u32(vsetq_lane_u32(__builtin_bswap32(c + 2), base, 3));
+        uint8x16_t b3 = vreinterpretq_u8_u32(vsetq_lane_u32(__builtin_bswap32(c + 3), base, 3));
+        c += 4;
+        for (int r = 0; r < 9; r++) {
+            b0 = vaesmcq_u8(vaeseq_u8(b0, rk[r])); b1 = vaesmcq_u8(vaeseq_u8(b1, rk[r]));
+            b2 = vaesmcq_u8(vaeseq_u8(b2, rk[r])); b3 = vaesmcq_u8(vaeseq_u8(b3, rk[r]));
+        }
+        vst1q_u8(p, veorq_u8(vld1q_u8(p), veorq_u8(vaeseq_u8(b0, rk[9]), rk[10])));
+        vst1q_u8(p + 16, veorq_u8(vld1q_u8(p + 16), veorq_u8(vaeseq_u8(b1, rk[9]), rk[10])));
+        vst1q_u8(p + 32, veorq_u8(vld1q_u8(p + 32), veorq_u8(vaeseq_u8(b2, rk[9]), rk[10])));
+        vst1q_u8(p + 48, veorq_u8(vld1q_u8(p + 48), veorq_u8(vaeseq_u8(b3, rk[9]), rk[10])));
+    }
+    for (; n; n--, p += 16) {
+        uint8x16_t b = vreinterpretq_u8_u32(vsetq_lane_u32(__builtin_bswap32(c++), base, 3));
+        vst1q_u8(p, veorq_u8(vld1q_u8(p), _gcm_arm_encrypt(rk, b)));
+    }
+    _gcm_put_be32(ctr + 12, c);
+}
+
+static bool _gcm_cpu_has_hw(void) {
+    unsigned long hw = getauxval(AT_HWCAP);
+    return (hw & HWCAP_AES) && (hw & HWCAP_PMULL);
+}
+
+static const _gcm_ops_t k_gcm_hw_ops = { _gcm_arm_block, _gcm_arm_ghash, _gcm_arm_ctr };
+#else
+static bool _gcm_cpu_has_hw(void) { return false; }
+#define k_gcm_hw_ops k_gcm_soft_ops
+#endif
+
+// --- 3. 初始化与运行时分发 ---
+
+__attribute__((constructor))
+void edge_gcm_init(void) {
+    if (g_gcm_ready) return;
+    g_gcm_engine = _gcm_cpu_has_hw() ? EDGE_GCM_ENGINE_HW : EDGE_GCM_ENGINE_PORTABLE;
+    g_gcm_ops = g_gcm_engine == EDGE_GCM_ENGINE_HW ? &k_gcm_hw_ops : &k_gcm_soft_ops;
+    g_gcm_ready = true;
+}
+
+bool edge_gcm_engine_supported(edge_gcm_engine_t engine) {
+    if (engine == EDGE_GCM_ENGINE_HW) return _gcm_cpu_has_hw();
+    return engine == EDGE_GCM_ENGINE_AUTO || engine == EDGE_GCM_ENGINE_PORTABLE;
+}
+
+edge_gcm_engine_t edge_gcm_get_engine(void) {
+    if (!g_gcm_ready) edge_gcm_init();
+    return g_gcm_engine;
+}
+
+bool edge_gcm_set_engine(edge_gcm_engine_t engine) {
+    if (!g_gcm_ready) edge_gcm_init();
+    if (engine == EDGE_GCM_ENGINE_AUTO) engine = _gcm_cpu_has_hw() ? EDGE_GCM_ENGINE_HW : EDGE_GCM_ENGINE_PORTABLE;
+    if (!edge_gcm_engine_supported(engine)) return false;
+    g_gcm_engine = engine;
+    g_gcm_ops = engine == EDGE_GCM_ENGINE_HW ? &k_gcm_hw_ops : &k_gcm_soft_ops;
+    return true;
+}
+
+const char *edge_gcm_engine_name(edge_gcm_engine_t engine) {
+    switch (engine) {
+        case EDGE_GCM_ENGINE_AUTO:     return "auto";
+        case EDGE_GCM_ENGINE_PORTABLE: return "portable";
+        case EDGE_GCM_ENGINE_HW:       return "hw";
+    }
+    return "unknown";
+}
+
+// --- 4. 密钥展开 ---
+
+// 常数时间 SubWord：把 4 个字节放进一个分组走位切片 S 盒
+static uint32_t _gcm_sub_word(uint32_t w) {
+    uint8_t buf[16] = { (uint8_t)(w >> 24), (uint8_t)(w >> 16), (uint8_t)(w >> 8), (uint8_t)w };
+    uint64_t q[8];
+    _gcm_ct_pack(q, buf, 1);
+    _gcm_ct_sbox(q);
+    _gcm_ct_unpack(q, buf, 1);
+    return _gcm_be32(buf);
+}
+
+void edge_gcm_set_key(edge_gcm_key_t *key, const uint8_t raw[16]) {
+    static const uint8_t rcon[10] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36 };
+    if (!g_gcm_ready) edge_gcm_init();
+    uint32_t rk[44];
+    for (int i = 0; i < 4; i++) rk[i] = _gcm_be32(raw + 4 * i);
+    for (int i = 4; i < 44; i++) {
+        uint32_t t = rk[i - 1];
+        if (i % 4 == 0) t = _gcm_sub_word((t << 8) | (t >> 24)) ^ ((uint32_t)rcon[i / 4 - 1] << 24);
+        rk[i] = rk[i - 4] ^ t;
+    }
+    for (int i = 0; i < 44; i++) _gcm_put_be32(key->rk_bytes[i / 4] + 4 * (i % 4), rk[i]);
+
+    // 位切片轮密钥：同一轮密钥复制到 4 个分组通道
+    for (int r = 0; r < 11; r++) {
+        _gcm_ct_pack(key->rk_slice[r], key->rk_bytes[r], 1);
+        for (int j = 0; j < 8; j++) key->rk_slice[r][j] = _GCM_REP16(key->rk_slice[r][j]);
+    }
+
+    // H = E(0^128)，连同位反转形式供可移植 GHASH 使用
+    uint8_t h[16] = {0};
+    _gcm_soft_block(key, h, h);
+    key->h[0] = _gcm_be64(h); key->h[1] = _gcm_be64(h + 8);
+    key->h_rev[0] = _gcm_rev64(key->h[0]); key->h_rev[1] = _gcm_rev64(key->h[1]);
+
+    // H^2..H^4 用可移植乘法求出，HW 引擎以字节反序形式加载
+    uint8_t pw[16];
+    memcpy(pw, h, 16);
+    for (int i = 0; i < 4; i++) {
+        if (i) _gcm_soft_mult(key, pw);
+        for (int b = 0; b < 16; b++) key->h_pow[i][b] = pw[15 - b];
+    }
+}
+
+// --- 5. 流式消息处理 ---
+
+void edge_gcm_start(edge_gcm_t *g, const edge_gcm_key_t *key, const uint8_t iv[EDGE_GCM_IV_SIZE]) {
+    if (!g_gcm_ready) edge_gcm_init();
+    memset(g, 0, sizeof(*g));
+    g->key = key;
+    memcpy(g->j0, iv, EDGE_GCM_IV_SIZE);
+    g->j0[15] = 1;
+    memcpy(g->ctr, g->j0, 16);
+    _gcm_inc32(g->ctr);
+    g->ks_used = 16;
+}
+
+// 把 len 字节计入 GHASH：先补齐上次残留的半块，整块直接交给引擎，余数留待下次
+static void _gcm_absorb(edge_gcm_t *g, const uint8_t *p, size_t len) {
+    if (g->part_len) {
+        size_t take = 16u - g->part_len;
+        if (take > len) take = len;
+        memcpy(g->part + g->part_len, p, take);
+        g->part_len = (uint8_t)(g->part_len + take);
+        p += take; len -= take;
+        if (g->part_len < 16) return;
+        g_gcm_ops->ghash(g->key, g->y, g->part, 1);
+        g->part_len = 0;
+    }
+    size_t n = len / 16;
+    if (n) g_gcm_ops->ghash(g->key, g->y, p, n);
+    p += n * 16; len -= n * 16;
+    if (len) {
+        memcpy(g->part, p, len);
+        g->part_len = (uint8_t)len;
+    }
+}
+
+static void _gcm_pad(edge_gcm_t *g) {
+    if (!g->part_len) return;
+    memset(g->part + g->part_len, 0, 16u - g->part_len);
+    g_gcm_ops->ghash(g->key, g->y, g->part, 1);
+    g->part_len = 0;
+}
+
+void edge_gcm_aad(edge_gcm_t *g, const void *aad, size_t len) {
+    if (g->in_text || !len) return;
+    g->aad_len += len;
+    _gcm_absorb(g, (const uint8_t *)aad, len);
+}
+
+// 残余密钥流逐字节异或；GHASH 吸收的始终是密文 (加密时在异或之后，解密时在之前)
+static void _gcm_xor_stream(edge_gcm_t *g, uint8_t *p, size_t len, bool decrypt) {
+    if (decrypt) _gcm_absorb(g, p, len);
+    for (size_t i = 0; i < len; i++) p[i] ^= g->ks[g->ks_used++];
+    if (!decrypt) _gcm_absorb(g, p, len);
+}
+
+/*
+ * 密钥流与 GHASH 的对齐不变式：ks_used < 16 时恰为 text_len % 16，
+ * 因此用完残余密钥流后 part_len 必为 0，后续整块可直接走引擎批量路径。
+ * 批量部分按 1 KiB 分片先 CTR 后 GHASH (解密反之)，两遍都命中 L1。
+ */
+static void _gcm_crypt(edge_gcm_t *g, uint8_t *p, size_t len, bool decrypt) {
+    if (!g->in_text) {
+        _gcm_pad(g);
+        g->in_text = true;
+    }
+    g->text_len += len;
+
+    if (g->ks_used < 16) {
+        size_t n = 16u - g->ks_used;
+        if (n > len) n = len;
+        _gcm_xor_stream(g, p, n, decrypt);
+        p += n; len -= n;
+    }
+    while (len >= 16) {
+        size_t n = len / 16;
+        if (n > 64) n = 64;
+        if (decrypt) g_gcm_ops->ghash(g->key, g->y, p, n);
+        g_gcm_ops->ctr(g->key, g->ctr, p, n);
+        if (!decrypt) g_gcm_ops->ghash(g->key, g->y, p, n);
+        p += n * 16; len -= n * 16;
+    }
+    if (len) {
+        g_gcm_ops->block(g->key, g->ctr, g->ks);
+        _gcm_inc32(g->ctr);
+        g->ks_used = 0;
+        _gcm_xor_stream(g, p, len, decrypt);
+    }
+}
+
+void edge_gcm_encrypt(edge_gcm_t *g, void *data, size_t len) {
+    _gcm_crypt(g, (uint8_t *)data, len, false);
+}
+
+void edge_gcm_decrypt(edge_gcm_t *g, void *data, size_t len) {
+    _gcm_crypt(g, (uint8_t *)data, len, true);
+}
+
+void edge_gcm_finish(edge_gcm_t *g, uint8_t tag[16]) {
+    _gcm_pad(g);
+    uint8_t lens[16];
+    _gcm_put_be64(lens, g->aad_len * 8);
+    _gcm_put_be64(lens + 8, g->text_len * 8);
+    g_gcm_ops->ghash(g->key, g->y, lens, 1);
+    g_gcm_ops->block(g->key, g->j0, tag);
+    _gcm_xor16(tag, g->y);
+}
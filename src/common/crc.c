@@ -1,38 +1,292 @@
 #include "common/crc.h"
+#include <string.h>
 
-uint16_t edge_crc16_ccitt(const uint8_t *data, size_t length) {
-    uint16_t crc = 0xFFFF;
-    for (size_t i = 0; i < length; i++) {
-        uint8_t b = data[i];
-        for (int j = 0; j < 8; j++) {
-            if ((crc ^ b) & 0x0001) crc = (uint16_t)((crc >> 1) ^ 0x8408);
-            else crc >>= 1;
-            b >>= 1;
-        }
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EDGE_CRC_HAVE_CLMUL_X86 1
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define EDGE_CRC_HAVE_PMULL 1
+#endif
+
+/**
+ * @brief 反射型 CRC-16 模型
+ * 三种协议 CRC 均为 LSB-first (反射) 形式，仅多项式/初值/结果异或不同，
+ * 因此共用同一套查表与折叠实现。
+ */
+typedef struct {
+    uint16_t poly;          // 反射多项式 (0x8408 / 0xA001 / 0xA6BC)
+    uint16_t table[8][256]; // slice-by-8 表，table[0] 即经典单字节表
+    uint64_t fold[8];       // PCLMUL/PMULL 折叠常数 (见 _crc_build_fold)
+} _crc16_model_t;
+
+typedef uint16_t (*_crc16_fn)(const _crc16_model_t *m, uint16_t crc, const uint8_t *p, size_t len);
+
+static _crc16_model_t g_ccitt = { .poly = 0x8408 };
+static _crc16_model_t g_modbus = { .poly = 0xA001 };
+static _crc16_model_t g_dnp3 = { .poly = 0xA6BC };
+
+static volatile bool g_ready = false;
+static edge_crc_engine_t g_engine = EDGE_CRC_ENGINE_BITWISE;
+static _crc16_fn g_fn;
+
+// --- 1. 参考实现 (逐位) ---
+
+static uint16_t _crc16_bitwise(const _crc16_model_t *m, uint16_t crc, const uint8_t *p, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= p[i];
+        for (int j = 0; j < 8; j++) crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ m->poly) : (uint16_t)(crc >> 1);
     }
-    return (uint16_t)(crc ^ 0xFFFF);
+    return crc;
 }
 
-uint16_t edge_crc16_modbus_update(uint16_t crc, const void *data_ptr, size_t length) {
-    const uint8_t *data = (const uint8_t *)data_ptr;
-    for (size_t i = 0; i < length; i++) {
-        crc ^= (uint16_t)data[i];
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x0001) { crc >>= 1; crc ^= 0xA001; }
-            else crc >>= 1;
-        }
+// --- 2. 查表实现 (slice-by-4 / slice-by-8) ---
+
+static inline uint16_t _crc16_byte(const _crc16_model_t *m, uint16_t crc, uint8_t b) {
+    return (uint16_t)((crc >> 8) ^ m->table[0][(crc ^ b) & 0xFF]);
+}
+
+static uint16_t _crc16_slice4(const _crc16_model_t *m, uint16_t crc, const uint8_t *p, size_t len) {
+    const uint16_t (*t)[256] = m->table;
+    while (len >= 4) {
+        crc = (uint16_t)(t[3][(crc ^ p[0]) & 0xFF] ^ t[2][((crc >> 8) ^ p[1]) & 0xFF] ^
+                         t[1][p[2]] ^ t[0][p[3]]);
+        p += 4; len -= 4;
     }
+    while (len--) crc = _crc16_byte(m, crc, *p++);
     return crc;
 }
 
-uint16_t edge_crc16_dnp3(const uint8_t *data, size_t length) {
-    uint16_t crc = 0x0000;
-    for (size_t i = 0; i < length; i++) {
-        crc ^= (uint16_t)data[i];
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x0001) crc = (uint16_t)((crc >> 1) ^ 0xA6BC);
-            else crc >>= 1;
+static uint16_t _crc16_slice8(const _crc16_model_t *m, uint16_t crc, const uint8_t *p, size_t len) {
+    const uint16_t (*t)[256] = m->table;
+    while (len >= 8) {
+        crc = (uint16_t)(t[7][(crc ^ p[0]) & 0xFF] ^ t[6][((crc >> 8) ^ p[1]) & 0xFF] ^
+                         t[5][p[2]] ^ t[4][p[3]] ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]]);
+        p += 8; len -= 8;
+    }
+    while (len--) crc = _crc16_byte(m, crc, *p++);
+    return crc;
+}
+
+// --- 3. 无进位乘法折叠 (PCLMULQDQ / PMULL) ---
+
+/*
+ * 反射域下 16 字节块按小端装入 128 位寄存器后，bit i 对应 x^(127-i)。
+ * 两个 64 位反射操作数做 clmul 会多出一个 x 因子，所以折叠 A*x^n 时
+ * 使用常数 x^(n-1) mod P 的 64 位反射形式。每对常数依次作用于低/高 64 位：
+ *   fold[0..1]: 跨 512 位 (4 路并行主循环)
+ *   fold[2..3]: 跨 384 位, fold[4..5]: 跨 256 位, fold[6..7]: 跨 128 位
+ * 折叠结束后余下的 16 字节与尾部交给查表实现收尾，省去 Barrett 归约。
+ */
+static uint16_t _crc_xpow_mod(uint16_t poly_normal, unsigned n) {
+    uint32_t r = 1;
+    while (n--) {
+        r <<= 1;
+        if (r & 0x10000) r ^= 0x10000u | poly_normal;
+    }
+    return (uint16_t)r;
+}
+
+static uint64_t _crc_fold_const(uint16_t poly_normal, unsigned n) {
+    uint16_t k = _crc_xpow_mod(poly_normal, n - 1);
+    uint64_t field = 0;
+    for (int t = 0; t < 16; t++) if (k & (1u << t)) field |= 1ULL << (63 - t);
+    return field;
+}
+
+static void _crc_build_fold(_crc16_model_t *m) {
+    uint16_t normal = 0;
+    for (int i = 0; i < 16; i++) if (m->poly & (1u << i)) normal |= (uint16_t)(1u << (15 - i));
+    static const unsigned span[4] = { 512, 384, 256, 128 };
+    for (int i = 0; i < 4; i++) {
+        m->fold[2 * i] = _crc_fold_const(normal, span[i] + 64);
+        m->fold[2 * i + 1] = _crc_fold_const(normal, span[i]);
+    }
+}
+
+#if defined(EDGE_CRC_HAVE_CLMUL_X86)
+__attribute__((target("pclmul,sse2")))
+static inline __m128i _crc_fold128(__m128i x, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+__attribute__((target("pclmul,sse2")))
+static uint16_t _crc16_clmul(const _crc16_model_t *m, uint16_t crc, const uint8_t *p, size_t len) {
+    if (len < 64) return _crc16_slice8(m, crc, p, len);
+
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), _mm_cvtsi32_si128(crc));
+    __m128i x1 = _mm_loadu_si128((const __m128i *)(p + 16));
+    __m128i x2 = _mm_loadu_si128((const __m128i *)(p + 32));
+    __m128i x3 = _mm_loadu_si128((const __m128i *)(p + 48));
+    p += 64; len -= 64;
+
+    __m128i k = _mm_set_epi64x((long long)m->fold[1], (long long)m->fold[0]);
+    while (len >= 64) {
+        x0 = _mm_xor_si128(_crc_fold128(x0, k), _mm_loadu_si128((const __m128i *)p));
+        x1 = _mm_xor_si128(_crc_fold128(x1, k), _mm_loadu_si128((const __m128i *)(p + 16)));
+        x2 = _mm_xor_si128(_crc_fold128(x2, k), _mm_loadu_si128((const __m128i *)(p + 32)));
+        x3 = _mm_xor_si128(_crc_fold128(x3, k), _mm_loadu_si128((const __m128i *)(p + 48)));
+        p += 64; len -= 64;
+    }
+
+    __m128i x = _mm_xor_si128(x3, _crc_fold128(x0, _mm_set_epi64x((long long)m->fold[3], (long long)m->fold[2])));
+    x = _mm_xor_si128(x, _crc_fold128(x1, _mm_set_epi64x((long long)m->fold[5], (long long)m->fold[4])));
+    k = _mm_set_epi64x((long long)m->fold[7], (long long)m->fold[6]);
+    x = _mm_xor_si128(x, _crc_fold128(x2, k));
+    while (len >= 16) {
+        x = _mm_xor_si128(_crc_fold128(x, k), _mm_loadu_si128((const __m128i *)p));
+        p += 16; len -= 16;
+    }
+
+    uint8_t rest[16];
+    _mm_storeu_si128((__m128i *)rest, x);
+    return _crc16_slice8(m, _crc16_slice8(m, 0, rest, 16), p, len);
+}
+
+static bool _crc_cpu_has_clmul(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse2");
+}
+#elif defined(EDGE_CRC_HAVE_PMULL)
+__attribute__((target("+crypto")))
+static inline uint64x2_t _crc_fold128(uint64x2_t x, const uint64_t *k) {
+    uint64x2_t lo = vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(x, 0), (poly64_t)k[0]));
+    uint64x2_t hi = vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(x, 1), (poly64_t)k[1]));
+    return veorq_u64(lo, hi);
+}
+
+__attribute__((target("+crypto")))
+static uint16_t _crc16_clmul(const _crc16_model_t *m, uint16_t crc, const uint8_t *p, size_t len) {
+    if (len < 64) return _crc16_slice8(m, crc, p, len);
+
+    uint64x2_t x0 = veorq_u64(vreinterpretq_u64_u8(vld1q_u8(p)), vsetq_lane_u64(crc, vdupq_n_u64(0), 0));
+    uint64x2_t x1 = vreinterpretq_u64_u8(vld1q_u8(p + 16));
+    uint64x2_t x2 = vreinterpretq_u64_u8(vld1q_u8(p + 32));
+    uint64x2_t x3 = vreinterpretq_u64_u8(vld1q_u8(p + 48));
+    p += 64; len -= 64;
+
+    while (len >= 64) {
+        x0 = veorq_u64(_crc_fold128(x0, &m->fold[0]), vreinterpretq_u64_u8(vld1q_u8(p)));
+        x1 = veorq_u64(_crc_fold128(x1, &m->fold[0]), vreinterpretq_u64_u8(vld1q_u8(p + 16)));
+        x2 = veorq_u64(_crc_fold128(x2, &m->fold[0]), vreinterpretq_u64_u8(vld1q_u8(p + 32)));
+        x3 = veorq_u64(_crc_fold128(x3, &m->fold[0]), vreinterpretq_u64_u8(vld1q_u8(p + 48)));
+        p += 64; len -= 64;
+    }
+
+    uint64x2_t x = veorq_u64(x3, _crc_fold128(x0, &m->fold[2]));
+    x = veorq_u64(x, _crc_fold128(x1, &m->fold[4]));
+    x = veorq_u64(x, _crc_fold128(x2, &m->fold[6]));
+    while (len >= 16) {
+        x = veorq_u64(_crc_fold128(x, &m->fold[6]), vreinterpretq_u64_u8(vld1q_u8(p)));
+        p += 16; len -= 16;
+    }
+
+    uint8_t rest[16];
+    vst1q_u8(rest, vreinterpretq_u8_u64(x));
+    return _crc16_slice8(m, _crc16_slice8(m, 0, rest, 16), p, len);
+}
+
+static bool _crc_cpu_has_clmul(void) {
+    return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+}
+#else
+static bool _crc_cpu_has_clmul(void) { return false; }
+#define _crc16_clmul _crc16_slice8
+#endif
+
+// --- 4. 初始化与运行时分发 ---
+
+static void _crc_build_model(_crc16_model_t *m) {
+    for (int n = 0; n < 256; n++) m->table[0][n] = _crc16_bitwise(m, 0, &(uint8_t){ (uint8_t)n }, 1);
+    for (int k = 1; k < 8; k++) {
+        for (int n = 0; n < 256; n++) {
+            uint16_t prev = m->table[k - 1][n];
+            m->table[k][n] = (uint16_t)((prev >> 8) ^ m->table[0][prev & 0xFF]);
         }
     }
-    return (uint16_t)(crc ^ 0xFFFF);
+    _crc_build_fold(m);
+}
+
+static _crc16_fn _crc_engine_fn(edge_crc_engine_t engine) {
+    switch (engine) {
+        case EDGE_CRC_ENGINE_BITWISE: return _crc16_bitwise;
+        case EDGE_CRC_ENGINE_SLICE4:  return _crc16_slice4;
+        case EDGE_CRC_ENGINE_SLICE8:  return _crc16_slice8;
+        case EDGE_CRC_ENGINE_CLMUL:   return _crc16_clmul;
+        default: return NULL;
+    }
+}
+
+__attribute__((constructor))
+void edge_crc_init(void) {
+    if (g_ready) return;
+    _crc_build_model(&g_ccitt);
+    _crc_build_model(&g_modbus);
+    _crc_build_model(&g_dnp3);
+    g_engine = _crc_cpu_has_clmul() ? EDGE_CRC_ENGINE_CLMUL : EDGE_CRC_ENGINE_SLICE8;
+    g_fn = _crc_engine_fn(g_engine);
+    g_ready = true;
+}
+
+bool edge_crc_engine_supported(edge_crc_engine_t engine) {
+    if (engine == EDGE_CRC_ENGINE_CLMUL) return _crc_cpu_has_clmul();
+    return engine == EDGE_CRC_ENGINE_AUTO || _crc_engine_fn(engine) != NULL;
+}
+
+edge_crc_engine_t edge_crc_get_engine(void) {
+    if (!g_ready) edge_crc_init();
+    return g_engine;
+}
+
+bool edge_crc_set_engine(edge_crc_engine_t engine) {
+    if (!g_ready) edge_crc_init();
+    if (engine == EDGE_CRC_ENGINE_AUTO) engine = _crc_cpu_has_clmul() ? EDGE_CRC_ENGINE_CLMUL : EDGE_CRC_ENGINE_SLICE8;
+    if (!edge_crc_engine_supported(engine)) return false;
+    g_engine = engine;
+    g_fn = _crc_engine_fn(engine);
+    return true;
+}
+
+const char *edge_crc_engine_name(edge_crc_engine_t engine) {
+    switch (engine) {
+        case EDGE_CRC_ENGINE_AUTO:    return "auto";
+        case EDGE_CRC_ENGINE_BITWISE: return "bitwise";
+        case EDGE_CRC_ENGINE_SLICE4:  return "slice4";
+        case EDGE_CRC_ENGINE_SLICE8:  return "slice8";
+        case EDGE_CRC_ENGINE_CLMUL:   return "clmul";
+    }
+    return "unknown";
+}
+
+static inline uint16_t _crc16_run(const _crc16_model_t *m, uint16_t crc, const void *data, size_t len) {
+    if (!g_ready) edge_crc_init();
+    return g_fn(m, crc, (const uint8_t *)data, len);
+}
+
+// --- 5. 协议 CRC 入口 ---
+
+uint16_t edge_crc16_ccitt(const uint8_t *data, size_t length) {
+    return (uint16_t)(_crc16_run(&g_ccitt, 0xFFFF, data, length) ^ 0xFFFF);
+}
+
+uint16_t edge_crc16_ccitt_update(uint16_t crc, const void *data_ptr, size_t length) {
+    return _crc16_run(&g_ccitt, crc, data_ptr, length);
+}
+
+uint16_t edge_crc16_modbus(const uint8_t *data, size_t length) {
+    return _crc16_run(&g_modbus, 0xFFFF, data, length);
+}
+
+uint16_t edge_crc16_modbus_update(uint16_t crc, const void *data_ptr, size_t length) {
+    return _crc16_run(&g_modbus, crc, data_ptr, length);
+}
+
+uint16_t edge_crc16_dnp3(const uint8_t *data, size_t length) {
+    return (uint16_t)(_crc16_run(&g_dnp3, 0x0000, data, length) ^ 0xFFFF);
+}
+
+uint16_t edge_crc16_dnp3_update(uint16_t crc, const void *data_ptr, size_t length) {
+    return _crc16_run(&g_dnp3, crc, data_ptr, length);
 }
@@ -3,15 +3,45 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief CRC 计算引擎
+ * 启动时按 CPU 特性自动选择 (PCLMULQDQ/PMULL 可用时为 CLMUL，否则 SLICE8)，
+ * 所有引擎结果逐位一致。
+ */
+typedef enum {
+    EDGE_CRC_ENGINE_AUTO = 0,
+    EDGE_CRC_ENGINE_BITWISE,
+    EDGE_CRC_ENGINE_SLICE4,
+    EDGE_CRC_ENGINE_SLICE8,
+    EDGE_CRC_ENGINE_CLMUL,
+} edge_crc_engine_t;
+
+/**
+ * @brief 构建查表/折叠常数并选择引擎 (GCC/Clang 下由构造函数自动调用，可重复调用)
+ */
+void edge_crc_init(void);
+bool edge_crc_engine_supported(edge_crc_engine_t engine);
+edge_crc_engine_t edge_crc_get_engine(void);
+bool edge_crc_set_engine(edge_crc_engine_t engine);
+const char *edge_crc_engine_name(edge_crc_engine_t engine);
+
 uint16_t edge_crc16_modbus(const uint8_t *data, size_t length);
 uint16_t edge_crc16_modbus_update(uint16_t crc, const void *data_ptr, size_t length);
 uint16_t edge_crc16_ccitt(const uint8_t *data, size_t length);
 
+/**
+ * @brief 续算接口：输入/输出均为未做结果异或的原始寄存器值
+ * CCITT 初值 0xFFFF、DNP3 初值 0x0000，最终结果需再异或 0xFFFF。
+ */
+uint16_t edge_crc16_ccitt_update(uint16_t crc, const void *data_ptr, size_t length);
+uint16_t edge_crc16_dnp3_update(uint16_t crc, const void *data_ptr, size_t length);
+
 /**
  * @brief DNP3 专用反射 CRC-16
  */
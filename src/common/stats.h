@@ -0,0 +1,21 @@
+#ifndef LIBEDGE_STATS_H
+#define LIBEDGE_STATS_H
+
+#include "edge_core.h"
+
+/**
+ * @brief 库内部埋点宏：ctx 为含 stats 成员的上下文指针 (可为 NULL)
+ * EDGE_ENABLE_STATS 为 0 时全部展开为空，不产生任何代码与存储。
+ */
+#if EDGE_ENABLE_STATS
+#define EDGE_STATS_BEGIN(t0) uint64_t t0 = edge_stats_now_ns()
+#define EDGE_STATS_END(ctx, ok_id, err, t0) \
+    edge_stats_record((ctx) ? &(ctx)->stats : NULL, (ok_id), (err), edge_stats_now_ns() - (t0))
+#define EDGE_STATS_ADD(ctx, id, n) edge_stats_add((ctx) ? &(ctx)->stats : NULL, (id), (n))
+#else
+#define EDGE_STATS_BEGIN(t0)
+#define EDGE_STATS_END(ctx, ok_id, err, t0) ((void)0)
+#define EDGE_STATS_ADD(ctx, id, n) ((void)0)
+#endif
+
+#endif
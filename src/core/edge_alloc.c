@@ -0,0 +1,87 @@
+#include "edge_core.h"
+#include <string.h>
+#ifndef EDGE_NO_MALLOC
+#include <stdlib.h>
+#endif
+
+#ifdef EDGE_NO_MALLOC
+static void *_sys_alloc(void *user, size_t size) { (void)user; (void)size; return NULL; }
+static void _sys_free(void *user, void *ptr, size_t size) { (void)user; (void)ptr; (void)size; }
+#else
+static void *_sys_alloc(void *user, size_t size) { (void)user; return malloc(size); }
+static void _sys_free(void *user, void *ptr, size_t size) { (void)user; (void)size; free(ptr); }
+#endif
+
+static const edge_allocator_t g_sys_allocator = { _sys_alloc, _sys_free, NULL };
+static const edge_allocator_t *g_default = &g_sys_allocator;
+
+void edge_allocator_set_default(const edge_allocator_t *a) {
+    g_default = a ? a : &g_sys_allocator;
+}
+
+const edge_allocator_t *edge_allocator_default(void) {
+    return g_default;
+}
+
+void *edge_alloc(const edge_allocator_t *a, size_t size) {
+    if (!a) a = g_default;
+    return size ? a->alloc(a->user, size) : NULL;
+}
+
+void edge_free(const edge_allocator_t *a, void *ptr, size_t size) {
+    if (!ptr) return;
+    if (!a) a = g_default;
+    a->free(a->user, ptr, size);
+}
+
+/* --- 定长块池 --- */
+
+static void *_pool_alloc(void *user, size_t size) {
+    edge_pool_t *p = (edge_pool_t *)user;
+    if (size > p->block_size || !p->free_list) return NULL;
+    void *blk = p->free_list;
+    memcpy(&p->free_list, blk, sizeof(void *));
+    return blk;
+}
+
+static void _pool_free(void *user, void *ptr, size_t size) {
+    (void)size;
+    edge_pool_t *p = (edge_pool_t *)user;
+    memcpy(ptr, &p->free_list, sizeof(void *));
+    p->free_list = ptr;
+}
+
+void edge_pool_init(edge_pool_t *p, void *buf, size_t block_size, uint32_t block_count) {
+    if (!p) return;
+    p->base.alloc = _pool_alloc;
+    p->base.free = _pool_free;
+    p->base.user = p;
+    // 块大小按 16 字节取整，保证每块对齐且能容纳链表指针
+    block_size = (block_size < sizeof(void *)) ? sizeof(void *) : block_size;
+    block_size = (block_size + 15u) & ~(size_t)15u;
+    p->pool = (uint8_t *)buf;
+    p->block_size = block_size;
+    p->block_count = buf ? block_count : 0;
+    p->free_list = NULL;
+    for (uint32_t i = p->block_count; i > 0; i--) _pool_free(p, p->pool + (size_t)(i - 1) * block_size, 0);
+}
+
+/* --- arena 分配器 --- */
+
+static void *_arena_alloc(void *user, size_t size) {
+    edge_arena_allocator_t *a = (edge_arena_allocator_t *)user;
+    size_t got;
+    return a->arena ? a->arena->grow(a->arena, (size + 15u) & ~(size_t)15u, &got) : NULL;
+}
+
+static void _arena_free(void *user, void *ptr, size_t size) {
+    (void)user; (void)ptr; (void)size;
+}
+
+void edge_arena_allocator_init(edge_arena_allocator_t *a, edge_arena_t *arena) {
+    if (!a) return;
+    a->base.alloc = _arena_alloc;
+    a->base.free = _arena_free;
+    a->base.user = a;
+    a->arena = arena;
+}
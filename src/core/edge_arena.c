@@ -0,0 +1,61 @@
+#include "edge_core.h"
+#include <string.h>
+
+static uint8_t *_bump_grow(edge_arena_t *a, size_t min_len, size_t *out_len) {
+    edge_arena_bump_t *b = (edge_arena_bump_t *)a;
+    size_t avail = b->size - b->used;
+    if (min_len == 0 || avail < min_len) return NULL;
+    size_t n = (min_len < EDGE_ARENA_CHUNK) ? EDGE_ARENA_CHUNK : min_len;
+    if (n > avail) n = avail;
+    uint8_t *p = b->buf + b->used;
+    b->used += n;
+    *out_len = n;
+    return p;
+}
+
+static void _bump_reset(edge_arena_t *a) { ((edge_arena_bump_t *)a)->used = 0; }
+
+void edge_arena_bump_init(edge_arena_bump_t *a, void *buf, size_t size) {
+    if (!a) return;
+    a->base.grow = _bump_grow;
+    a->base.reset = _bump_reset;
+    a->buf = (uint8_t *)buf;
+    a->size = buf ? size : 0;
+    a->used = 0;
+}
+
+static uint8_t *_slab_grow(edge_arena_t *a, size_t min_len, size_t *out_len) {
+    edge_arena_slab_t *s = (edge_arena_slab_t *)a;
+    if (min_len == 0 || min_len > s->slab_size || s->next >= s->slab_count) return NULL;
+    uint8_t *p = s->pool + (size_t)s->next++ * s->slab_size;
+    *out_len = s->slab_size;
+    return p;
+}
+
+static void _slab_reset(edge_arena_t *a) { ((edge_arena_slab_t *)a)->next = 0; }
+
+void edge_arena_slab_init(edge_arena_slab_t *a, void *pool, size_t slab_size, uint32_t slab_count) {
+    if (!a) return;
+    a->base.grow = _slab_grow;
+    a->base.reset = _slab_reset;
+    a->pool = (uint8_t *)pool;
+    a->slab_size = slab_size;
+    a->slab_count = pool ? slab_count : 0;
+    a->next = 0;
+}
+
+static _Thread_local uint8_t g_thread_buf[EDGE_ARENA_THREAD_SIZE];
+static _Thread_local edge_arena_bump_t g_thread_arena;
+
+edge_arena_t* edge_arena_thread(void) {
+    if (!g_thread_arena.base.grow) edge_arena_bump_init(&g_thread_arena, g_thread_buf, sizeof(g_thread_buf));
+    return &g_thread_arena.base;
+}
+
+void edge_arena_reset(edge_arena_t *a) {
+    if (a && a->reset) a->reset(a);
+}
+
+void edge_arena_thread_frame_begin(void) {
+    edge_arena_reset(edge_arena_thread());
+}
@@ -0,0 +1,87 @@
+#include "edge_core.h"
+#include "common/crc.h"
+
+uint16_t edge_check_init(edge_check_kind_t kind) {
+    return (kind == EDGE_CHECK_CRC16_CCITT || kind == EDGE_CHECK_CRC16_MODBUS) ? 0xFFFF : 0x0000;
+}
+
+uint16_t edge_check_update(edge_check_kind_t kind, uint16_t state, const void *data, size_t len) {
+    switch (kind) {
+        case EDGE_CHECK_CRC16_CCITT:  return edge_crc16_ccitt_update(state, data, len);
+        case EDGE_CHECK_CRC16_MODBUS: return edge_crc16_modbus_update(state, data, len);
+        case EDGE_CHECK_CRC16_DNP3:   return edge_crc16_dnp3_update(state, data, len);
+        case EDGE_CHECK_SUM8: {
+            const uint8_t *p = (const uint8_t *)data;
+            uint8_t cs = (uint8_t)state;
+            for (size_t i = 0; i < len; i++) cs = (uint8_t)(cs + p[i]);
+            return cs;
+        }
+    }
+    return state;
+}
+
+uint16_t edge_check_final(edge_check_kind_t kind, uint16_t state) {
+    switch (kind) {
+        case EDGE_CHECK_CRC16_CCITT:
+        case EDGE_CHECK_CRC16_DNP3:   return (uint16_t)(state ^ 0xFFFF);
+        case EDGE_CHECK_SUM8:         return (uint16_t)(state & 0xFF);
+        default:                      return state;
+    }
+}
+
+edge_error_t edge_vector_checksum(const edge_vector_t *v, edge_check_kind_t kind, size_t offset, size_t len, uint16_t *out) {
+    if (!v || !out) return EP_ERR_INVALID_ARG;
+    if (offset > v->total_len || len > v->total_len - offset) return EP_ERR_OUT_OF_BOUNDS;
+    uint16_t st = edge_check_init(kind);
+    size_t pos = 0;
+    for (int i = 0; i < v->used_count && len > 0; i++) {
+        size_t seg = v->iovs[i].iov_len;
+        if (offset < pos + seg) {
+            size_t skip = offset > pos ? offset - pos : 0;
+            size_t n = (seg - skip < len) ? seg - skip : len;
+            st = edge_check_update(kind, st, (const uint8_t *)v->iovs[i].iov_base + skip, n);
+            len -= n;
+        }
+        pos += seg;
+    }
+    *out = edge_check_final(kind, st);
+    return EP_OK;
+}
+
+edge_error_t edge_cursor_checksum(const edge_cursor_t *c, edge_check_kind_t kind, size_t len, uint16_t *out) {
+    if (!c || !out) return EP_ERR_INVALID_ARG;
+    if (edge_cursor_remaining(c) < len) return EP_ERR_INCOMPLETE_DATA;
+    uint16_t st = edge_check_init(kind);
+    size_t off = c->current_offset;
+    for (int i = c->current_iov; i < c->count && len > 0; i++) {
+        size_t n = c->iovs[i].iov_len - off;
+        if (n > len) n = len;
+        st = edge_check_update(kind, st, (const uint8_t *)c->iovs[i].iov_base + off, n);
+        len -= n; off = 0;
+    }
+    *out = edge_check_final(kind, st);
+    return EP_OK;
+}
+
+void edge_vector_check_begin(edge_vector_t *v, edge_check_kind_t kind) {
+    if (!v) return;
+    v->check_kind = kind;
+    v->check_state = edge_check_init(kind);
+    v->check_start = v->total_len;
+    v->check_active = true;
+    v->check_dirty = false;
+}
+
+uint16_t edge_vector_check_value(edge_vector_t *v) {
+    if (!v || !v->check_active) return 0;
+    if (v->check_dirty) {
+        uint16_t val = 0;
+        edge_vector_checksum(v, v->check_kind, v->check_start, v->total_len - v->check_start, &val);
+        return val;
+    }
+    return edge_check_final(v->check_kind, v->check_state);
+}
+
+void edge_vector_check_end(edge_vector_t *v) {
+    if (v) v->check_active = false;
+}
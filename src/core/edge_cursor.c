@@ -1,30 +1,21 @@
 #include "edge_core.h"
 #include <string.h>
-#include <arpa/inet.h>
 
 void edge_cursor_init(edge_cursor_t *c, const struct iovec *iovs, int count) {
     if (!c || !iovs) return;
     c->iovs = iovs; c->count = count;
     c->current_iov = 0; c->current_offset = 0; c->total_read = 0;
-}
-
-size_t edge_cursor_remaining(const edge_cursor_t *c) {
-    if (!c || c->current_iov >= c->count) return 0;
-    size_t rem = c->iovs[c->current_iov].iov_len - c->current_offset;
-    for (int i = c->current_iov + 1; i < c->count; i++) rem += c->iovs[i].iov_len;
-    return rem;
+    c->total_len = 0;
+    for (int i = 0; i < count; i++) c->total_len += iovs[i].iov_len;
 }
 
 const void* edge_cursor_get_ptr(edge_cursor_t *c, size_t len) {
-    if (!c || len == 0 || c->current_iov >= c->count) return NULL;
-    size_t avail = c->iovs[c->current_iov].iov_len - c->current_offset;
-    if (avail >= len) {
-        const void *ptr = (const uint8_t*)c->iovs[c->current_iov].iov_base + c->current_offset;
-        c->current_offset += len; c->total_read += len;
-        if (c->current_offset >= c->iovs[c->current_iov].iov_len) { c->current_iov++; c->current_offset = 0; }
-        return ptr;
+    if (!c || len == 0) return NULL;
+    // 跳过已耗尽/空的 iovec 段，使 get_ptr 与内联快速路径行为一致
+    while (c->current_iov < c->count && c->current_offset >= c->iovs[c->current_iov].iov_len) {
+        c->current_iov++; c->current_offset = 0;
     }
-    return NULL;
+    return _edge_cursor_fast(c, len);
 }
 
 edge_error_t edge_cursor_read_bytes(edge_cursor_t *c, uint8_t *buf, size_t len) {
@@ -36,20 +27,48 @@ edge_error_t edge_cursor_read_bytes(edge_cursor_t *c, uint8_t *buf, size_t len)
     while (copied < len) {
         size_t avail = c->iovs[c->current_iov].iov_len - c->current_offset;
         size_t to_copy = (len - copied < avail) ? (len - copied) : avail;
-        memcpy(buf + copied, (const uint8_t*)c->iovs[c->current_iov].iov_base + c->current_offset, to_copy);
+        if (to_copy) memcpy(buf + copied, (const uint8_t*)c->iovs[c->current_iov].iov_base + c->current_offset, to_copy);
         c->current_offset += to_copy; copied += to_copy; c->total_read += to_copy;
         if (c->current_offset >= c->iovs[c->current_iov].iov_len) { c->current_iov++; c->current_offset = 0; }
     }
     return EP_OK;
 }
 
-edge_error_t edge_cursor_read_u8(edge_cursor_t *c, uint8_t *val) { return edge_cursor_read_bytes(c, val, 1); }
-edge_error_t edge_cursor_read_be16(edge_cursor_t *c, uint16_t *val) {
-    uint16_t raw; EP_ASSERT_OK(edge_cursor_read_bytes(c, (uint8_t*)&raw, 2)); *val = be16toh(raw); return EP_OK;
+edge_error_t edge_cursor_skip(edge_cursor_t *c, size_t len) {
+    if (!c) return EP_ERR_INVALID_ARG;
+    if (edge_cursor_remaining(c) < len) return EP_ERR_INCOMPLETE_DATA;
+    while (len > 0) {
+        size_t avail = c->iovs[c->current_iov].iov_len - c->current_offset;
+        size_t n = (len < avail) ? len : avail;
+        c->current_offset += n; c->total_read += n; len -= n;
+        if (c->current_offset >= c->iovs[c->current_iov].iov_len) { c->current_iov++; c->current_offset = 0; }
+    }
+    return EP_OK;
 }
-edge_error_t edge_cursor_read_le16(edge_cursor_t *c, uint16_t *val) {
-    uint16_t raw; EP_ASSERT_OK(edge_cursor_read_bytes(c, (uint8_t*)&raw, 2)); *val = le16toh(raw); return EP_OK;
+
+edge_error_t edge_cursor_slice(edge_cursor_t *c, size_t len, edge_cursor_t *sub) {
+    if (!c || !sub) return EP_ERR_INVALID_ARG;
+    if (edge_cursor_remaining(c) < len) return EP_ERR_INCOMPLETE_DATA;
+    sub->iovs = c->iovs; sub->count = c->count;
+    sub->current_iov = c->current_iov; sub->current_offset = c->current_offset;
+    sub->total_read = 0; sub->total_len = len;
+    return edge_cursor_skip(c, len);
 }
-edge_error_t edge_cursor_read_be32(edge_cursor_t *c, uint32_t *val) {
-    uint32_t raw; EP_ASSERT_OK(edge_cursor_read_bytes(c, (uint8_t*)&raw, 4)); *val = be32toh(raw); return EP_OK;
+
+edge_error_t edge_cursor_slice_iov(edge_cursor_t *c, size_t len, struct iovec *out, int max, int *out_count) {
+    if (!c || !out || !out_count) return EP_ERR_INVALID_ARG;
+    if (edge_cursor_remaining(c) < len) return EP_ERR_INCOMPLETE_DATA;
+    int n = 0;
+    size_t off = c->current_offset, rem = len;
+    for (int i = c->current_iov; rem > 0; i++) {
+        size_t avail = c->iovs[i].iov_len - off;
+        if (avail == 0) { off = 0; continue; }
+        if (n >= max) return EP_ERR_BUFFER_TOO_SMALL;
+        size_t take = (rem < avail) ? rem : avail;
+        out[n].iov_base = (uint8_t *)c->iovs[i].iov_base + off;
+        out[n].iov_len = take;
+        n++; rem -= take; off = 0;
+    }
+    *out_count = n;
+    return edge_cursor_skip(c, len);
 }
@@ -0,0 +1,134 @@
+#include "edge_core.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief 段内查找双字节模式 b0 b1，返回首字节下标；未找到返回 n
+ * 只报告完全位于段内的匹配 (i + 1 < n)，跨段匹配由调用方处理。
+ */
+typedef size_t (*_scan2_fn)(const uint8_t *p, size_t n, uint8_t b0, uint8_t b1);
+
+static size_t _scan2_scalar(const uint8_t *p, size_t n, uint8_t b0, uint8_t b1) {
+    size_t i = 0;
+    while (i + 1 < n) {
+        const uint8_t *hit = memchr(p + i, b0, n - 1 - i);
+        if (!hit) break;
+        i = (size_t)(hit - p);
+        if (p[i + 1] == b1) return i;
+        i++;
+    }
+    return n;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+static size_t _scan2_sse2(const uint8_t *p, size_t n, uint8_t b0, uint8_t b1) {
+    size_t i = 0;
+    const __m128i v0 = _mm_set1_epi8((char)b0), v1 = _mm_set1_epi8((char)b1);
+    for (; i + 17 <= n; i += 16) {
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i)), v0);
+        __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i + 1)), v1);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(a, b));
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    size_t r = _scan2_scalar(p + i, n - i, b0, b1);
+    return (r == n - i) ? n : i + r;
+}
+
+__attribute__((target("avx2")))
+static size_t _scan2_avx2(const uint8_t *p, size_t n, uint8_t b0, uint8_t b1) {
+    size_t i = 0;
+    const __m256i v0 = _mm256_set1_epi8((char)b0), v1 = _mm256_set1_epi8((char)b1);
+    for (; i + 33 <= n; i += 32) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + i)), v0);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + i + 1)), v1);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    size_t r = _scan2_sse2(p + i, n - i, b0, b1);
+    return (r == n - i) ? n : i + r;
+}
+
+static _scan2_fn _scan2_select(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? _scan2_avx2 : _scan2_sse2;
+}
+#elif defined(__aarch64__)
+static size_t _scan2_neon(const uint8_t *p, size_t n, uint8_t b0, uint8_t b1) {
+    size_t i = 0;
+    const uint8x16_t v0 = vdupq_n_u8(b0), v1 = vdupq_n_u8(b1);
+    for (; i + 17 <= n; i += 16) {
+        uint8x16_t m = vandq_u8(vceqq_u8(vld1q_u8(p + i), v0), vceqq_u8(vld1q_u8(p + i + 1), v1));
+        // 每字节压缩为 4 位掩码
+        uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+        if (bits) return i + (size_t)(__builtin_ctzll(bits) >> 2);
+    }
+    size_t r = _scan2_scalar(p + i, n - i, b0, b1);
+    return (r == n - i) ? n : i + r;
+}
+
+static _scan2_fn _scan2_select(void) { return _scan2_neon; }
+#else
+static _scan2_fn _scan2_select(void) { return _scan2_scalar; }
+#endif
+
+static _scan2_fn g_scan2;
+
+/**
+ * @brief 在当前段内前进 n 字节 (调用方保证 n 不超过段内余量)
+ */
+static void _cursor_advance(edge_cursor_t *c, size_t n) {
+    c->current_offset += n; c->total_read += n;
+    if (c->current_offset >= c->iovs[c->current_iov].iov_len) { c->current_iov++; c->current_offset = 0; }
+}
+
+/**
+ * @brief 下一个非空段的首字节
+ */
+static bool _next_first_byte(const edge_cursor_t *c, uint8_t *out) {
+    for (int i = c->current_iov + 1; i < c->count; i++) {
+        if (c->iovs[i].iov_len) { *out = *(const uint8_t *)c->iovs[i].iov_base; return true; }
+    }
+    return false;
+}
+
+edge_error_t edge_cursor_scan(edge_cursor_t *c, const uint8_t *pattern, size_t plen, size_t *skipped) {
+    if (!c || !pattern || plen == 0 || plen > 2) return EP_ERR_INVALID_ARG;
+    if (plen == 2 && !g_scan2) g_scan2 = _scan2_select();
+
+    size_t start = c->total_read;
+    edge_error_t ret = EP_ERR_INCOMPLETE_DATA;
+    while (c->current_iov < c->count && edge_cursor_remaining(c) > 0) {
+        const struct iovec *iov = &c->iovs[c->current_iov];
+        size_t n = iov->iov_len - c->current_offset;
+        if (n == 0) { c->current_iov++; c->current_offset = 0; continue; }
+        if (n > edge_cursor_remaining(c)) n = edge_cursor_remaining(c); // 子 cursor 边界
+        const uint8_t *p = (const uint8_t *)iov->iov_base + c->current_offset;
+
+        if (plen == 1) {
+            const uint8_t *hit = memchr(p, pattern[0], n);
+            if (hit) { _cursor_advance(c, (size_t)(hit - p)); ret = EP_OK; break; }
+        } else {
+            size_t idx = g_scan2(p, n, pattern[0], pattern[1]);
+            if (idx < n) { _cursor_advance(c, idx); ret = EP_OK; break; }
+            if (p[n - 1] == pattern[0]) {
+                uint8_t next;
+                bool more = edge_cursor_remaining(c) > n && _next_first_byte(c, &next);
+                if (!more || next == pattern[1]) {
+                    // 跨段匹配，或数据末尾可能的模式首字节：停在该字节
+                    _cursor_advance(c, n - 1);
+                    if (more) ret = EP_OK;
+                    break;
+                }
+            }
+        }
+        _cursor_advance(c, n);
+    }
+    if (skipped) *skipped = c->total_read - start;
+    return ret;
+}
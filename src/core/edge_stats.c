@@ -0,0 +1,84 @@
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "edge_core.h"
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
+
+static uint64_t _default_clock(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+static uint64_t (*g_stats_clock)(void) = _default_clock;
+
+void edge_stats_set_clock(uint64_t (*now_ns)(void)) {
+    g_stats_clock = now_ns ? now_ns : _default_clock;
+}
+
+uint64_t edge_stats_now_ns(void) {
+    return g_stats_clock();
+}
+
+void edge_stats_snapshot(const edge_stats_t *s, edge_stats_t *out) {
+    if (!s || !out) return;
+    uint32_t seq;
+    do {
+        // 写者进行中 (奇数) 或读取期间序号变化则重读
+        while ((seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE)) & 1u) { }
+        for (int i = 0; i < EDGE_STAT_COUNT; i++) out->counters[i] = __atomic_load_n(&s->counters[i], __ATOMIC_RELAXED);
+        for (int i = 0; i < EDGE_STATS_HIST_BUCKETS; i++) out->hist[i] = __atomic_load_n(&s->hist[i], __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&s->seq, __ATOMIC_RELAXED) != seq);
+    out->seq = seq;
+}
+
+void edge_stats_reset(edge_stats_t *s) {
+    if (!s) return;
+    edge_stats_write_begin(s);
+    for (int i = 0; i < EDGE_STAT_COUNT; i++) __atomic_store_n(&s->counters[i], 0, __ATOMIC_RELAXED);
+    for (int i = 0; i < EDGE_STATS_HIST_BUCKETS; i++) __atomic_store_n(&s->hist[i], 0, __ATOMIC_RELAXED);
+    edge_stats_write_end(s);
+}
+
+/**
+ * @brief 分桶 idx 覆盖的最大时延值 (edge_stats_bucket 的逆)
+ */
+static uint64_t _bucket_upper(int idx) {
+    if (idx < (1 << EDGE_STATS_SUB_BITS)) return (uint64_t)idx;
+    int msb = (idx >> EDGE_STATS_SUB_BITS) + EDGE_STATS_SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(idx & ((1 << EDGE_STATS_SUB_BITS) - 1));
+    uint64_t step = 1ull << (msb - EDGE_STATS_SUB_BITS);
+    return (((1ull << EDGE_STATS_SUB_BITS) + sub) * step) + step - 1;
+}
+
+uint64_t edge_stats_percentile(const edge_stats_t *snap, double q) {
+    if (!snap) return 0;
+    uint64_t total = 0;
+    for (int i = 0; i < EDGE_STATS_HIST_BUCKETS; i++) total += snap->hist[i];
+    if (total == 0) return 0;
+    if (q < 0) q = 0;
+    if (q > 1) q = 1;
+    uint64_t rank = (uint64_t)(q * (double)(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < EDGE_STATS_HIST_BUCKETS; i++) {
+        seen += snap->hist[i];
+        if (seen >= rank) return _bucket_upper(i);
+    }
+    return _bucket_upper(EDGE_STATS_HIST_BUCKETS - 1);
+}
+
+const char *edge_stat_name(edge_stat_id_t id) {
+    static const char *const names[EDGE_STAT_COUNT] = {
+        "frames_rx", "frames_tx", "checksum_errors", "frame_errors",
+        "resync_bytes", "scratch_overflows", "block_restarts", "window_stalls",
+    };
+    return (id >= 0 && id < EDGE_STAT_COUNT) ? names[id] : "unknown";
+}
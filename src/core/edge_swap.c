@@ -0,0 +1,157 @@
+#include "edge_core.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief 数组字节序翻转内核：n 为元素个数，dst 可与 src 相同 (原地翻转)，均无需对齐
+ */
+typedef void (*_swap_fn)(uint8_t *dst, const uint8_t *src, size_t n);
+
+static void _swap16_scalar(uint8_t *dst, const uint8_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint16_t x; memcpy(&x, src + 2 * i, 2);
+        x = __builtin_bswap16(x); memcpy(dst + 2 * i, &x, 2);
+    }
+}
+
+static void _swap32_scalar(uint8_t *dst, const uint8_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t x; memcpy(&x, src + 4 * i, 4);
+        x = __builtin_bswap32(x); memcpy(dst + 4 * i, &x, 4);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+static const int8_t k_shuf16[32] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                     1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+static const int8_t k_shuf32[32] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                     3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+
+__attribute__((target("ssse3")))
+static void _swap_ssse3(uint8_t *dst, const uint8_t *src, size_t bytes, const int8_t *mask) {
+    const __m128i m = _mm_loadu_si128((const __m128i *)mask);
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + i)), m));
+    }
+}
+
+__attribute__((target("avx2")))
+static void _swap_avx2(uint8_t *dst, const uint8_t *src, size_t bytes, const int8_t *mask) {
+    const __m256i m = _mm256_loadu_si256((const __m256i *)mask);
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(src + i)), m));
+    }
+    _swap_ssse3(dst + i, src + i, bytes - i, mask);
+}
+
+__attribute__((target("ssse3")))
+static void _swap16_ssse3(uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t v = n & ~(size_t)7;
+    _swap_ssse3(dst, src, v * 2, k_shuf16);
+    _swap16_scalar(dst + v * 2, src + v * 2, n - v);
+}
+
+__attribute__((target("ssse3")))
+static void _swap32_ssse3(uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t v = n & ~(size_t)3;
+    _swap_ssse3(dst, src, v * 4, k_shuf32);
+    _swap32_scalar(dst + v * 4, src + v * 4, n - v);
+}
+
+__attribute__((target("avx2")))
+static void _swap16_avx2(uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t v = n & ~(size_t)7;
+    _swap_avx2(dst, src, v * 2, k_shuf16);
+    _swap16_scalar(dst + v * 2, src + v * 2, n - v);
+}
+
+__attribute__((target("avx2")))
+static void _swap32_avx2(uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t v = n & ~(size_t)3;
+    _swap_avx2(dst, src, v * 4, k_shuf32);
+    _swap32_scalar(dst + v * 4, src + v * 4, n - v);
+}
+
+static void _swap_select(_swap_fn *s16, _swap_fn *s32) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { *s16 = _swap16_avx2; *s32 = _swap32_avx2; }
+    else if (__builtin_cpu_supports("ssse3")) { *s16 = _swap16_ssse3; *s32 = _swap32_ssse3; }
+    else { *s16 = _swap16_scalar; *s32 = _swap32_scalar; }
+}
+#elif defined(__aarch64__)
+static void _swap16_neon(uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) vst1q_u8(dst + 2 * i, vrev16q_u8(vld1q_u8(src + 2 * i)));
+    _swap16_scalar(dst + 2 * i, src + 2 * i, n - i);
+}
+
+static void _swap32_neon(uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) vst1q_u8(dst + 4 * i, vrev32q_u8(vld1q_u8(src + 4 * i)));
+    _swap32_scalar(dst + 4 * i, src + 4 * i, n - i);
+}
+
+static void _swap_select(_swap_fn *s16, _swap_fn *s32) { *s16 = _swap16_neon; *s32 = _swap32_neon; }
+#else
+static void _swap_select(_swap_fn *s16, _swap_fn *s32) { *s16 = _swap16_scalar; *s32 = _swap32_scalar; }
+#endif
+
+static _swap_fn g_swap16, g_swap32;
+
+void edge_bswap16_array(void *dst, const void *src, size_t n) {
+    if (!g_swap16) _swap_select(&g_swap16, &g_swap32);
+    g_swap16((uint8_t *)dst, (const uint8_t *)src, n);
+}
+
+void edge_bswap32_array(void *dst, const void *src, size_t n) {
+    if (!g_swap32) _swap_select(&g_swap16, &g_swap32);
+    g_swap32((uint8_t *)dst, (const uint8_t *)src, n);
+}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define _HOST_IS_BE false
+#else
+#define _HOST_IS_BE true
+#endif
+
+/**
+ * @brief 按元素宽度读取数组：段内整元素批量翻转，跨段元素经临时缓冲
+ */
+static edge_error_t _read_array(edge_cursor_t *c, void *out, size_t n, size_t width, bool wire_be) {
+    if (!c || (!out && n)) return EP_ERR_INVALID_ARG;
+    if (edge_cursor_remaining(c) / width < n) return EP_ERR_INCOMPLETE_DATA;
+    bool swap = (wire_be != _HOST_IS_BE);
+    uint8_t *dst = (uint8_t *)out;
+    while (n > 0) {
+        const struct iovec *iov = &c->iovs[c->current_iov];
+        size_t k = (iov->iov_len - c->current_offset) / width;
+        if (k > n) k = n;
+        const uint8_t *src;
+        uint8_t tmp[4];
+        if (k > 0) {
+            src = (const uint8_t *)iov->iov_base + c->current_offset;
+            EP_ASSERT_OK(edge_cursor_skip(c, k * width));
+        } else {
+            // 元素跨段 (或当前段已耗尽)：单个元素走通用路径
+            EP_ASSERT_OK(edge_cursor_read_bytes(c, tmp, width));
+            src = tmp; k = 1;
+        }
+        if (!swap) memcpy(dst, src, k * width);
+        else if (width == 2) edge_bswap16_array(dst, src, k);
+        else edge_bswap32_array(dst, src, k);
+        dst += k * width; n -= k;
+    }
+    return EP_OK;
+}
+
+edge_error_t edge_cursor_read_be16_array(edge_cursor_t *c, uint16_t *out, size_t n) { return _read_array(c, out, n, 2, true); }
+edge_error_t edge_cursor_read_le16_array(edge_cursor_t *c, uint16_t *out, size_t n) { return _read_array(c, out, n, 2, false); }
+edge_error_t edge_cursor_read_be32_array(edge_cursor_t *c, uint32_t *out, size_t n) { return _read_array(c, out, n, 4, true); }
+edge_error_t edge_cursor_read_le32_array(edge_cursor_t *c, uint32_t *out, size_t n) { return _read_array(c, out, n, 4, false); }
@@ -0,0 +1,127 @@
+#include "edge_core.h"
+#include <string.h>
+
+static size_t _check_width(edge_check_kind_t kind) { return kind == EDGE_CHECK_SUM8 ? 1 : 2; }
+
+static bool _covers(const edge_template_check_t *k, size_t pos) {
+    return pos >= k->start && pos < (size_t)k->start + k->len;
+}
+
+void edge_template_init(edge_frame_template_t *t, void *buf, size_t cap) {
+    if (!t) return;
+    memset(t, 0, sizeof(*t));
+    t->buf = (uint8_t *)buf; t->cap = cap;
+}
+
+edge_error_t edge_template_capture(edge_frame_template_t *t, const edge_vector_t *v) {
+    if (!t || !t->buf) return EP_ERR_INVALID_ARG;
+    t->field_count = 0; t->check_count = 0; t->var_count = 0;
+    return edge_vector_flatten(v, t->buf, t->cap, &t->len);
+}
+
+/**
+ * @brief 计算可变字节 pos 各位对校验 k 的贡献：以 0 为初值 (CRC 线性部分) 处理单比特后补零至区间末尾
+ */
+static void _build_contrib(edge_frame_template_t *t, int k, int vi) {
+    static const uint8_t zeros[64];
+    const edge_template_check_t *ck = &t->checks[k];
+    size_t pos = t->var_pos[vi];
+    if (ck->kind == EDGE_CHECK_SUM8 || !_covers(ck, pos)) return;
+    size_t tail = (size_t)ck->start + ck->len - pos - 1;
+    for (int b = 0; b < 8; b++) {
+        uint8_t bit = (uint8_t)(1u << b);
+        uint16_t st = edge_check_update(ck->kind, 0, &bit, 1);
+        for (size_t z = tail; z > 0; ) {
+            size_t n = z < sizeof(zeros) ? z : sizeof(zeros);
+            st = edge_check_update(ck->kind, st, zeros, n);
+            z -= n;
+        }
+        t->contrib[k][vi][b] = st;
+    }
+}
+
+static edge_error_t _add_var_bytes(edge_frame_template_t *t, size_t offset, size_t width, uint8_t *base) {
+    if (t->var_count + (int)width > EDGE_TEMPLATE_MAX_VAR_BYTES) return EP_ERR_OVERFLOW;
+    *base = (uint8_t)t->var_count;
+    for (size_t i = 0; i < width; i++) {
+        int vi = t->var_count++;
+        t->var_pos[vi] = (uint16_t)(offset + i);
+        for (int k = 0; k < t->check_count; k++) _build_contrib(t, k, vi);
+    }
+    return EP_OK;
+}
+
+edge_error_t edge_template_add_field(edge_frame_template_t *t, size_t offset, size_t width, bool big_endian) {
+    if (!t || (width != 1 && width != 2 && width != 4) || offset + width > t->len) return EP_ERR_INVALID_ARG;
+    if (t->field_count >= EDGE_TEMPLATE_MAX_FIELDS) return EP_ERR_OVERFLOW;
+    edge_template_field_t *f = &t->fields[t->field_count];
+    EP_ASSERT_OK(_add_var_bytes(t, offset, width, &f->var_base));
+    f->offset = (uint16_t)offset; f->width = (uint8_t)width; f->big_endian = big_endian;
+    t->field_count++;
+    return EP_OK;
+}
+
+edge_error_t edge_template_add_check(edge_frame_template_t *t, edge_check_kind_t kind, size_t start, size_t len, size_t at) {
+    if (!t || start + len > t->len || at + _check_width(kind) > t->len) return EP_ERR_INVALID_ARG;
+    if (at < start + len && at + _check_width(kind) > start) return EP_ERR_INVALID_ARG;
+    if (t->check_count >= EDGE_TEMPLATE_MAX_CHECKS) return EP_ERR_OVERFLOW;
+    for (int k = 0; k < t->check_count; k++) {
+        if (_covers(&t->checks[k], at) || _covers(&t->checks[k], at + _check_width(kind) - 1)) return EP_ERR_INVALID_ARG;
+    }
+    int k = t->check_count;
+    edge_template_check_t *ck = &t->checks[k];
+    ck->kind = kind; ck->start = (uint16_t)start; ck->len = (uint16_t)len; ck->at = (uint16_t)at;
+    t->check_count++;
+    for (int vi = 0; vi < t->var_count; vi++) _build_contrib(t, k, vi);
+    if (_add_var_bytes(t, at, _check_width(kind), &ck->var_base) != EP_OK) { t->check_count--; return EP_ERR_OVERFLOW; }
+
+    uint16_t val = edge_check_final(kind, edge_check_update(kind, edge_check_init(kind), t->buf + start, len));
+    t->buf[at] = (uint8_t)val;
+    if (kind != EDGE_CHECK_SUM8) t->buf[at + 1] = (uint8_t)(val >> 8);
+    return EP_OK;
+}
+
+/**
+ * @brief 写入一个可变字节，并把变化量累加到覆盖它的各校验
+ */
+static void _put_var(edge_frame_template_t *t, int vi, uint8_t nb, uint16_t *dcrc, uint8_t *dsum) {
+    size_t pos = t->var_pos[vi];
+    uint8_t ob = t->buf[pos];
+    if (ob == nb) return;
+    t->buf[pos] = nb;
+    uint8_t d = (uint8_t)(ob ^ nb);
+    for (int k = 0; k < t->check_count; k++) {
+        const edge_template_check_t *ck = &t->checks[k];
+        if (!_covers(ck, pos)) continue;
+        if (ck->kind == EDGE_CHECK_SUM8) { dsum[k] = (uint8_t)(dsum[k] + nb - ob); continue; }
+        for (int b = 0; b < 8; b++) if (d & (1u << b)) dcrc[k] ^= t->contrib[k][vi][b];
+    }
+}
+
+edge_error_t edge_template_set(edge_frame_template_t *t, int idx, uint32_t value) {
+    if (!t || idx < 0 || idx >= t->field_count) return EP_ERR_INVALID_ARG;
+    const edge_template_field_t *f = &t->fields[idx];
+    uint16_t dcrc[EDGE_TEMPLATE_MAX_CHECKS] = {0};
+    uint8_t dsum[EDGE_TEMPLATE_MAX_CHECKS] = {0};
+    for (int i = 0; i < f->width; i++) {
+        int shift = f->big_endian ? 8 * (f->width - 1 - i) : 8 * i;
+        _put_var(t, f->var_base + i, (uint8_t)(value >> shift), dcrc, dsum);
+    }
+    // 按声明顺序修正校验值；其输出字节的变化继续传递给后声明的校验
+    for (int k = 0; k < t->check_count; k++) {
+        const edge_template_check_t *ck = &t->checks[k];
+        if (ck->kind == EDGE_CHECK_SUM8) {
+            if (dsum[k]) _put_var(t, ck->var_base, (uint8_t)(t->buf[ck->at] + dsum[k]), dcrc, dsum);
+        } else if (dcrc[k]) {
+            uint16_t val = (uint16_t)((t->buf[ck->at] | (t->buf[ck->at + 1] << 8)) ^ dcrc[k]);
+            _put_var(t, ck->var_base, (uint8_t)val, dcrc, dsum);
+            _put_var(t, ck->var_base + 1, (uint8_t)(val >> 8), dcrc, dsum);
+        }
+    }
+    return EP_OK;
+}
+
+edge_error_t edge_template_emit(const edge_frame_template_t *t, edge_vector_t *v) {
+    if (!t || !t->buf || t->len == 0) return EP_ERR_INVALID_ARG;
+    return edge_vector_append_ref(v, t->buf, t->len);
+}
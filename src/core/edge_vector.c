@@ -2,36 +2,114 @@
 #include <string.h>
 #include <arpa/inet.h>
 
-void edge_vector_init(edge_vector_t *v, struct iovec *iovs, int max_capacity) {
+void edge_vector_init_arena(edge_vector_t *v, struct iovec *iovs, int max_capacity, edge_arena_t *arena) {
     if (!v || !iovs) return;
     v->iovs = iovs; v->max_capacity = max_capacity;
-    v->used_count = 0; v->total_len = 0; v->scratch_used = 0;
+    v->used_count = 0; v->total_len = 0;
+    v->scratch = NULL; v->scratch_used = 0; v->scratch_size = 0;
+    v->arena = arena;
     v->last_was_scratch = false;
+    v->check_active = false; v->check_dirty = false;
+    v->offsets = NULL; v->hint_idx = 0; v->hint_base = 0;
+}
+
+void edge_vector_init(edge_vector_t *v, struct iovec *iovs, int max_capacity) {
+#if EDGE_VECTOR_SCRATCH_SIZE > 0
+    edge_vector_init_arena(v, iovs, max_capacity, NULL);
+    if (v && iovs) { v->scratch = v->inline_scratch; v->scratch_size = EDGE_VECTOR_SCRATCH_SIZE; }
+#else
+    edge_vector_init_arena(v, iovs, max_capacity, edge_arena_thread());
+#endif
+}
+
+void edge_vector_attach_index(edge_vector_t *v, size_t *offsets) {
+    if (!v) return;
+    v->offsets = offsets;
+    if (!offsets) return;
+    size_t base = 0;
+    for (int i = 0; i < v->used_count; i++) { offsets[i] = base; base += v->iovs[i].iov_len; }
 }
 
 size_t edge_vector_length(const edge_vector_t *v) { return v ? v->total_len : 0; }
 
+/**
+ * @brief 定位 offset 所在段 (调用方保证 offset < total_len)
+ */
+static int _vector_locate(const edge_vector_t *v, size_t offset, size_t *seg_base) {
+    if (v->offsets) {
+        int lo = 0, hi = v->used_count - 1;
+        while (lo < hi) {
+            int mid = lo + (hi - lo + 1) / 2;
+            if (v->offsets[mid] <= offset) lo = mid; else hi = mid - 1;
+        }
+        *seg_base = v->offsets[lo];
+        return lo;
+    }
+    // 头 / 缓存 / 尾 三个起点中取字节距离最近者，再双向行走
+    int i = 0; size_t base = 0, best = offset;
+    if (v->hint_idx < v->used_count) {
+        size_t d = (offset >= v->hint_base) ? offset - v->hint_base : v->hint_base - offset;
+        if (d < best) { i = v->hint_idx; base = v->hint_base; best = d; }
+    }
+    size_t tail_base = v->total_len - v->iovs[v->used_count - 1].iov_len;
+    if ((offset >= tail_base ? 0 : tail_base - offset) < best) { i = v->used_count - 1; base = tail_base; }
+    while (offset < base) { i--; base -= v->iovs[i].iov_len; }
+    while (offset >= base + v->iovs[i].iov_len) { base += v->iovs[i].iov_len; i++; }
+    *seg_base = base;
+    return i;
+}
+
 const uint8_t* edge_vector_get_ptr(const edge_vector_t *v, size_t offset) {
     if (!v || offset >= v->total_len) return NULL;
-    size_t current = 0;
-    for (int i = 0; i < v->used_count; i++) {
-        if (offset < current + v->iovs[i].iov_len) return (const uint8_t*)v->iovs[i].iov_base + (offset - current);
-        current += v->iovs[i].iov_len;
-    }
-    return NULL;
+    size_t base;
+    int i = _vector_locate(v, offset, &base);
+    return (const uint8_t*)v->iovs[i].iov_base + (offset - base);
 }
 
 /**
- * @brief [专家级 API] 修改已写入的数据 (用于长度回填)
+ * @brief [专家级 API] 修改已写入的数据 (用于长度回填，可跨段)
  */
 edge_error_t edge_vector_patch(edge_vector_t *v, size_t offset, const void *data, size_t len) {
-    if (!v || offset + len > v->total_len) return EP_ERR_OUT_OF_BOUNDS;
-    uint8_t *p = (uint8_t *)edge_vector_get_ptr(v, offset);
-    if (p) {
-        memcpy(p, data, len);
-        return EP_OK;
+    if (!v || !data || offset > v->total_len || len > v->total_len - offset) return EP_ERR_OUT_OF_BOUNDS;
+    if (len == 0) return EP_OK;
+    size_t base;
+    int i = _vector_locate(v, offset, &base);
+    v->hint_idx = i; v->hint_base = base;
+    size_t end = offset + len;
+    const uint8_t *src = (const uint8_t *)data;
+    size_t skip = offset - base;
+    while (len > 0) {
+        size_t n = v->iovs[i].iov_len - skip;
+        if (n > len) n = len;
+        memcpy((uint8_t *)v->iovs[i].iov_base + skip, src, n);
+        src += n; len -= n; skip = 0;
+        base += v->iovs[i].iov_len; i++;
     }
-    return EP_ERR_GENERIC;
+    if (v->check_active && end > v->check_start) v->check_dirty = true;
+    return EP_OK;
+}
+
+/**
+ * @brief 截回到 len 字节：丢弃尾部各段、截短跨界段；被丢弃数据占用的 scratch 不回收
+ */
+edge_error_t edge_vector_truncate(edge_vector_t *v, size_t len) {
+    if (!v || len > v->total_len) return EP_ERR_OUT_OF_BOUNDS;
+    if (len == v->total_len) return EP_OK;
+    while (v->used_count > 0 && v->total_len - v->iovs[v->used_count - 1].iov_len >= len) {
+        v->total_len -= v->iovs[--v->used_count].iov_len;
+    }
+    if (v->total_len > len) {
+        v->iovs[v->used_count - 1].iov_len -= v->total_len - len;
+        v->total_len = len;
+    }
+    // 保留段的尾部已不在 scratch 写位置，后续 put_* 必须另起一段
+    v->last_was_scratch = false;
+    v->hint_idx = 0; v->hint_base = 0;
+    if (v->check_active) {
+        if (v->check_start > len) v->check_start = len;
+        v->check_dirty = true;
+    }
+    return EP_OK;
 }
 
 edge_error_t edge_vector_append_ref(edge_vector_t *v, const void *ptr, size_t len) {
@@ -39,32 +117,195 @@ edge_error_t edge_vector_append_ref(edge_vector_t *v, const void *ptr, size_t le
     if (v->used_count >= v->max_capacity) return EP_ERR_BUFFER_TOO_SMALL;
     v->iovs[v->used_count].iov_base = (void *)ptr;
     v->iovs[v->used_count].iov_len = len;
+    if (v->offsets) v->offsets[v->used_count] = v->total_len;
     v->used_count++; v->total_len += len;
     v->last_was_scratch = false;
+    if (v->check_active) v->check_state = edge_check_update(v->check_kind, v->check_state, ptr, len);
+    return EP_OK;
+}
+
+/**
+ * @brief 保证 scratch 窗口剩余 len 字节 (不推进 scratch_used)
+ */
+static edge_error_t _vector_reserve(edge_vector_t *v, size_t len) {
+    if (v->scratch_used + len <= v->scratch_size) return EP_OK;
+    // 当前窗口不足：向 arena 申请新块；与窗口尾部相邻时直接扩展窗口
+    size_t got = 0;
+    uint8_t *blk = v->arena ? v->arena->grow(v->arena, len, &got) : NULL;
+    if (!blk) return EP_ERR_BUFFER_TOO_SMALL;
+    if (v->scratch && blk == v->scratch + v->scratch_size) {
+        v->scratch_size += got;
+    } else {
+        v->scratch = blk; v->scratch_used = 0; v->scratch_size = got;
+        v->last_was_scratch = false;
+    }
+    return EP_OK;
+}
+
+/**
+ * @brief 把已写入窗口尾部的 len 字节登记为数据 (与上一 scratch 段相邻时直接合并)
+ */
+static edge_error_t _vector_commit(edge_vector_t *v, size_t len) {
+    uint8_t *dest = &v->scratch[v->scratch_used];
+    if (v->last_was_scratch) {
+        v->iovs[v->used_count - 1].iov_len += len;
+    } else {
+        if (v->used_count >= v->max_capacity) return EP_ERR_BUFFER_TOO_SMALL;
+        v->iovs[v->used_count].iov_base = dest;
+        v->iovs[v->used_count].iov_len = len;
+        if (v->offsets) v->offsets[v->used_count] = v->total_len;
+        v->used_count++;
+        v->last_was_scratch = true;
+    }
+    v->scratch_used += len; v->total_len += len;
+    if (v->check_active) v->check_state = edge_check_update(v->check_kind, v->check_state, dest, len);
     return EP_OK;
 }
 
 edge_error_t edge_vector_append_copy(edge_vector_t *v, const void *data, size_t len) {
     if (!v || !data || len == 0) return EP_ERR_INVALID_ARG;
-    if (v->last_was_scratch && (v->scratch_used + len <= EDGE_VECTOR_SCRATCH_SIZE)) {
-        memcpy(&v->scratch[v->scratch_used], data, len);
-        v->iovs[v->used_count - 1].iov_len += len;
-        v->scratch_used += len; v->total_len += len;
+    if (_vector_reserve(v, len) != EP_OK) return EP_ERR_BUFFER_TOO_SMALL;
+    memcpy(&v->scratch[v->scratch_used], data, len);
+    return _vector_commit(v, len);
+}
+
+/**
+ * @brief 在帧首插入：数据拷入 scratch，段表整体后移一位 (O(段数)，不搬动载荷)
+ */
+edge_error_t edge_vector_prepend_copy(edge_vector_t *v, const void *data, size_t len) {
+    if (!v || !data || len == 0) return EP_ERR_INVALID_ARG;
+    if (v->check_active) return EP_ERR_INVALID_STATE;
+    if (v->used_count >= v->max_capacity) return EP_ERR_BUFFER_TOO_SMALL;
+    if (_vector_reserve(v, len) != EP_OK) return EP_ERR_BUFFER_TOO_SMALL;
+    uint8_t *dest = &v->scratch[v->scratch_used];
+    memcpy(dest, data, len);
+    memmove(&v->iovs[1], &v->iovs[0], (size_t)v->used_count * sizeof(v->iovs[0]));
+    v->iovs[0].iov_base = dest;
+    v->iovs[0].iov_len = len;
+    if (v->offsets) {
+        for (int i = v->used_count; i > 0; i--) v->offsets[i] = v->offsets[i - 1] + len;
+        v->offsets[0] = 0;
+    }
+    // 新段位于 scratch 尾部但不是最后一段，后续 put_* 不得与之合并
+    v->last_was_scratch = (v->used_count == 0);
+    v->used_count++;
+    v->scratch_used += len; v->total_len += len;
+    v->hint_idx = 0; v->hint_base = 0;
+    return EP_OK;
+}
+
+edge_error_t edge_vector_own_segment(edge_vector_t *v, int idx, uint8_t **out) {
+    if (!v || !out || idx < 0 || idx >= v->used_count) return EP_ERR_INVALID_ARG;
+    struct iovec *seg = &v->iovs[idx];
+    uintptr_t p = (uintptr_t)seg->iov_base, lo = (uintptr_t)v->scratch;
+    if (seg->iov_len == 0 || (v->scratch && p >= lo && p + seg->iov_len <= lo + v->scratch_used)) {
+        *out = (uint8_t *)seg->iov_base;
         return EP_OK;
     }
-    if (v->used_count >= v->max_capacity || v->scratch_used + len > EDGE_VECTOR_SCRATCH_SIZE) 
-        return EP_ERR_BUFFER_TOO_SMALL;
-    void *dest = &v->scratch[v->scratch_used];
-    memcpy(dest, data, len);
-    v->iovs[v->used_count].iov_base = dest;
-    v->iovs[v->used_count].iov_len = len;
-    v->used_count++; v->scratch_used += len; v->total_len += len;
-    v->last_was_scratch = true;
+    if (_vector_reserve(v, seg->iov_len) != EP_OK) return EP_ERR_BUFFER_TOO_SMALL;
+    uint8_t *dest = &v->scratch[v->scratch_used];
+    memcpy(dest, seg->iov_base, seg->iov_len);
+    seg->iov_base = dest;
+    v->scratch_used += seg->iov_len;
+    // 副本占据 scratch 尾部：仅当它就是最后一段时后续 put_* 才可与之合并
+    v->last_was_scratch = (idx == v->used_count - 1);
+    *out = dest;
     return EP_OK;
 }
 
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define _HOST_IS_BE false
+#else
+#define _HOST_IS_BE true
+#endif
+
+/**
+ * @brief 数组整体转换为线路字节序后直接写入 scratch 窗口 (单次拷贝)
+ */
+static edge_error_t _vector_put_array(edge_vector_t *v, const void *vals, size_t n, size_t width, bool wire_be) {
+    if (!v || !vals) return EP_ERR_INVALID_ARG;
+    if (n == 0) return EP_OK;
+    size_t len = n * width;
+    if (_vector_reserve(v, len) != EP_OK) return EP_ERR_BUFFER_TOO_SMALL;
+    uint8_t *dest = &v->scratch[v->scratch_used];
+    if (wire_be == _HOST_IS_BE) memcpy(dest, vals, len);
+    else if (width == 2) edge_bswap16_array(dest, vals, n);
+    else edge_bswap32_array(dest, vals, n);
+    return _vector_commit(v, len);
+}
+
+edge_error_t edge_vector_put_be16_array(edge_vector_t *v, const uint16_t *vals, size_t n) { return _vector_put_array(v, vals, n, 2, true); }
+edge_error_t edge_vector_put_le16_array(edge_vector_t *v, const uint16_t *vals, size_t n) { return _vector_put_array(v, vals, n, 2, false); }
+edge_error_t edge_vector_put_be32_array(edge_vector_t *v, const uint32_t *vals, size_t n) { return _vector_put_array(v, vals, n, 4, true); }
+edge_error_t edge_vector_put_le32_array(edge_vector_t *v, const uint32_t *vals, size_t n) { return _vector_put_array(v, vals, n, 4, false); }
+
 edge_error_t edge_vector_put_u8(edge_vector_t *v, uint8_t val) { return edge_vector_append_copy(v, &val, 1); }
 edge_error_t edge_vector_put_be16(edge_vector_t *v, uint16_t val) { uint16_t be = htobe16(val); return edge_vector_append_copy(v, &be, 2); }
 edge_error_t edge_vector_put_be32(edge_vector_t *v, uint32_t val) { uint32_t be = htobe32(val); return edge_vector_append_copy(v, &be, 4); }
 edge_error_t edge_vector_put_le16(edge_vector_t *v, uint16_t val) { uint16_t le = htole16(val); return edge_vector_append_copy(v, &le, 2); }
-edge_error_t edge_vector_put_le32(edge_vector_t *v, uint32_t val) { uint32_t le = htole32(val); return edge_vector_append_copy(v, &le, 4); }
\ No newline at end of file
+edge_error_t edge_vector_put_le32(edge_vector_t *v, uint32_t val) { uint32_t le = htole32(val); return edge_vector_append_copy(v, &le, 4); }
+/**
+ * @brief [专家级 API] 发送前按代价模型合并小段
+ * 连续的小段 (长度 < iov_cost) 拷入 scratch 合为一段，大段保持零拷贝；
+ * 合并后段数仍超过 max_iovs 时整帧压平。失败时向量保持原样。
+ */
+edge_error_t edge_vector_finalize(edge_vector_t *v, const edge_vector_cost_t *cost) {
+    static const edge_vector_cost_t k_default = EDGE_VECTOR_COST_DEFAULT;
+    if (!v) return EP_ERR_INVALID_ARG;
+    if (!cost) cost = &k_default;
+    int n = v->used_count;
+    if (n <= 1) return EP_OK;
+
+    // 第一遍：统计需要拷贝的字节数与合并后的段数
+    size_t need = 0; int out = 0;
+    for (int i = 0; i < n; ) {
+        int j = i;
+        size_t run = 0;
+        while (j < n && v->iovs[j].iov_len < cost->iov_cost) run += v->iovs[j++].iov_len;
+        if (j - i >= 2) { need += run; out++; i = j; }
+        else { out++; i = (j > i) ? j : i + 1; }
+    }
+    bool flat = cost->max_iovs > 0 && out > cost->max_iovs;
+    if (flat) need = v->total_len;
+    if (!flat && out == n) return EP_OK;
+    if (_vector_reserve(v, need) != EP_OK) return EP_ERR_BUFFER_TOO_SMALL;
+
+    // 第二遍：原地改写 iovec 表 (写位置不超过读位置)
+    int w = 0;
+    v->last_was_scratch = false;
+    for (int i = 0; i < n; ) {
+        int j = i;
+        if (flat) j = n;
+        else while (j < n && v->iovs[j].iov_len < cost->iov_cost) j++;
+        if (j - i < 2) { v->iovs[w++] = v->iovs[i]; i = (j > i) ? j : i + 1; continue; }
+        uint8_t *dst = &v->scratch[v->scratch_used];
+        size_t run = 0;
+        for (int k = i; k < j; k++) {
+            memcpy(dst + run, v->iovs[k].iov_base, v->iovs[k].iov_len);
+            run += v->iovs[k].iov_len;
+        }
+        v->scratch_used += run;
+        v->iovs[w].iov_base = dst; v->iovs[w].iov_len = run; w++;
+        v->last_was_scratch = (j == n);
+        i = j;
+    }
+    v->used_count = w;
+    v->hint_idx = 0; v->hint_base = 0;
+    if (v->offsets) edge_vector_attach_index(v, v->offsets);
+    return EP_OK;
+}
+
+/**
+ * @brief 整帧拷入调用方缓冲区 (供不支持 iovec 的串口驱动使用)
+ */
+edge_error_t edge_vector_flatten(const edge_vector_t *v, uint8_t *buf, size_t cap, size_t *out_len) {
+    if (!v || !buf) return EP_ERR_INVALID_ARG;
+    if (v->total_len > cap) return EP_ERR_BUFFER_TOO_SMALL;
+    size_t pos = 0;
+    for (int i = 0; i < v->used_count; i++) {
+        memcpy(buf + pos, v->iovs[i].iov_base, v->iovs[i].iov_len);
+        pos += v->iovs[i].iov_len;
+    }
+    if (out_len) *out_len = pos;
+    return EP_OK;
+}
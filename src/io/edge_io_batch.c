@@ -0,0 +1,91 @@
+#define _GNU_SOURCE
+#include "libedge/edge_io.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/socket.h>
+
+static void _fill_msg(struct msghdr *m, const edge_vector_t *v) {
+    memset(m, 0, sizeof(*m));
+    m->msg_iov = v->iovs;
+    m->msg_iovlen = (size_t)v->used_count;
+}
+
+/**
+ * @brief 标记同一 fd 上 [from, end) 的帧为未发送
+ */
+static void _abandon(edge_io_frame_t *frames, size_t from, size_t end, int err) {
+    for (size_t i = from; i < end; i++) frames[i].result = -err;
+}
+
+static bool _valid(const edge_io_frame_t *f) {
+    return f->v && f->v->used_count > 0;
+}
+
+/**
+ * @brief 逐帧 sendmsg 的退化路径
+ * @return true 表示该 fd 已受阻 (短写或 EAGAIN)，其余帧已标记未发送
+ */
+static bool _send_loop(edge_io_frame_t *frames, size_t i, size_t end, int flags) {
+    for (; i < end; i++) {
+        struct msghdr m; _fill_msg(&m, frames[i].v);
+        ssize_t n = sendmsg(frames[i].fd, &m, flags);
+        if (n < 0) {
+            frames[i].result = -errno;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) { _abandon(frames, i + 1, end, EAGAIN); return true; }
+            continue;
+        }
+        frames[i].result = n;
+        if ((size_t)n < frames[i].v->total_len) { _abandon(frames, i + 1, end, EAGAIN); return true; }
+    }
+    return false;
+}
+
+#ifdef EDGE_IO_HAVE_SENDMMSG
+static bool _send_group(edge_io_frame_t *frames, size_t i, size_t end, int flags) {
+    struct mmsghdr msgs[EDGE_IO_BATCH_MAX];
+    while (i < end) {
+        size_t batch = end - i;
+        if (batch > EDGE_IO_BATCH_MAX) batch = EDGE_IO_BATCH_MAX;
+        for (size_t k = 0; k < batch; k++) { _fill_msg(&msgs[k].msg_hdr, frames[i + k].v); msgs[k].msg_len = 0; }
+        int sent = sendmmsg(frames[i].fd, msgs, (unsigned int)batch, flags);
+        if (sent < 0) {
+            // 首帧即失败：ENOSYS 走逐帧路径，其余错误只归属首帧
+            if (errno == ENOSYS) return _send_loop(frames, i, end, flags);
+            frames[i].result = -errno;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) { _abandon(frames, i + 1, end, EAGAIN); return true; }
+            i++; continue;
+        }
+        for (size_t k = 0; k < (size_t)sent; k++) {
+            frames[i + k].result = (ssize_t)msgs[k].msg_len;
+            if (msgs[k].msg_len < frames[i + k].v->total_len) { _abandon(frames, i + k + 1, end, EAGAIN); return true; }
+        }
+        i += (size_t)sent;
+    }
+    return false;
+}
+#else
+#define _send_group _send_loop
+#endif
+
+size_t edge_io_send_batch(edge_io_frame_t *frames, size_t count, int flags) {
+    if (!frames) return 0;
+    for (size_t i = 0; i < count; ) {
+        size_t end = i + 1;
+        while (end < count && frames[end].fd == frames[i].fd) end++;
+        // 同一 fd 的连续帧：无效帧单独标记，其余按连续区段批量提交
+        for (size_t k = i; k < end; ) {
+            if (!_valid(&frames[k])) { frames[k].result = -EINVAL; k++; continue; }
+            size_t run = k + 1;
+            while (run < end && _valid(&frames[run])) run++;
+            if (_send_group(frames, k, run, flags)) { _abandon(frames, run, end, EAGAIN); break; }
+            k = run;
+        }
+        i = end;
+    }
+    size_t done = 0;
+    for (size_t k = 0; k < count; k++) {
+        if (_valid(&frames[k]) && frames[k].result >= 0 && (size_t)frames[k].result == frames[k].v->total_len) done++;
+    }
+    return done;
+}
@@ -0,0 +1,109 @@
+#define _GNU_SOURCE
+#include "libedge/edge_io.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief 创建 size 字节的匿名共享内存对象
+ */
+static int _shm_open(size_t size) {
+    int fd;
+#ifdef EDGE_IO_HAVE_MEMFD
+    fd = memfd_create("edge_stream", MFD_CLOEXEC);
+#else
+    char name[64];
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    snprintf(name, sizeof(name), "/edge_stream.%ld.%ld", (long)getpid(), (long)ts.tv_nsec);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) shm_unlink(name);
+#endif
+    if (fd < 0) return -errno;
+    if (ftruncate(fd, (off_t)size) != 0) {
+        int err = errno;
+        close(fd);
+        return -err;
+    }
+    return fd;
+}
+
+int edge_stream_init(edge_stream_t *s, size_t min_size) {
+    if (!s || min_size == 0) return -EINVAL;
+    memset(s, 0, sizeof(*s));
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = (min_size + page - 1) / page * page;
+
+    int fd = _shm_open(size);
+    if (fd < 0) return fd;
+
+    // 先保留 2*size 的连续地址，再把同一对象固定映射到前后两半
+    uint8_t *base = mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    int err = 0;
+    if (base == MAP_FAILED) {
+        err = errno;
+    } else if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+               mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        err = errno;
+        munmap(base, 2 * size);
+    }
+    close(fd);
+    if (err) return -err;
+
+    s->base = base;
+    s->size = size;
+    return 0;
+}
+
+void edge_stream_destroy(edge_stream_t *s) {
+    if (!s || !s->base) return;
+    munmap(s->base, 2 * s->size);
+    memset(s, 0, sizeof(*s));
+}
+
+uint8_t *edge_stream_write_ptr(edge_stream_t *s, size_t *avail) {
+    *avail = s->size - s->used;
+    return s->base + (s->head + s->used) % s->size;
+}
+
+void edge_stream_commit(edge_stream_t *s, size_t n) {
+    if (n > s->size - s->used) n = s->size - s->used;
+    s->used += n;
+}
+
+ssize_t edge_stream_recv(edge_stream_t *s, int fd, int flags) {
+    size_t avail;
+    uint8_t *p = edge_stream_write_ptr(s, &avail);
+    if (avail == 0) return -ENOBUFS;
+    ssize_t n = recv(fd, p, avail, flags);
+    if (n < 0) return -errno;
+    s->used += (size_t)n;
+    return n;
+}
+
+ssize_t edge_stream_read(edge_stream_t *s, int fd) {
+    size_t avail;
+    uint8_t *p = edge_stream_write_ptr(s, &avail);
+    if (avail == 0) return -ENOBUFS;
+    ssize_t n = read(fd, p, avail);
+    if (n < 0) return -errno;
+    s->used += (size_t)n;
+    return n;
+}
+
+void edge_stream_view(edge_stream_t *s, edge_cursor_t *c) {
+    s->view.iov_base = s->base + s->head;
+    s->view.iov_len = s->used;
+    edge_cursor_init(c, &s->view, 1);
+}
+
+void edge_stream_consume(edge_stream_t *s, size_t n) {
+    if (n > s->used) n = s->used;
+    s->head = (s->head + n) % s->size;
+    s->used -= n;
+}
@@ -1,4 +1,5 @@
 #include "protocols/edge_dlms.h"
+#include "common/stats.h"
 #include <string.h>
 
 /**
@@ -10,6 +11,10 @@ edge_error_t edge_dlms_manage_blocks(edge_dlms_context_t *ctx, const uint8_t *pd
     
     // 逻辑：识别 PDU 是否包含分块标志 (0x02)
     if (len > 2 && pdu[0] == DLMS_APDU_GET_RESPONSE && pdu[1] == 0x02) {
+        // 上一轮分块尚未收完又收到块号为 1 的分块响应：视为重新开始
+        if (ctx->block_ctx.active && len > 7 && pdu[4] == 0 && pdu[5] == 0 && pdu[6] == 0 && pdu[7] == 1) {
+            EDGE_STATS_ADD(ctx, EDGE_STAT_BLOCK_RESTARTS, 1);
+        }
         ctx->block_ctx.active = true;
         // 提取 last-block 标志
         bool is_last = (pdu[2] != 0);
@@ -31,4 +36,126 @@ edge_error_t edge_dlms_build_get_response(edge_dlms_context_t *ctx, edge_vector_
     }
     
     return EP_OK;
-}
\ No newline at end of file
+}
+// --- 客户端分块重组 ---
+
+static edge_error_t _blockrx_read_len(edge_cursor_t *c, size_t *n) {
+    uint8_t b;
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &b));
+    if (b < 0x80) { *n = b; return EP_OK; }
+    if (b == 0x81) { EP_ASSERT_OK(edge_cursor_read_u8(c, &b)); *n = b; return EP_OK; }
+    if (b == 0x82) { uint16_t w; EP_ASSERT_OK(edge_cursor_read_be16(c, &w)); *n = w; return EP_OK; }
+    return EP_ERR_INVALID_FRAME;
+}
+
+/**
+ * @brief 块数据拷入新申请的缓冲区并挂到链尾 (接收缓冲区随后会被下一帧复用)
+ */
+static edge_error_t _blockrx_append(edge_dlms_block_rx_t *rx, edge_cursor_t *c, size_t len) {
+    if (len == 0) return EP_OK;
+    if (rx->chain_count == rx->chain_cap) return EP_ERR_BUFFER_TOO_SMALL;
+    uint8_t *buf = edge_alloc(rx->allocator, len);
+    if (!buf) return EP_ERR_OVERFLOW;
+    edge_error_t err = edge_cursor_read_bytes(c, buf, len);
+    if (err != EP_OK) { edge_free(rx->allocator, buf, len); return err; }
+    rx->chain[rx->chain_count].iov_base = buf;
+    rx->chain[rx->chain_count].iov_len = len;
+    rx->chain_count++;
+    rx->total_len += len;
+    return EP_OK;
+}
+
+void edge_dlms_block_rx_init(edge_dlms_block_rx_t *rx, struct iovec *chain, int chain_cap, const edge_allocator_t *allocator) {
+    if (!rx) return;
+    memset(rx, 0, sizeof(*rx));
+    rx->chain = chain;
+    rx->chain_cap = chain ? chain_cap : 0;
+    rx->allocator = allocator;
+}
+
+void edge_dlms_block_rx_reset(edge_dlms_block_rx_t *rx) {
+    if (!rx) return;
+    for (int i = 0; i < rx->chain_count; i++) edge_free(rx->allocator, rx->chain[i].iov_base, rx->chain[i].iov_len);
+    rx->chain_count = 0;
+    rx->total_len = 0;
+    rx->block = 0;
+    rx->last = false;
+    rx->dar = 0;
+    rx->generation++;
+}
+
+static edge_error_t _blockrx_feed(edge_dlms_block_rx_t *rx, edge_cursor_t *apdu) {
+    uint8_t tag, type, invoke_id, choice;
+    EP_ASSERT_OK(edge_cursor_read_u8(apdu, &tag));
+    if (tag != (uint8_t)DLMS_APDU_GET_RESPONSE) return EP_ERR_INVALID_FRAME;
+    EP_ASSERT_OK(edge_cursor_read_u8(apdu, &type));
+    EP_ASSERT_OK(edge_cursor_read_u8(apdu, &invoke_id));
+
+    if (type == DLMS_GET_NORMAL) {
+        // 未分块的响应：Data 即 APDU 余下部分，作为单块收下
+        edge_dlms_block_rx_reset(rx);
+        rx->invoke_id = invoke_id;
+        rx->last = true;
+        EP_ASSERT_OK(edge_cursor_read_u8(apdu, &choice));
+        if (choice) { EP_ASSERT_OK(edge_cursor_read_u8(apdu, &rx->dar)); return EP_ERR_GENERIC; }
+        return _blockrx_append(rx, apdu, edge_cursor_remaining(apdu));
+    }
+    if (type != 0x02) return EP_ERR_NOT_SUPPORTED;
+
+    uint8_t last; uint32_t block;
+    EP_ASSERT_OK(edge_cursor_read_u8(apdu, &last));
+    EP_ASSERT_OK(edge_cursor_read_be32(apdu, &block));
+    if (block == 1 && rx->block) {
+        // 上一轮已收完则是新一次读取，只有中途重来才计为重新开始
+        if (!rx->last) EDGE_STATS_ADD(rx, EDGE_STAT_BLOCK_RESTARTS, 1);
+        edge_dlms_block_rx_reset(rx);
+    }
+    if (block != 0 && block == rx->block) { // 重传的块：丢弃
+        EP_ASSERT_OK(edge_cursor_skip(apdu, edge_cursor_remaining(apdu)));
+        return rx->last ? EP_OK : EP_ERR_INCOMPLETE_DATA;
+    }
+    if (block != rx->block + 1 || rx->last) return EP_ERR_INVALID_FRAME;
+    if (block == 1) rx->invoke_id = invoke_id;
+    else if (invoke_id != rx->invoke_id) return EP_ERR_INVALID_FRAME;
+
+    EP_ASSERT_OK(edge_cursor_read_u8(apdu, &choice));
+    if (choice) {
+        rx->last = true;
+        EP_ASSERT_OK(edge_cursor_read_u8(apdu, &rx->dar));
+        return EP_ERR_GENERIC;
+    }
+    size_t len;
+    EP_ASSERT_OK(_blockrx_read_len(apdu, &len));
+    if (len > edge_cursor_remaining(apdu)) return EP_ERR_INCOMPLETE_DATA;
+    EP_ASSERT_OK(_blockrx_append(rx, apdu, len));
+    rx->block = block;
+    rx->last = last != 0;
+    return rx->last ? EP_OK : EP_ERR_INCOMPLETE_DATA;
+}
+
+edge_error_t edge_dlms_block_rx_feed(edge_dlms_block_rx_t *rx, edge_cursor_t *apdu) {
+    if (!rx || !apdu) return EP_ERR_INVALID_ARG;
+    return _blockrx_feed(rx, apdu);
+}
+
+edge_error_t edge_dlms_block_rx_build_next(const edge_dlms_block_rx_t *rx, edge_dlms_encoder_t *enc) {
+    if (!rx || !enc) return EP_ERR_INVALID_ARG;
+    if (!rx->block || rx->last) return EP_ERR_INVALID_STATE;
+    return edge_dlms_build_get_next(enc, rx->invoke_id, rx->block);
+}
+
+uint32_t edge_dlms_block_rx_cursor(const edge_dlms_block_rx_t *rx, edge_cursor_t *c) {
+    if (!rx || !c) return 0;
+    edge_cursor_init(c, rx->chain, rx->chain_count);
+    return rx->generation;
+}
+
+edge_error_t edge_dlms_block_rx_extend(const edge_dlms_block_rx_t *rx, edge_cursor_t *c, uint32_t generation) {
+    if (!rx || !c) return EP_ERR_INVALID_ARG;
+    // 链已被 reset/重启释放，或 cursor 并非由此接收器发出：读位置不再对应任何有效数据
+    if (generation != rx->generation || c->iovs != rx->chain) return EP_ERR_INVALID_STATE;
+    if (c->current_iov > rx->chain_count || c->total_read > rx->total_len) return EP_ERR_INVALID_STATE;
+    c->count = rx->chain_count;
+    c->total_len = rx->total_len;
+    return EP_OK;
+}
@@ -13,6 +13,7 @@ void edge_dlms_reset(edge_dlms_context_t *ctx) {
     if (!ctx) return;
     ctx->state = EDGE_COSEM_STATE_IDLE;
     ctx->block_ctx.active = false;
+    ctx->block_ctx.stream = NULL;
     edge_hdlc_reset(&ctx->hdlc);
 }
 
@@ -56,6 +57,13 @@ edge_error_t edge_dlms_build_get_request(edge_dlms_encoder_t *enc, edge_dlms_ser
     return EP_OK;
 }
 
+edge_error_t edge_dlms_build_get_next(edge_dlms_encoder_t *enc, uint8_t invoke_id, uint32_t block) {
+    EP_ASSERT_OK(edge_vector_put_u8(enc->v, (uint8_t)DLMS_APDU_GET_REQUEST));
+    EP_ASSERT_OK(edge_vector_put_u8(enc->v, (uint8_t)DLMS_GET_NEXT));
+    EP_ASSERT_OK(edge_vector_put_u8(enc->v, invoke_id));
+    return edge_vector_put_be32(enc->v, block);
+}
+
 edge_error_t edge_dlms_encode_selective_access(edge_dlms_encoder_t *enc, const uint8_t *from_date, const uint8_t *to_date) {
     EP_ASSERT_OK(edge_dlms_encode_begin_container(enc, DLMS_TAG_STRUCTURE));
     {
@@ -30,9 +30,8 @@ edge_error_t edge_dlms_encode_end_container(edge_dlms_encoder_t *enc) {
 edge_error_t edge_dlms_encode_set_container_len(edge_dlms_encoder_t *enc, size_t count) {
     if (enc->depth == 0) return EP_ERR_INVALID_STATE;
     size_t len_pos = enc->stack_offsets[enc->depth - 1];
-    uint8_t *p = (uint8_t *)edge_vector_get_ptr(enc->v, len_pos);
-    if (p) *p = (uint8_t)count;
-    return EP_OK;
+    uint8_t n = (uint8_t)count;
+    return edge_vector_patch(enc->v, len_pos, &n, 1);
 }
 
 edge_error_t edge_dlms_encode_u8(edge_dlms_encoder_t *enc, uint8_t val) {
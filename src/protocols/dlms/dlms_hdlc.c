@@ -1,8 +1,8 @@
 #include "protocols/edge_dlms.h"
 #include "common/crc.h"
+#include "common/stats.h"
 #include "edge_core.h"
 #include <string.h>
-#include <stdlib.h>
 
 void edge_hdlc_init(edge_hdlc_manager_t *mgr, uint32_t client_addr, uint32_t server_addr) {
     if (!mgr) return;
@@ -14,11 +14,23 @@ void edge_hdlc_init(edge_hdlc_manager_t *mgr, uint32_t client_addr, uint32_t ser
 
 void edge_hdlc_reset(edge_hdlc_manager_t *mgr) {
     if (!mgr) return;
-    if (mgr->reassembly_buf) { free(mgr->reassembly_buf); mgr->reassembly_buf = NULL; }
+    if (mgr->reassembly_buf) {
+        edge_free(mgr->allocator, mgr->reassembly_buf, mgr->reassembly_size);
+        mgr->reassembly_buf = NULL; mgr->reassembly_size = 0;
+    }
     mgr->state = HDLC_STATE_DISCONNECTED;
     mgr->ns = 0; mgr->nr = 0;
 }
 
+void edge_hdlc_set_allocator(edge_hdlc_manager_t *mgr, const edge_allocator_t *allocator) {
+    if (!mgr) return;
+    if (mgr->reassembly_buf) { // 已有缓冲须归还给原分配器
+        edge_free(mgr->allocator, mgr->reassembly_buf, mgr->reassembly_size);
+        mgr->reassembly_buf = NULL; mgr->reassembly_size = 0;
+    }
+    mgr->allocator = allocator;
+}
+
 static int _parse_addr(edge_cursor_t *c, uint32_t *addr) {
     uint32_t val = 0; uint8_t b; int len = 0;
     do { if (edge_cursor_read_u8(c, &b) != EP_OK) return -1;
@@ -37,9 +49,10 @@ edge_error_t edge_hdlc_build_snrm(edge_hdlc_manager_t *mgr, edge_vector_t *v) {
     return EP_OK;
 }
 
-edge_error_t edge_hdlc_build_iframe(edge_hdlc_manager_t *mgr, edge_vector_t *v, const void *apdu, size_t len, bool final) {
+static edge_error_t _hdlc_build_iframe(edge_hdlc_manager_t *mgr, edge_vector_t *v, const void *apdu, size_t len, bool final) {
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x7E));
-    uint16_t f_len = (uint16_t)(len + 7); // Format(2)+Addrs(2)+Ctrl(1)+HCS(2) = 7
+    edge_vector_check_begin(v, EDGE_CHECK_CRC16_CCITT);
+    uint16_t f_len = (uint16_t)(len + 9); // Format(2)+Addrs(2)+Ctrl(1)+HCS(2)+FCS(2) = 9
     EP_ASSERT_OK(edge_vector_put_be16(v, (uint16_t)(0xA000 | f_len)));
     EP_ASSERT_OK(edge_vector_put_u8(v, (uint8_t)((mgr->server_addr<<1)|1)));
     EP_ASSERT_OK(edge_vector_put_u8(v, (uint8_t)((mgr->client_addr<<1)|1)));
@@ -47,31 +60,97 @@ edge_error_t edge_hdlc_build_iframe(edge_hdlc_manager_t *mgr, edge_vector_t *v,
     if (final) ctrl |= 0x10;
     EP_ASSERT_OK(edge_vector_put_u8(v, ctrl));
     
-    // HCS calculation (mock for now)
-    EP_ASSERT_OK(edge_vector_put_le16(v, 0x0000));
+    // HCS/FCS 随追加增量计算，无需回扫帧
+    EP_ASSERT_OK(edge_vector_put_le16(v, edge_vector_check_value(v)));
     EP_ASSERT_OK(edge_vector_append_ref(v, apdu, len));
-    EP_ASSERT_OK(edge_vector_put_le16(v, 0x0000));
+    EP_ASSERT_OK(edge_vector_put_le16(v, edge_vector_check_value(v)));
+    edge_vector_check_end(v);
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x7E));
     if (final) mgr->ns = (uint8_t)((mgr->ns + 1) % 8);
     return EP_OK;
 }
 
-edge_error_t edge_hdlc_parse(edge_hdlc_manager_t *mgr, edge_cursor_t *c, uint8_t *apdu_out, size_t *apdu_len) {
-    uint8_t b;
-    while (edge_cursor_remaining(c) > 0) {
-        EP_ASSERT_OK(edge_cursor_read_u8(c, &b));
-        if (b == 0x7E) break;
-    }
-    if (edge_cursor_remaining(c) < 9) return EP_ERR_INCOMPLETE_DATA;
-    uint16_t format; EP_ASSERT_OK(edge_cursor_read_be16(c, &format));
-    uint32_t d, s; _parse_addr(c, &d); _parse_addr(c, &s);
-    uint8_t ctrl; EP_ASSERT_OK(edge_cursor_read_u8(c, &ctrl));
-    uint16_t hcs; EP_ASSERT_OK(edge_cursor_read_le16(c, &hcs));
+edge_error_t edge_hdlc_build_iframe(edge_hdlc_manager_t *mgr, edge_vector_t *v, const void *apdu, size_t len, bool final) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _hdlc_build_iframe(mgr, v, apdu, len, final);
+    EDGE_STATS_END(mgr, EDGE_STAT_FRAMES_TX, err, t0);
+    return err;
+}
+
+/**
+ * @brief 解析帧头：c 停在起始标志，body 停在载荷首字节，h_len 为 HCS 覆盖的字节数
+ */
+static edge_error_t _hdlc_parse_header(edge_hdlc_manager_t *mgr, edge_cursor_t *c, edge_cursor_t *body,
+                                       size_t *h_len, size_t *p_len) {
+    static const uint8_t flag = 0x7E;
+    size_t skipped = 0;
+    edge_error_t found = edge_cursor_scan(c, &flag, 1, &skipped);
+    EDGE_STATS_ADD(mgr, EDGE_STAT_RESYNC_BYTES, skipped);
+    (void)mgr;
+    if (found != EP_OK) return EP_ERR_INCOMPLETE_DATA;
+    *body = *c;
+    EP_ASSERT_OK(edge_cursor_skip(body, 1));
+    if (edge_cursor_remaining(body) < 9) return EP_ERR_INCOMPLETE_DATA;
+    uint16_t format; EP_ASSERT_OK(edge_cursor_read_be16(body, &format));
+    uint32_t d, s;
+    int d_len = _parse_addr(body, &d), s_len = _parse_addr(body, &s);
+    if (d_len < 0 || s_len < 0) return EP_ERR_INCOMPLETE_DATA;
+    uint8_t ctrl; EP_ASSERT_OK(edge_cursor_read_u8(body, &ctrl));
+    EP_ASSERT_OK(edge_cursor_skip(body, 2)); // HCS
     
     size_t total_len = format & 0x07FF;
-    // [高质量公式]：Payload = TotalLen - (Addr_len + Ctrl(1) + HCS(2) + FCS(2))
-    size_t p_len = total_len - 2 - 1 - 2 - 2; 
-    
+    // [高质量公式]：Payload = TotalLen - (Format(2) + Addr_len + Ctrl(1) + HCS(2) + FCS(2))
+    size_t hdr_len = 2 + (size_t)d_len + (size_t)s_len + 1 + 2 + 2;
+    if (total_len < hdr_len) return EP_ERR_INVALID_FRAME;
+    *h_len = hdr_len - 4;
+    *p_len = total_len - hdr_len;
+    return EP_OK;
+}
+
+static edge_error_t _hdlc_parse_slice(edge_hdlc_manager_t *mgr, edge_cursor_t *c, edge_cursor_t *apdu) {
+    edge_cursor_t f, hdr;
+    size_t h_len, p_len;
+    EP_ASSERT_OK(_hdlc_parse_header(mgr, c, &f, &h_len, &p_len));
+    if (edge_cursor_remaining(&f) < p_len + 3) return EP_ERR_INCOMPLETE_DATA;
+
+    // HCS 覆盖格式域至控制域，FCS 覆盖格式域至载荷末尾，均从起始标志之后算起
+    hdr = *c;
+    EP_ASSERT_OK(edge_cursor_skip(&hdr, 1));
+    uint16_t crc, r_crc;
+    edge_cursor_t t = hdr;
+    EP_ASSERT_OK(edge_cursor_checksum(&hdr, EDGE_CHECK_CRC16_CCITT, h_len, &crc));
+    EP_ASSERT_OK(edge_cursor_skip(&t, h_len));
+    EP_ASSERT_OK(edge_cursor_read_le16(&t, &r_crc));
+    if (crc != r_crc) {
+        edge_cursor_skip(c, 1); // 伪起始标志：越过后重新搜索
+        return EP_ERR_CHECKSUM;
+    }
+    EP_ASSERT_OK(edge_cursor_checksum(&hdr, EDGE_CHECK_CRC16_CCITT, h_len + 2 + p_len, &crc));
+    edge_cursor_t body;
+    uint8_t end;
+    EP_ASSERT_OK(edge_cursor_slice(&f, p_len, &body));
+    EP_ASSERT_OK(edge_cursor_read_le16(&f, &r_crc));
+    EP_ASSERT_OK(edge_cursor_read_u8(&f, &end));
+    *c = f; // 帧已完整收到：无论校验结果都越过整帧
+    if (crc != r_crc) return EP_ERR_CHECKSUM;
+    if (end != 0x7E) return EP_ERR_INVALID_FRAME;
+    *apdu = body;
+    return EP_OK;
+}
+
+edge_error_t edge_hdlc_parse_slice(edge_hdlc_manager_t *mgr, edge_cursor_t *c, edge_cursor_t *apdu) {
+    if (!c || !apdu) return EP_ERR_INVALID_ARG;
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _hdlc_parse_slice(mgr, c, apdu);
+    EDGE_STATS_END(mgr, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
+
+static edge_error_t _hdlc_parse(edge_hdlc_manager_t *mgr, edge_cursor_t *c, uint8_t *apdu_out, size_t *apdu_len) {
+    edge_cursor_t body;
+    size_t h_len, p_len;
+    EP_ASSERT_OK(_hdlc_parse_header(mgr, c, &body, &h_len, &p_len));
+    *c = body;
     if (apdu_out && apdu_len) {
         if (*apdu_len < p_len) return EP_ERR_BUFFER_TOO_SMALL;
         EP_ASSERT_OK(edge_cursor_read_bytes(c, apdu_out, p_len));
@@ -79,3 +158,31 @@ edge_error_t edge_hdlc_parse(edge_hdlc_manager_t *mgr, edge_cursor_t *c, uint8_t
     }
     return EP_OK;
 }
+
+edge_error_t edge_hdlc_parse(edge_hdlc_manager_t *mgr, edge_cursor_t *c, uint8_t *apdu_out, size_t *apdu_len) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _hdlc_parse(mgr, c, apdu_out, apdu_len);
+    EDGE_STATS_END(mgr, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
+
+edge_error_t edge_hdlc_template_iframe(edge_hdlc_manager_t *mgr, edge_frame_template_t *t, const void *apdu, size_t len) {
+    if (!mgr || !t) return EP_ERR_INVALID_ARG;
+    struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8);
+    uint8_t ns = mgr->ns;
+    EP_ASSERT_OK(_hdlc_build_iframe(mgr, &v, apdu, len, true));
+    mgr->ns = ns;
+    EP_ASSERT_OK(edge_template_capture(t, &v));
+    // 7E | 格式(2) 目的 源 控制 | HCS | APDU | FCS | 7E，地址各 1 字节
+    EP_ASSERT_OK(edge_template_add_field(t, 5, 1, false));
+    EP_ASSERT_OK(edge_template_add_check(t, EDGE_CHECK_CRC16_CCITT, 1, 5, 6));
+    return edge_template_add_check(t, EDGE_CHECK_CRC16_CCITT, 1, 7 + len, 8 + len);
+}
+
+edge_error_t edge_hdlc_template_emit(edge_hdlc_manager_t *mgr, edge_frame_template_t *t, edge_vector_t *v) {
+    if (!mgr) return EP_ERR_INVALID_ARG;
+    EP_ASSERT_OK(edge_template_set(t, 0, (uint32_t)((mgr->nr << 5) | (mgr->ns << 1) | 0x10)));
+    EP_ASSERT_OK(edge_template_emit(t, v));
+    mgr->ns = (uint8_t)((mgr->ns + 1) % 8);
+    return EP_OK;
+}
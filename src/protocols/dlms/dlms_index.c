@@ -0,0 +1,58 @@
+#include "protocols/edge_dlms.h"
+#include <string.h>
+
+static inline uint64_t _index_key(uint16_t class_id, const uint8_t obis[6]) {
+    uint64_t k = class_id;
+    for (int i = 0; i < 6; i++) k = (k << 8) | obis[i];
+    return k;
+}
+
+// Fibonacci 散列取乘积高 32 位，再乘槽数取高位映射到 [0, cap)，槽数无需为 2 的幂
+static inline size_t _index_hash(const edge_dlms_index_t *idx, uint64_t key, int8_t index) {
+    uint64_t h = (key ^ ((uint64_t)(uint8_t)index << 56)) * 0x9E3779B97F4A7C15ull;
+    return (size_t)(((h >> 32) * (uint64_t)idx->cap) >> 32);
+}
+
+static const edge_dlms_index_slot_t *_index_probe(const edge_dlms_index_t *idx, uint64_t key, int8_t index) {
+    for (size_t i = _index_hash(idx, key, index);; i = i + 1 == idx->cap ? 0 : i + 1) {
+        const edge_dlms_index_slot_t *s = &idx->slots[i];
+        if (!s->res) return NULL;
+        if (s->key == key && s->index == index) return s;
+    }
+}
+
+edge_error_t edge_dlms_index_build(edge_dlms_index_t *idx, edge_dlms_index_slot_t *slots, size_t slot_cap,
+                                   const edge_dlms_resource_t *resources, size_t count) {
+    if (!idx || !slots || (!resources && count)) return EP_ERR_INVALID_ARG;
+    if (slot_cap > UINT32_MAX) slot_cap = UINT32_MAX;
+    if (slot_cap < 2 || slot_cap / 2 < count) return EP_ERR_BUFFER_TOO_SMALL;
+
+    memset(slots, 0, slot_cap * sizeof(slots[0]));
+    *idx = (edge_dlms_index_t){ .slots = slots, .cap = slot_cap, .resources = resources };
+    for (size_t r = 0; r < count; r++) {
+        const edge_dlms_object_t *o = &resources[r].obj;
+        uint64_t key = _index_key(o->class_id, o->obis);
+        size_t i = _index_hash(idx, key, o->attribute_index);
+        for (; slots[i].res; i = i + 1 == idx->cap ? 0 : i + 1) {
+            if (slots[i].key == key && slots[i].index == o->attribute_index) {
+                idx->slots = NULL;
+                return EP_ERR_INVALID_ARG;
+            }
+        }
+        slots[i] = (edge_dlms_index_slot_t){ .key = key, .res = (uint32_t)(r + 1), .index = o->attribute_index };
+    }
+    return EP_OK;
+}
+
+const edge_dlms_resource_t *edge_dlms_index_find(const edge_dlms_index_t *idx, uint16_t class_id, const uint8_t obis[6], int8_t index) {
+    if (!idx || !idx->slots || !obis) return NULL;
+    uint64_t key = _index_key(class_id, obis);
+    const edge_dlms_index_slot_t *s = _index_probe(idx, key, index);
+    if (!s && index > 0) s = _index_probe(idx, key, 0);
+    return s ? &idx->resources[s->res - 1] : NULL;
+}
+
+edge_error_t edge_dlms_server_build_index(edge_dlms_context_t *ctx, edge_dlms_index_slot_t *slots, size_t slot_cap) {
+    if (!ctx) return EP_ERR_INVALID_ARG;
+    return edge_dlms_index_build(&ctx->index, slots, slot_cap, ctx->resources, ctx->resource_count);
+}
@@ -2,26 +2,140 @@
 #include <string.h>
 
 /**
- * @brief DLMS 安全套件 0 原地加密实现
- * 对齐 DLMS.md 4.4 节：安全层零拷贝
+ * @brief DLMS 安全套件 0 (AES-GCM-128) 原地加解密
+ * 对齐 DLMS.md 4.4 节：安全层零拷贝，GCM 直接在 iovec 各段上运行，不压平帧
  */
+
+typedef enum { _SEC_AAD, _SEC_ENCRYPT, _SEC_DECRYPT } _sec_op_t;
+
+static void _sec_apply(edge_gcm_t *g, _sec_op_t op, void *p, size_t n) {
+    switch (op) {
+        case _SEC_AAD:     edge_gcm_aad(g, p, n); break;
+        case _SEC_ENCRYPT: edge_gcm_encrypt(g, p, n); break;
+        case _SEC_DECRYPT: edge_gcm_decrypt(g, p, n); break;
+    }
+}
+
+// 只接受套件 0、单播密钥、无压缩，且至少请求认证或加密之一
+static edge_error_t _sec_check_sc(uint8_t sc) {
+    if (sc & ~(DLMS_SC_AUTHENTICATION | DLMS_SC_ENCRYPTION)) return EP_ERR_NOT_SUPPORTED;
+    if (!(sc & (DLMS_SC_AUTHENTICATION | DLMS_SC_ENCRYPTION))) return EP_ERR_INVALID_ARG;
+    return EP_OK;
+}
+
+static void _sec_start(edge_gcm_t *g, const edge_dlms_security_ctx_t *ctx, const uint8_t title[8], uint8_t sc, uint32_t ic) {
+    uint8_t iv[EDGE_GCM_IV_SIZE];
+    memcpy(iv, title, 8);
+    iv[8] = (uint8_t)(ic >> 24);
+    iv[9] = (uint8_t)(ic >> 16);
+    iv[10] = (uint8_t)(ic >> 8);
+    iv[11] = (uint8_t)(ic & 0xFF);
+    edge_gcm_start(g, &ctx->block_cipher_key, iv);
+    if (sc & DLMS_SC_AUTHENTICATION) {
+        edge_gcm_aad(g, &sc, 1);
+        edge_gcm_aad(g, ctx->authentication_key, sizeof(ctx->authentication_key));
+    }
+}
+
+/**
+ * @brief 从 c 的当前位置起对 len 字节逐段执行 op (c 本身不前进)
+ */
+static void _sec_walk_cursor(edge_gcm_t *g, _sec_op_t op, const edge_cursor_t *c, size_t len) {
+    size_t off = c->current_offset;
+    for (int i = c->current_iov; len > 0; i++, off = 0) {
+        size_t n = c->iovs[i].iov_len - off;
+        if (n > len) n = len;
+        if (n) _sec_apply(g, op, (uint8_t *)c->iovs[i].iov_base + off, n);
+        len -= n;
+    }
+}
+
+static bool _sec_tag_equal(const uint8_t *a, const uint8_t *b, size_t n) {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < n; i++) diff |= (uint8_t)(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+void edge_dlms_security_set_keys(edge_dlms_security_ctx_t *ctx, const uint8_t ek[16], const uint8_t ak[16]) {
+    if (!ctx || !ek || !ak) return;
+    edge_gcm_set_key(&ctx->block_cipher_key, ek);
+    memcpy(ctx->authentication_key, ak, sizeof(ctx->authentication_key));
+}
+
 edge_error_t edge_dlms_encrypt_apdu(edge_dlms_security_ctx_t *ctx, edge_vector_t *v, uint8_t security_control) {
     if (!ctx || !v) return EP_ERR_INVALID_ARG;
+    EP_ASSERT_OK(_sec_check_sc(security_control));
+    if (ctx->invocation_counter == UINT32_MAX) return EP_ERR_OVERFLOW;
+
+    // 1. 加密时先把引用调用方内存的段 (块缓冲区、常量表) 换成 scratch 副本，密文只写入 vector 自有存储；
+    //    失败时帧内容不变
+    _sec_op_t op = (security_control & DLMS_SC_ENCRYPTION) ? _SEC_ENCRYPT : _SEC_AAD;
+    for (int i = 0; op == _SEC_ENCRYPT && i < v->used_count; i++) {
+        uint8_t *p;
+        EP_ASSERT_OK(edge_vector_own_segment(v, i, &p));
+    }
+
+    // 2. Security Header 插到帧首
+    uint32_t ic = ctx->invocation_counter;
+    uint8_t sh[DLMS_SECURITY_HEADER_LEN] = { security_control, (uint8_t)(ic >> 24), (uint8_t)(ic >> 16),
+                                             (uint8_t)(ic >> 8), (uint8_t)(ic & 0xFF) };
+    EP_ASSERT_OK(edge_vector_prepend_copy(v, sh, sizeof(sh)));
 
-    // 1. IV 生成 (System Title + IC)
-    uint8_t iv[12];
-    memcpy(iv, ctx->system_title, 8);
-    iv[8] = (uint8_t)(ctx->invocation_counter >> 24);
-    iv[9] = (uint8_t)(ctx->invocation_counter >> 16);
-    iv[10] = (uint8_t)(ctx->invocation_counter >> 8);
-    iv[11] = (uint8_t)(ctx->invocation_counter & 0xFF);
-    
-    // 2. 插入 Security Header
-    EP_ASSERT_OK(edge_vector_put_u8(v, security_control));
-    EP_ASSERT_OK(edge_vector_put_be32(v, ctx->invocation_counter));
-    
-    // 3. 递增 IC (防止重放攻击)
+    // 3. IV 一经用于密钥流即视为已消耗：先递增 IC (防止重放，也保证后续失败重试不会复用 nonce)
     ctx->invocation_counter++;
-    
+
+    // 4. 从 iovs[1] 起逐段加密 (或仅认证时把明文计入 AAD)
+    edge_gcm_t g;
+    _sec_start(&g, ctx, ctx->system_title, security_control, ic);
+    for (int i = 1; i < v->used_count; i++) _sec_apply(&g, op, v->iovs[i].iov_base, v->iovs[i].iov_len);
+
+    // 5. 截断标签
+    if (security_control & DLMS_SC_AUTHENTICATION) {
+        uint8_t tag[16];
+        edge_gcm_finish(&g, tag);
+        EP_ASSERT_OK(edge_vector_append_copy(v, tag, DLMS_GCM_TAG_LEN));
+    }
+    return EP_OK;
+}
+
+edge_error_t edge_dlms_decrypt_apdu(const edge_dlms_security_ctx_t *ctx, const uint8_t sender_title[8],
+                                    edge_cursor_t *c, edge_cursor_t *apdu, uint32_t *ic) {
+    if (!ctx || !sender_title || !c || !apdu) return EP_ERR_INVALID_ARG;
+    edge_cursor_t r = *c;
+    uint8_t sc;
+    uint32_t counter;
+    EP_ASSERT_OK(edge_cursor_read_u8(&r, &sc));
+    EP_ASSERT_OK(edge_cursor_read_be32(&r, &counter));
+    EP_ASSERT_OK(_sec_check_sc(sc));
+    size_t tag_len = (sc & DLMS_SC_AUTHENTICATION) ? DLMS_GCM_TAG_LEN : 0;
+    size_t rem = edge_cursor_remaining(&r);
+    if (rem < tag_len) return EP_ERR_INCOMPLETE_DATA;
+    size_t len = rem - tag_len;
+
+    edge_gcm_t g;
+    _sec_start(&g, ctx, sender_title, sc, counter);
+    _sec_op_t op = (sc & DLMS_SC_ENCRYPTION) ? _SEC_DECRYPT : _SEC_AAD;
+    _sec_walk_cursor(&g, op, &r, len);
+
+    if (tag_len) {
+        uint8_t expect[16], got[DLMS_GCM_TAG_LEN];
+        edge_gcm_finish(&g, expect);
+        edge_cursor_t t = r;
+        EP_ASSERT_OK(edge_cursor_skip(&t, len));
+        EP_ASSERT_OK(edge_cursor_read_bytes(&t, got, sizeof(got)));
+        if (!_sec_tag_equal(expect, got, DLMS_GCM_TAG_LEN)) {
+            // CTR 为异或流，同一 IV 再加密一遍即还原密文，未经认证的明文不外泄
+            if (op == _SEC_DECRYPT) {
+                _sec_start(&g, ctx, sender_title, sc, counter);
+                _sec_walk_cursor(&g, _SEC_ENCRYPT, &r, len);
+            }
+            return EP_ERR_CHECKSUM;
+        }
+    }
+
+    EP_ASSERT_OK(edge_cursor_slice(&r, len, apdu));
+    EP_ASSERT_OK(edge_cursor_skip(&r, tag_len));
+    *c = r;
+    if (ic) *ic = counter;
     return EP_OK;
-}
\ No newline at end of file
+}
@@ -1,55 +1,449 @@
 #include "protocols/edge_dlms.h"
+#include "common/stats.h"
 #include <string.h>
 #include <stdio.h>
 
 /**
- * @brief DLMS 从站 PDU 分发引擎
+ * @brief 按 class_id + OBIS + 属性/方法号定位资源：已构建索引时 O(1)，否则线性扫描 (语义相同)
  */
-edge_error_t edge_dlms_server_dispatch(edge_dlms_context_t *ctx, edge_cursor_t *req, edge_vector_t *resp) {
-    if (!ctx || !req || !resp) return EP_ERR_INVALID_ARG;
+static const edge_dlms_resource_t *_server_find(const edge_dlms_context_t *ctx, uint16_t class_id, const uint8_t obis[6], int8_t index) {
+    if (ctx->index.slots) return edge_dlms_index_find(&ctx->index, class_id, obis, index);
+    const edge_dlms_resource_t *wildcard = NULL;
+    for (size_t i = 0; i < ctx->resource_count; i++) {
+        const edge_dlms_resource_t *res = &ctx->resources[i];
+        if (res->obj.class_id != class_id || memcmp(res->obj.obis, obis, 6) != 0) continue;
+        if (res->obj.attribute_index == index) return res;
+        if (res->obj.attribute_index == 0 && index > 0 && !wildcard) wildcard = res;
+    }
+    return wildcard;
+}
 
-    uint8_t service_tag;
-    EP_ASSERT_OK(edge_cursor_read_u8(req, &service_tag));
+// --- A-XDR 辅助 ---
 
-    if (service_tag == (uint8_t)DLMS_APDU_GET_REQUEST) {
-        uint8_t type;
-        EP_ASSERT_OK(edge_cursor_read_u8(req, &type)); 
-        uint8_t invoke_id;
-        EP_ASSERT_OK(edge_cursor_read_u8(req, &invoke_id));
-
-        if (type == 1) { // GET-Normal
-            uint16_t class_id;
-            uint8_t obis[6];
-            uint8_t attr_index;
-            
-            EP_ASSERT_OK(edge_cursor_read_be16(req, &class_id));
-            EP_ASSERT_OK(edge_cursor_read_bytes(req, obis, 6));
-            EP_ASSERT_OK(edge_cursor_read_u8(req, &attr_index));
-
-            for (size_t i = 0; i < ctx->resource_count; i++) {
-                const edge_dlms_resource_t *res = &ctx->resources[i];
-                if (res->obj.class_id == class_id && memcmp(res->obj.obis, obis, 6) == 0) {
-                    edge_dlms_variant_t val = {0};
-                    edge_error_t err = res->on_get(&res->obj, &val, res->user_data);
-                    
-                    edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_GET_RESPONSE);
-                    edge_vector_put_u8(resp, 0x01); 
-                    edge_vector_put_u8(resp, invoke_id);
-                    edge_vector_put_u8(resp, (err == EP_OK) ? 0x00 : 0x01);
-                    
-                    if (err == EP_OK && val.data) {
-                        edge_vector_put_u8(resp, (uint8_t)val.tag);
-                        edge_vector_append_copy(resp, val.data, val.length);
-                    }
-                    return EP_OK;
-                }
-            }
-            edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_GET_RESPONSE);
-            edge_vector_put_u8(resp, 0x01); 
-            edge_vector_put_u8(resp, invoke_id);
-            edge_vector_put_u8(resp, 0x01); 
-        }
+static edge_error_t _server_read_len(edge_cursor_t *c, size_t *n) {
+    uint8_t b;
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &b));
+    if (b < 0x80) { *n = b; return EP_OK; }
+    if (b == 0x81) { EP_ASSERT_OK(edge_cursor_read_u8(c, &b)); *n = b; return EP_OK; }
+    if (b == 0x82) { uint16_t w; EP_ASSERT_OK(edge_cursor_read_be16(c, &w)); *n = w; return EP_OK; }
+    return EP_ERR_INVALID_FRAME;
+}
+
+static edge_error_t _server_put_len(edge_vector_t *v, size_t n) {
+    if (n < 0x80) return edge_vector_put_u8(v, (uint8_t)n);
+    if (n <= 0xFF) { EP_ASSERT_OK(edge_vector_put_u8(v, 0x81)); return edge_vector_put_u8(v, (uint8_t)n); }
+    if (n <= 0xFFFF) { EP_ASSERT_OK(edge_vector_put_u8(v, 0x82)); return edge_vector_put_be16(v, (uint16_t)n); }
+    return EP_ERR_OVERFLOW;
+}
+
+/**
+ * @brief 定长类型的内容字节数；变长/容器/未知类型返回 -1
+ */
+static int _server_fixed_len(uint8_t tag) {
+    switch (tag) {
+        case DLMS_TAG_NULL_DATA: return 0;
+        case DLMS_TAG_BOOLEAN: case DLMS_TAG_INTEGER: case DLMS_TAG_UNSIGNED:
+        case DLMS_TAG_ENUM: case DLMS_TAG_BCD: return 1;
+        case DLMS_TAG_LONG: case DLMS_TAG_LONG_UNSIGNED: return 2;
+        case DLMS_TAG_DOUBLE_LONG: case DLMS_TAG_DOUBLE_LONG_UNSIGNED:
+        case DLMS_TAG_FLOAT: case DLMS_TAG_TIME: return 4;
+        case DLMS_TAG_DATE: return 5;
+        case DLMS_TAG_LONG64: case DLMS_TAG_LONG64_UNSIGNED: case DLMS_TAG_DOUBLE_LA: return 8;
+        case DLMS_TAG_DATE_TIME: return 12;
+        default: return -1;
     }
+}
+
+static bool _server_is_string(uint8_t tag) {
+    return tag == DLMS_TAG_OCTET_STRING || tag == DLMS_TAG_VISIBLE_STRING || tag == DLMS_TAG_UTF8_STRING;
+}
 
+/**
+ * @brief 跳过一个完整的 Data 元素 (容器逐成员递归，深度上限与编码器一致)
+ */
+static edge_error_t _server_skip_data(edge_cursor_t *c, int depth) {
+    if (depth >= 16) return EP_ERR_INVALID_FRAME;
+    uint8_t tag; size_t n;
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &tag));
+    int fixed = _server_fixed_len(tag);
+    if (fixed >= 0) return edge_cursor_skip(c, (size_t)fixed);
+    if (tag == DLMS_TAG_ARRAY || tag == DLMS_TAG_STRUCTURE) {
+        EP_ASSERT_OK(_server_read_len(c, &n));
+        for (size_t i = 0; i < n; i++) EP_ASSERT_OK(_server_skip_data(c, depth + 1));
+        return EP_OK;
+    }
+    if (tag == DLMS_TAG_BIT_STRING) { EP_ASSERT_OK(_server_read_len(c, &n)); return edge_cursor_skip(c, (n + 7) / 8); }
+    if (_server_is_string(tag)) { EP_ASSERT_OK(_server_read_len(c, &n)); return edge_cursor_skip(c, n); }
     return EP_ERR_NOT_SUPPORTED;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 零拷贝取出一个 Data 元素 (约定见 edge_dlms_resource_t)，c 前进到元素之后
+ * 元素跨 iovec 段时 data 为 NULL 而 length 非零，由调用方回逐项错误。
+ */
+static edge_error_t _server_take_data(edge_cursor_t *c, edge_dlms_variant_t *val) {
+    edge_cursor_t end = *c, body = *c;
+    EP_ASSERT_OK(_server_skip_data(&end, 0));
+    uint8_t tag;
+    EP_ASSERT_OK(edge_cursor_read_u8(&body, &tag));
+    val->tag = (edge_dlms_tag_t)tag;
+    if (tag == DLMS_TAG_ARRAY || tag == DLMS_TAG_STRUCTURE) {
+        body = *c;
+    } else if (tag == DLMS_TAG_BIT_STRING || _server_is_string(tag)) {
+        size_t n;
+        EP_ASSERT_OK(_server_read_len(&body, &n));
+    }
+    val->length = edge_cursor_remaining(&body) - edge_cursor_remaining(&end);
+    val->data = val->length ? edge_cursor_get_ptr(&body, val->length) : NULL;
+    *c = end;
+    return EP_OK;
+}
+
+/**
+ * @brief 校验回调给出的值可编码，避免响应写到一半才失败
+ */
+static edge_error_t _server_check_data(const edge_dlms_variant_t *val) {
+    if (val->length && !val->data) return EP_ERR_GENERIC;
+    if (val->tag == DLMS_TAG_ARRAY || val->tag == DLMS_TAG_STRUCTURE) return val->length ? EP_OK : EP_ERR_GENERIC;
+    int fixed = _server_fixed_len((uint8_t)val->tag);
+    if (fixed >= 0) return val->length == (size_t)fixed ? EP_OK : EP_ERR_GENERIC;
+    if (val->tag == DLMS_TAG_BIT_STRING) return val->length <= 0xFFFF / 8 ? EP_OK : EP_ERR_GENERIC;
+    if (_server_is_string((uint8_t)val->tag)) return val->length <= 0xFFFF ? EP_OK : EP_ERR_GENERIC;
+    return EP_ERR_GENERIC;
+}
+
+static edge_error_t _server_put_data(edge_vector_t *v, const edge_dlms_variant_t *val) {
+    if (val->tag == DLMS_TAG_ARRAY || val->tag == DLMS_TAG_STRUCTURE) return edge_vector_append_copy(v, val->data, val->length);
+    EP_ASSERT_OK(edge_vector_put_u8(v, (uint8_t)val->tag));
+    if (val->tag == DLMS_TAG_BIT_STRING) EP_ASSERT_OK(_server_put_len(v, val->length * 8));
+    else if (_server_is_string((uint8_t)val->tag)) EP_ASSERT_OK(_server_put_len(v, val->length));
+    return val->length ? edge_vector_append_copy(v, val->data, val->length) : EP_OK;
+}
+
+static uint8_t _server_dar(edge_error_t err) {
+    switch (err) {
+        case EP_OK: return DLMS_DAR_SUCCESS;
+        case EP_ERR_NOT_SUPPORTED: return DLMS_DAR_READ_WRITE_DENIED;
+        case EP_ERR_INVALID_ARG: return DLMS_DAR_TYPE_UNMATCHED;
+        case EP_ERR_OUT_OF_BOUNDS: return DLMS_DAR_SCOPE_OF_ACCESS_VIOLATED;
+        case EP_ERR_INVALID_STATE: return DLMS_DAR_TEMPORARY_FAILURE;
+        default: return DLMS_DAR_HARDWARE_FAULT;
+    }
+}
+
+// --- 描述符 ---
+
+/**
+ * @brief 读取 cosem-attribute/method-descriptor；desc->attribute_index 为属性号，方法为负数
+ * 属性号 > 127 或方法号不在 1..128 时无法登记，*valid 置 false 按未定义对象处理。
+ */
+static edge_error_t _server_read_desc(edge_cursor_t *c, bool method, edge_dlms_object_t *desc, bool *valid) {
+    uint8_t id;
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &desc->class_id));
+    EP_ASSERT_OK(edge_cursor_read_bytes(c, desc->obis, 6));
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &id));
+    *valid = method ? (id >= 1 && id <= 128) : id <= 127;
+    desc->attribute_index = *valid ? (int8_t)(method ? -(int)id : (int)id) : 0;
+    return EP_OK;
+}
+
+/**
+ * @brief access-selection OPTIONAL：暂不支持选择性访问，存在时跳过选择子与参数并标记
+ * at_end 为真时允许整个字段缺省 (部分客户端在 GET-Normal 末尾省略)。
+ */
+static edge_error_t _server_read_selection(edge_cursor_t *c, bool at_end, bool *selective) {
+    uint8_t present = 0, selector;
+    *selective = false;
+    if (at_end && edge_cursor_remaining(c) == 0) return EP_OK;
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &present));
+    if (!present) return EP_OK;
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &selector));
+    *selective = true;
+    return _server_skip_data(c, 0);
+}
+
+static const edge_dlms_resource_t *_server_lookup(const edge_dlms_context_t *ctx, const edge_dlms_object_t *desc, bool valid) {
+    return valid ? _server_find(ctx, desc->class_id, desc->obis, desc->attribute_index) : NULL;
+}
+
+// --- GET 流式分块 ---
+
+#define DLMS_BLOCK_HDR_MAX 12 // C4 02 iid | last-block | block-number(4) | raw-data 选择 | 长度 (至多 3 字节)
+
+static size_t _server_block_cap(const edge_dlms_context_t *ctx) {
+    size_t cap = ctx->block_ctx.buf_size;
+    if (ctx->max_pdu_send) {
+        size_t room = ctx->max_pdu_send > DLMS_BLOCK_HDR_MAX ? ctx->max_pdu_send - DLMS_BLOCK_HDR_MAX : 0;
+        if (room < cap) cap = room;
+    }
+    return cap;
+}
+
+/**
+ * @brief 反复调用生成器直到块缓冲区写满或数据结束，块长记入 block_len
+ */
+static edge_error_t _server_stream_fill(edge_dlms_context_t *ctx, const edge_dlms_resource_t *res, const edge_dlms_object_t *desc,
+                                        bool first, bool *done) {
+    size_t cap = _server_block_cap(ctx), used = 0;
+    ctx->block_ctx.block_len = 0;
+    if (!ctx->block_ctx.buf || cap == 0) return EP_ERR_BUFFER_TOO_SMALL;
+    while (used < cap && !*done) {
+        size_t n = 0;
+        EP_ASSERT_OK(res->on_stream(desc, first, ctx->block_ctx.buf + used, cap - used, &n, done, res->user_data));
+        if (n > cap - used) return EP_ERR_OVERFLOW;
+        if (n == 0 && !*done) return EP_ERR_INVALID_STATE; // 生成器既无输出又未结束
+        used += n; first = false;
+    }
+    ctx->block_ctx.block_len = used;
+    return EP_OK;
+}
+
+static edge_error_t _server_put_block_head(edge_vector_t *resp, uint8_t invoke_id, bool last, uint32_t block) {
+    EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_GET_RESPONSE));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x02)); // GET-Response-With-Datablock
+    EP_ASSERT_OK(edge_vector_put_u8(resp, invoke_id));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, last ? 0x01 : 0x00));
+    return edge_vector_put_be32(resp, block);
+}
+
+/**
+ * @brief 发出当前块：raw-data 零拷贝引用块缓冲区
+ */
+static edge_error_t _server_put_block(edge_dlms_context_t *ctx, uint8_t invoke_id, edge_vector_t *resp) {
+    EP_ASSERT_OK(_server_put_block_head(resp, invoke_id, ctx->block_ctx.done, ctx->block_ctx.current_block));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x00));
+    EP_ASSERT_OK(_server_put_len(resp, ctx->block_ctx.block_len));
+    return ctx->block_ctx.block_len ? edge_vector_append_ref(resp, ctx->block_ctx.buf, ctx->block_ctx.block_len) : EP_OK;
+}
+
+static edge_error_t _server_abort_block(edge_dlms_context_t *ctx, uint8_t invoke_id, uint8_t dar, edge_vector_t *resp) {
+    ctx->block_ctx.stream = NULL;
+    EP_ASSERT_OK(_server_put_block_head(resp, invoke_id, true, ctx->block_ctx.current_block));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x01));
+    return edge_vector_put_u8(resp, dar);
+}
+
+/**
+ * @brief GET-Normal 命中流式资源：一个 PDU 装得下时回 GET-Response-Normal，否则开始分块
+ */
+static edge_error_t _server_stream_begin(edge_dlms_context_t *ctx, const edge_dlms_resource_t *res, const edge_dlms_object_t *desc,
+                                         uint8_t invoke_id, edge_vector_t *resp) {
+    bool done = false;
+    edge_error_t err = _server_stream_fill(ctx, res, desc, true, &done);
+    if (err == EP_OK && ctx->block_ctx.block_len == 0) err = EP_ERR_GENERIC;
+    bool fits = done && (!ctx->max_pdu_send || ctx->block_ctx.block_len + 4 <= ctx->max_pdu_send);
+    if (err != EP_OK || fits) {
+        EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_GET_RESPONSE));
+        EP_ASSERT_OK(edge_vector_put_u8(resp, DLMS_GET_NORMAL));
+        EP_ASSERT_OK(edge_vector_put_u8(resp, invoke_id));
+        if (err != EP_OK) {
+            EP_ASSERT_OK(edge_vector_put_u8(resp, 0x01));
+            return edge_vector_put_u8(resp, _server_dar(err));
+        }
+        EP_ASSERT_OK(edge_vector_put_u8(resp, 0x00));
+        return edge_vector_append_ref(resp, ctx->block_ctx.buf, ctx->block_ctx.block_len);
+    }
+    ctx->block_ctx.stream = res;
+    ctx->block_ctx.desc = *desc;
+    ctx->block_ctx.done = done;
+    ctx->block_ctx.current_block = 1;
+    return _server_put_block(ctx, invoke_id, resp);
+}
+
+// --- GET ---
+
+/**
+ * @brief 编码一个 Get-Data-Result：[0] data 或 [1] data-access-result
+ * 回调收到的是请求的描述符 (属性 0 通配资源据此区分属性)。
+ */
+static edge_error_t _server_get_item(edge_dlms_context_t *ctx, const edge_dlms_object_t *desc, bool valid, bool selective, edge_vector_t *resp) {
+    const edge_dlms_resource_t *res = _server_lookup(ctx, desc, valid);
+    edge_dlms_variant_t val = {0};
+    uint8_t dar;
+    if (!res) dar = DLMS_DAR_OBJECT_UNDEFINED;
+    else if (selective) dar = DLMS_DAR_SCOPE_OF_ACCESS_VIOLATED;
+    else if (!res->on_get && res->on_stream) {
+        // 列表项不能单独分块：生成结果须一次装进块缓冲区，随后拷入响应 (缓冲区供下一项复用)
+        bool done = false;
+        edge_error_t err = _server_stream_fill(ctx, res, desc, true, &done);
+        if (err == EP_OK && !ctx->block_ctx.block_len) err = EP_ERR_GENERIC;
+        dar = err != EP_OK ? _server_dar(err) : done ? DLMS_DAR_SUCCESS : DLMS_DAR_OTHER_REASON;
+        if (dar == DLMS_DAR_SUCCESS) {
+            EP_ASSERT_OK(edge_vector_put_u8(resp, 0x00));
+            return edge_vector_append_copy(resp, ctx->block_ctx.buf, ctx->block_ctx.block_len);
+        }
+    }
+    else if (!res->on_get) dar = DLMS_DAR_READ_WRITE_DENIED;
+    else {
+        edge_error_t err = res->on_get(desc, &val, res->user_data);
+        dar = _server_dar(err == EP_OK ? _server_check_data(&val) : err);
+    }
+    if (dar != DLMS_DAR_SUCCESS) {
+        EP_ASSERT_OK(edge_vector_put_u8(resp, 0x01));
+        return edge_vector_put_u8(resp, dar);
+    }
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x00));
+    return _server_put_data(resp, &val);
+}
+
+
+/**
+ * @brief GET-Request-Next：确认块号等于当前块时续跑生成器；等于上一块时重发缓冲区中的当前块
+ */
+static edge_error_t _server_get_next(edge_dlms_context_t *ctx, uint8_t invoke_id, uint32_t block, edge_vector_t *resp) {
+    if (!ctx->block_ctx.stream) return _server_abort_block(ctx, invoke_id, DLMS_DAR_NO_LONG_GET_IN_PROGRESS, resp);
+    if (block + 1 == ctx->block_ctx.current_block) return _server_put_block(ctx, invoke_id, resp);
+    if (block != ctx->block_ctx.current_block) return _server_abort_block(ctx, invoke_id, DLMS_DAR_DATA_BLOCK_NUMBER_INVALID, resp);
+    if (ctx->block_ctx.done) return _server_abort_block(ctx, invoke_id, DLMS_DAR_NO_LONG_GET_IN_PROGRESS, resp);
+
+    edge_error_t err = _server_stream_fill(ctx, ctx->block_ctx.stream, &ctx->block_ctx.desc, false, &ctx->block_ctx.done);
+    ctx->block_ctx.current_block++;
+    if (err != EP_OK) return _server_abort_block(ctx, invoke_id, DLMS_DAR_LONG_GET_ABORTED, resp);
+    return _server_put_block(ctx, invoke_id, resp);
+}
+
+static edge_error_t _server_get(edge_dlms_context_t *ctx, edge_cursor_t *req, uint8_t type, uint8_t invoke_id, edge_vector_t *resp) {
+    edge_dlms_object_t desc; bool valid, selective;
+    if (type == DLMS_GET_NEXT) {
+        uint32_t block;
+        EP_ASSERT_OK(edge_cursor_read_be32(req, &block));
+        return _server_get_next(ctx, invoke_id, block, resp);
+    }
+    if (type != DLMS_GET_NORMAL && type != DLMS_GET_WITH_LIST) return EP_ERR_NOT_SUPPORTED;
+    ctx->block_ctx.stream = NULL; // 新的 GET 终止进行中的分块传输
+
+    if (type == DLMS_GET_NORMAL) {
+        EP_ASSERT_OK(_server_read_desc(req, false, &desc, &valid));
+        EP_ASSERT_OK(_server_read_selection(req, true, &selective));
+        const edge_dlms_resource_t *res = _server_lookup(ctx, &desc, valid);
+        if (res && !selective && !res->on_get && res->on_stream) return _server_stream_begin(ctx, res, &desc, invoke_id, resp);
+    }
+    EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_GET_RESPONSE));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, type));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, invoke_id));
+    if (type == DLMS_GET_NORMAL) return _server_get_item(ctx, &desc, valid, selective, resp);
+
+    // GET-Response-With-List 与请求逐项对应，结果直接编码进同一响应
+    size_t count;
+    EP_ASSERT_OK(_server_read_len(req, &count));
+    EP_ASSERT_OK(_server_put_len(resp, count));
+    for (size_t i = 0; i < count; i++) {
+        EP_ASSERT_OK(_server_read_desc(req, false, &desc, &valid));
+        EP_ASSERT_OK(_server_read_selection(req, false, &selective));
+        EP_ASSERT_OK(_server_get_item(ctx, &desc, valid, selective, resp));
+    }
+    return EP_OK;
+}
+
+// --- SET ---
+
+static uint8_t _server_set_item(edge_dlms_context_t *ctx, const edge_dlms_object_t *desc, bool valid, bool selective, const edge_dlms_variant_t *val) {
+    const edge_dlms_resource_t *res = _server_lookup(ctx, desc, valid);
+    if (!res) return DLMS_DAR_OBJECT_UNDEFINED;
+    if (selective) return DLMS_DAR_SCOPE_OF_ACCESS_VIOLATED;
+    if (!res->on_set) return DLMS_DAR_READ_WRITE_DENIED;
+    if (val->length && !val->data) return DLMS_DAR_OTHER_REASON; // 值跨段，无法零拷贝交给回调
+    edge_dlms_variant_t v = *val;
+    return _server_dar(res->on_set(desc, &v, res->user_data));
+}
+
+static edge_error_t _server_set(edge_dlms_context_t *ctx, edge_cursor_t *req, uint8_t type, uint8_t invoke_id, edge_vector_t *resp) {
+    edge_dlms_object_t desc; edge_dlms_variant_t val; bool valid, selective;
+    if (type == DLMS_SET_NORMAL) {
+        EP_ASSERT_OK(_server_read_desc(req, false, &desc, &valid));
+        EP_ASSERT_OK(_server_read_selection(req, false, &selective));
+        EP_ASSERT_OK(_server_take_data(req, &val));
+        EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_SET_RESPONSE));
+        EP_ASSERT_OK(edge_vector_put_u8(resp, 0x01));
+        EP_ASSERT_OK(edge_vector_put_u8(resp, invoke_id));
+        return edge_vector_put_u8(resp, _server_set_item(ctx, &desc, valid, selective, &val));
+    }
+    if (type != DLMS_SET_WITH_LIST) return EP_ERR_NOT_SUPPORTED;
+
+    // 描述符表在前、值表在后：先越过描述符表定位值表，再以两个 cursor 并行逐项处理
+    size_t count, values;
+    EP_ASSERT_OK(_server_read_len(req, &count));
+    edge_cursor_t descs = *req;
+    for (size_t i = 0; i < count; i++) {
+        EP_ASSERT_OK(_server_read_desc(req, false, &desc, &valid));
+        EP_ASSERT_OK(_server_read_selection(req, false, &selective));
+    }
+    EP_ASSERT_OK(_server_read_len(req, &values));
+    if (values != count) return EP_ERR_INVALID_FRAME;
+
+    EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_SET_RESPONSE));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x05)); // Set-Response-With-List
+    EP_ASSERT_OK(edge_vector_put_u8(resp, invoke_id));
+    EP_ASSERT_OK(_server_put_len(resp, count));
+    for (size_t i = 0; i < count; i++) {
+        EP_ASSERT_OK(_server_read_desc(&descs, false, &desc, &valid));
+        EP_ASSERT_OK(_server_read_selection(&descs, false, &selective));
+        EP_ASSERT_OK(_server_take_data(req, &val));
+        EP_ASSERT_OK(edge_vector_put_u8(resp, _server_set_item(ctx, &desc, valid, selective, &val)));
+    }
+    return EP_OK;
+}
+
+// --- ACTION ---
+
+static edge_error_t _server_action(edge_dlms_context_t *ctx, edge_cursor_t *req, uint8_t type, uint8_t invoke_id, edge_vector_t *resp) {
+    edge_dlms_object_t desc; bool valid;
+    edge_dlms_variant_t params = {0}, ret = {0};
+    uint8_t present;
+    if (type != DLMS_ACTION_NORMAL) return EP_ERR_NOT_SUPPORTED;
+    EP_ASSERT_OK(_server_read_desc(req, true, &desc, &valid));
+    EP_ASSERT_OK(edge_cursor_read_u8(req, &present));
+    if (present) EP_ASSERT_OK(_server_take_data(req, &params));
+
+    const edge_dlms_resource_t *res = _server_lookup(ctx, &desc, valid);
+    uint8_t result;
+    if (!res) result = DLMS_DAR_OBJECT_UNDEFINED;
+    else if (!res->on_action) result = DLMS_DAR_READ_WRITE_DENIED;
+    else if (params.length && !params.data) result = DLMS_DAR_OTHER_REASON;
+    else {
+        edge_error_t err = res->on_action(&desc, &params, &ret, res->user_data);
+        result = _server_dar(err == EP_OK ? _server_check_data(&ret) : err);
+    }
+
+    EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)DLMS_APDU_ACTION_RESPONSE));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x01));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, invoke_id));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, result));
+    // return-parameters OPTIONAL：仅成功且回调给出非 null 值时携带 Get-Data-Result [0] data
+    if (result != DLMS_DAR_SUCCESS || ret.tag == DLMS_TAG_NULL_DATA) return edge_vector_put_u8(resp, 0x00);
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x01));
+    EP_ASSERT_OK(edge_vector_put_u8(resp, 0x00));
+    return _server_put_data(resp, &ret);
+}
+
+/**
+ * @brief DLMS 从站 PDU 分发引擎
+ */
+static edge_error_t _server_dispatch(edge_dlms_context_t *ctx, edge_cursor_t *req, edge_vector_t *resp) {
+    uint8_t service_tag, type, invoke_id;
+    EP_ASSERT_OK(edge_cursor_read_u8(req, &service_tag));
+    EP_ASSERT_OK(edge_cursor_read_u8(req, &type));
+    EP_ASSERT_OK(edge_cursor_read_u8(req, &invoke_id));
+
+    switch (service_tag) {
+        case DLMS_APDU_GET_REQUEST: return _server_get(ctx, req, type, invoke_id, resp);
+        case DLMS_APDU_SET_REQUEST: return _server_set(ctx, req, type, invoke_id, resp);
+        case DLMS_APDU_ACTION_REQUEST: return _server_action(ctx, req, type, invoke_id, resp);
+        default: return EP_ERR_NOT_SUPPORTED;
+    }
+}
+
+edge_error_t edge_dlms_server_dispatch(edge_dlms_context_t *ctx, edge_cursor_t *req, edge_vector_t *resp) {
+    if (!ctx || !req || !resp) return EP_ERR_INVALID_ARG;
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _server_dispatch(ctx, req, resp);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
+
+void edge_dlms_server_set_block_buffer(edge_dlms_context_t *ctx, uint8_t *buf, size_t buf_size) {
+    if (!ctx) return;
+    ctx->block_ctx.stream = NULL;
+    ctx->block_ctx.buf = buf;
+    ctx->block_ctx.buf_size = buf ? buf_size : 0;
+}
@@ -1,4 +1,5 @@
 #include "protocols/edge_dlt645.h"
+#include "common/stats.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -16,9 +17,13 @@ void edge_dlt645_init(edge_dlt645_context_t *ctx, const char *addr_str) {
         sscanf(addr_str + (5 - i) * 2, "%02X", &val);
         ctx->addr_bcd[i] = (uint8_t)val;
     }
+#if EDGE_ENABLE_STATS
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+#endif
 }
 
-edge_error_t edge_dlt645_build_read_req(edge_dlt645_context_t *ctx, edge_vector_t *v, uint32_t di) {
+static edge_error_t _build_read_req(edge_dlt645_context_t *ctx, edge_vector_t *v, uint32_t di) {
+    edge_vector_check_begin(v, EDGE_CHECK_SUM8);
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x68));
     EP_ASSERT_OK(edge_vector_append_copy(v, ctx->addr_bcd, 6));
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x68));
@@ -34,25 +39,31 @@ edge_error_t edge_dlt645_build_read_req(edge_dlt645_context_t *ctx, edge_vector_
     EP_ASSERT_OK(edge_vector_append_copy(v, di_bytes, 4));
     
     // CS
-    uint8_t cs = 0;
-    for (int i = 0; i < v->used_count; i++) {
-        for (size_t j = 0; j < v->iovs[i].iov_len; j++) {
-            cs += ((uint8_t*)v->iovs[i].iov_base)[j];
-        }
-    }
+    uint8_t cs = (uint8_t)edge_vector_check_value(v);
+    edge_vector_check_end(v);
     EP_ASSERT_OK(edge_vector_put_u8(v, cs));
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x16)); // End
     
     return EP_OK;
 }
 
-edge_error_t edge_dlt645_parse_frame(edge_dlt645_context_t *ctx, edge_cursor_t *c, uint32_t *out_di, const uint8_t **out_data, size_t *out_len) {
+edge_error_t edge_dlt645_build_read_req(edge_dlt645_context_t *ctx, edge_vector_t *v, uint32_t di) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _build_read_req(ctx, v, di);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_TX, err, t0);
+    return err;
+}
+
+static edge_error_t _parse_frame(edge_dlt645_context_t *ctx, edge_cursor_t *c, uint32_t *out_di, const uint8_t **out_data, size_t *out_len) {
     uint8_t b;
-    // Skip FE
-    while (edge_cursor_remaining(c) > 0) {
-        edge_cursor_read_u8(c, &b);
-        if (b == 0x68) break;
-    }
+    // Skip FE 前导及噪声
+    static const uint8_t start = 0x68;
+    size_t skipped = 0;
+    edge_error_t found = edge_cursor_scan(c, &start, 1, &skipped);
+    EDGE_STATS_ADD(ctx, EDGE_STAT_RESYNC_BYTES, skipped);
+    (void)ctx;
+    if (found != EP_OK) return EP_ERR_INCOMPLETE_DATA;
+    EP_ASSERT_OK(edge_cursor_skip(c, 1));
     
     if (edge_cursor_remaining(c) < 11) return EP_ERR_INCOMPLETE_DATA;
     
@@ -78,3 +89,33 @@ edge_error_t edge_dlt645_parse_frame(edge_dlt645_context_t *ctx, edge_cursor_t *
     
     return EP_OK;
 }
+
+edge_error_t edge_dlt645_parse_frame(edge_dlt645_context_t *ctx, edge_cursor_t *c, uint32_t *out_di, const uint8_t **out_data, size_t *out_len) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _parse_frame(ctx, c, out_di, out_data, out_len);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
+
+/**
+ * @brief 数据标识按字节 +0x33 后的线路值 (小端)
+ */
+static uint32_t _encode_di(uint32_t di) {
+    uint32_t enc = 0;
+    for (int i = 0; i < 4; i++) enc |= (uint32_t)(uint8_t)(((di >> (8 * i)) & 0xFF) + 0x33) << (8 * i);
+    return enc;
+}
+
+edge_error_t edge_dlt645_template_read_req(edge_dlt645_context_t *ctx, edge_frame_template_t *t, uint32_t di) {
+    if (!ctx || !t) return EP_ERR_INVALID_ARG;
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    EP_ASSERT_OK(_build_read_req(ctx, &v, di));
+    EP_ASSERT_OK(edge_template_capture(t, &v));
+    EP_ASSERT_OK(edge_template_add_field(t, 10, 4, false));
+    return edge_template_add_check(t, EDGE_CHECK_SUM8, 0, 14, 14);
+}
+
+edge_error_t edge_dlt645_template_emit(edge_frame_template_t *t, uint32_t di, edge_vector_t *v) {
+    EP_ASSERT_OK(edge_template_set(t, 0, _encode_di(di)));
+    return edge_template_emit(t, v);
+}
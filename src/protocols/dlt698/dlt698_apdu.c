@@ -1,16 +1,4 @@
-#include "edge_core.h"
-
-/**
- * @brief DL/T 698.45 Service Tags
- */
-typedef enum {
-    D698_SERVICE_GET_REQUEST    = 0x05,
-    D698_SERVICE_GET_RESPONSE   = 0x85,
-    D698_SERVICE_SET_REQUEST    = 0x06,
-    D698_SERVICE_SET_RESPONSE   = 0x86,
-    D698_SERVICE_ACTION_REQUEST = 0x07,
-    D698_SERVICE_REPORT_NOTIF   = 0x88
-} d698_service_tag_t;
+#include "protocols/edge_dlt698.h"
 
 /**
  * @brief 构建 GET-Request-Normal
@@ -1,21 +1,6 @@
-#include "edge_core.h"
+#include "protocols/edge_dlt698.h"
 #include <string.h>
 
-/**
- * @brief DL/T 698.45 Data Tags
- */
-typedef enum {
-    D698_TAG_NULL       = 0,
-    D698_TAG_ARRAY      = 1,
-    D698_TAG_STRUCTURE  = 2,
-    D698_TAG_BOOL       = 3,
-    D698_TAG_BITSTRING  = 4,
-    D698_TAG_DOUBLE_LONG = 5, // int32
-    D698_TAG_OCTET_STRING = 9,
-    D698_TAG_LONG_UNSIGNED = 18, // uint16
-    D698_TAG_ENUM       = 22
-} d698_data_tag_t;
-
 /**
  * @brief 编码 698 变长整数 (OAD 等)
  */
@@ -29,11 +29,13 @@ edge_error_t dnp3_parse_object_header(edge_cursor_t *c, dnp3_object_header_t *he
     uint8_t q_code = head->qualifier & 0x0F;
     if (q_code == 0x00) { // 1-byte start/stop
         uint8_t s, e;
-        edge_cursor_read_u8(c, &s); edge_cursor_read_u8(c, &e);
+        EP_ASSERT_OK(edge_cursor_read_u8(c, &s));
+        EP_ASSERT_OK(edge_cursor_read_u8(c, &e));
         head->range_start = s; head->range_stop = e;
     } else if (q_code == 0x01) { // 2-byte start/stop
         uint16_t s, e;
-        edge_cursor_read_be16(c, &s); edge_cursor_read_be16(c, &e);
+        EP_ASSERT_OK(edge_cursor_read_be16(c, &s));
+        EP_ASSERT_OK(edge_cursor_read_be16(c, &e));
         head->range_start = s; head->range_stop = e;
     }
     
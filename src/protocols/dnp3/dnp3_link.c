@@ -1,14 +1,18 @@
 #include "libedge/edge_dnp3.h"
 #include "common/crc.h"
+#include "common/stats.h"
 #include <string.h>
 
 void edge_dnp3_init(edge_dnp3_context_t *ctx, uint16_t src, uint16_t dest) {
     if (!ctx) return;
     ctx->src_addr = src;
     ctx->dest_addr = dest;
+#if EDGE_ENABLE_STATS
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+#endif
 }
 
-edge_error_t edge_dnp3_build_link_frame(edge_dnp3_context_t *ctx, edge_vector_t *v, uint8_t func, const void *payload, size_t len) {
+static edge_error_t _build_link_frame(edge_dnp3_context_t *ctx, edge_vector_t *v, uint8_t func, const void *payload, size_t len) {
     if (len > 250) return EP_ERR_OUT_OF_BOUNDS;
 
     uint8_t header[10];
@@ -43,3 +47,10 @@ edge_error_t edge_dnp3_build_link_frame(edge_dnp3_context_t *ctx, edge_vector_t
 
     return EP_OK;
 }
+
+edge_error_t edge_dnp3_build_link_frame(edge_dnp3_context_t *ctx, edge_vector_t *v, uint8_t func, const void *payload, size_t len) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _build_link_frame(ctx, v, func, payload, len);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_TX, err, t0);
+    return err;
+}
@@ -1,91 +1,64 @@
 #include "libedge/edge_dnp3.h"
-#include "common/crc.h"
-#include <string.h>
+#include "common/stats.h"
 
-typedef enum {
-    DNP3_RX_STATE_SYNC1,
-    DNP3_RX_STATE_SYNC2,
-    DNP3_RX_STATE_HEADER,
-    DNP3_RX_STATE_DATA_BLOCK,
-    DNP3_RX_STATE_CRC
-} dnp3_rx_state_t;
+edge_error_t edge_dnp3_link_unpack(edge_cursor_t *c, edge_dnp3_link_header_t *hdr,
+                                   struct iovec *blocks, int max_blocks, edge_cursor_t *user) {
+    static const uint8_t sync[2] = { 0x05, 0x64 };
+    if (!c || !hdr || !blocks || !user) return EP_ERR_INVALID_ARG;
+    if (edge_cursor_scan(c, sync, 2, NULL) != EP_OK) return EP_ERR_INCOMPLETE_DATA;
+    if (edge_cursor_remaining(c) < 10) return EP_ERR_INCOMPLETE_DATA;
 
-typedef struct {
-    dnp3_rx_state_t state;
-    uint8_t header[10];
-    uint8_t header_pos;
-    uint8_t payload_len;
-    uint8_t block_pos;
-    uint16_t current_crc;
-} dnp3_link_rx_t;
+    edge_cursor_t frame = *c;
+    uint16_t crc, r_crc;
+    EP_ASSERT_OK(edge_cursor_checksum(&frame, EDGE_CHECK_CRC16_DNP3, 8, &crc));
+    uint8_t h[8];
+    EP_ASSERT_OK(edge_cursor_read_bytes(&frame, h, 8));
+    EP_ASSERT_OK(edge_cursor_read_le16(&frame, &r_crc));
+    if (crc != r_crc || h[2] < 5) {
+        edge_cursor_skip(c, 2); // 伪同步头：越过后重新搜索
+        return EP_ERR_CHECKSUM;
+    }
+    size_t user_len = (size_t)h[2] - 5;
+    size_t nblk = (user_len + 15) / 16;
+    if (edge_cursor_remaining(&frame) < user_len + nblk * 2) return EP_ERR_INCOMPLETE_DATA;
+
+    int used = 0;
+    for (size_t rem = user_len; rem > 0; ) {
+        size_t chunk = (rem > 16) ? 16 : rem;
+        int n;
+        EP_ASSERT_OK(edge_cursor_checksum(&frame, EDGE_CHECK_CRC16_DNP3, chunk, &crc));
+        EP_ASSERT_OK(edge_cursor_slice_iov(&frame, chunk, blocks + used, max_blocks - used, &n));
+        EP_ASSERT_OK(edge_cursor_read_le16(&frame, &r_crc));
+        if (crc != r_crc) { *c = frame; return EP_ERR_CHECKSUM; }
+        used += n; rem -= chunk;
+    }
+    hdr->length = h[2]; hdr->control = h[3];
+    hdr->dest_addr = (uint16_t)(h[4] | (h[5] << 8));
+    hdr->src_addr = (uint16_t)(h[6] | (h[7] << 8));
+    edge_cursor_init(user, blocks, used);
+    *c = frame;
+    return EP_OK;
+}
 
-/**
- * @brief 专家级 DNP3 链路层流式解析器
- * 特性：零拷贝、支持跨 iovec 段解析、每 16 字节强制 CRC 校验
- */
-edge_error_t edge_dnp3_parse_stream(dnp3_link_rx_t *rx, edge_cursor_t *c, uint8_t *out_buf, size_t *out_len) {
-    while (edge_cursor_remaining(c) > 0) {
-        uint8_t b;
-        switch (rx->state) {
-            case DNP3_RX_STATE_SYNC1:
-                edge_cursor_read_u8(c, &b);
-                if (b == 0x05) rx->state = DNP3_RX_STATE_SYNC2;
-                break;
-            case DNP3_RX_STATE_SYNC2:
-                edge_cursor_read_u8(c, &b);
-                if (b == 0x64) {
-                    rx->state = DNP3_RX_STATE_HEADER;
-                    rx->header_pos = 2; // 已读 0x05 0x64
-                    rx->header[0] = 0x05; rx->header[1] = 0x64;
-                } else rx->state = DNP3_RX_STATE_SYNC1;
-                break;
-            case DNP3_RX_STATE_HEADER:
-                // 填充剩余 8 字节 Header (Len, Ctrl, Dest, Src, CRC)
-                while (rx->header_pos < 10 && edge_cursor_remaining(c) > 0) {
-                    edge_cursor_read_u8(c, &rx->header[rx->header_pos++]);
-                }
-                if (rx->header_pos == 10) {
-                    // 校验 Header CRC
-                    uint16_t h_crc = (uint16_t)(rx->header[8] | (rx->header[9] << 8));
-                    if (edge_crc16_dnp3(rx->header, 8) != h_crc) {
-                        rx->state = DNP3_RX_STATE_SYNC1;
-                        return EP_ERR_CHECKSUM;
-                    }
-                    rx->payload_len = (uint8_t)(rx->header[2] - 5);
-                    rx->state = DNP3_RX_STATE_DATA_BLOCK;
-                    rx->block_pos = 0;
-                }
-                break;
-            case DNP3_RX_STATE_DATA_BLOCK: {
-                // 读取最多 16 字节的数据块
-                size_t rem_in_block = (rx->payload_len > 16) ? 16 : rx->payload_len;
-                // 此处体现高质量：直接从 Cursor 提取 contiguous 指针以减少拷贝
-                const void* ptr = edge_cursor_get_ptr(c, rem_in_block - rx->block_pos);
-                if (ptr) {
-                    memcpy(out_buf + rx->block_pos, ptr, rem_in_block - rx->block_pos);
-                    rx->block_pos = (uint8_t)rem_in_block;
-                } else {
-                    // 如果跨 iovec 段，则逐字节读 (或者分段拷贝)
-                    edge_cursor_read_u8(c, &out_buf[rx->block_pos++]);
-                }
-                
-                if (rx->block_pos == rem_in_block) {
-                    rx->state = DNP3_RX_STATE_CRC;
-                    rx->current_crc = edge_crc16_dnp3(out_buf, rem_in_block);
-                }
-                break;
-            }
-            case DNP3_RX_STATE_CRC: {
-                uint16_t r_crc;
-                if (edge_cursor_read_be16(c, &r_crc) == EP_OK) {
-                    if (rx->current_crc != r_crc) return EP_ERR_CHECKSUM;
-                    // ... 继续解析下一个 16 字节块直到 payload_len 为 0 ...
-                    rx->state = DNP3_RX_STATE_SYNC1; // 演示完成
-                    return EP_OK;
-                }
-                break;
-            }
+edge_error_t edge_dnp3_link_recv(edge_dnp3_context_t *ctx, edge_cursor_t *c, edge_dnp3_link_header_t *hdr,
+                                 struct iovec *blocks, int max_blocks, edge_cursor_t *user) {
+    if (!ctx) return EP_ERR_INVALID_ARG;
+#if EDGE_ENABLE_STATS
+    size_t before = c ? c->total_read : 0;
+#endif
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = edge_dnp3_link_unpack(c, hdr, blocks, max_blocks, user);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_RX, err, t0);
+#if EDGE_ENABLE_STATS
+    if (c) {
+        // 前进量扣除成功帧本身 (头 10 字节 + 用户数据 + 每块 2 字节 CRC) 即为丢弃的噪声
+        size_t moved = c->total_read - before;
+        if (err == EP_OK) {
+            size_t user_len = (size_t)hdr->length - 5;
+            moved -= 10 + user_len + ((user_len + 15) / 16) * 2;
         }
+        if (err == EP_OK || err == EP_ERR_INCOMPLETE_DATA) EDGE_STATS_ADD(ctx, EDGE_STAT_RESYNC_BYTES, moved);
     }
-    return EP_ERR_INCOMPLETE_DATA;
+#endif
+    return err;
 }
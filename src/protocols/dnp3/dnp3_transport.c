@@ -1,4 +1,4 @@
-#include "edge_core.h"
+#include "libedge/edge_dnp3.h"
 
 /**
  * @brief DNP3 传输层控制字节
@@ -23,3 +23,9 @@ edge_error_t dnp3_transport_wrap(dnp3_transport_ctx_t *ctx, edge_vector_t *v, bo
     ctx->seq = (uint8_t)((ctx->seq + 1) & DNP3_TR_SEQ_MASK);
     return EP_OK;
 }
+
+edge_error_t edge_dnp3_transport_unpack(edge_cursor_t *user, uint8_t *th, edge_cursor_t *app) {
+    if (!user || !th || !app) return EP_ERR_INVALID_ARG;
+    EP_ASSERT_OK(edge_cursor_read_u8(user, th));
+    return edge_cursor_slice(user, edge_cursor_remaining(user), app);
+}
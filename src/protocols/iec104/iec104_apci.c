@@ -1,10 +1,11 @@
 #include "libedge/edge_iec104.h"
+#include "common/stats.h"
 #include <string.h>
 
 /**
  * @brief 构建 S 帧 (确认帧) - 严格遵循小端编码
  */
-edge_error_t edge_iec104_build_s_frame(edge_vector_t *v, edge_iec104_context_t *ctx) {
+static edge_error_t _build_s_frame(edge_vector_t *v, edge_iec104_context_t *ctx) {
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x68));
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x04));
     EP_ASSERT_OK(edge_vector_put_u8(v, 0x01)); 
@@ -13,6 +14,22 @@ edge_error_t edge_iec104_build_s_frame(edge_vector_t *v, edge_iec104_context_t *
     return EP_OK;
 }
 
+edge_error_t edge_iec104_build_s_frame(edge_vector_t *v, edge_iec104_context_t *ctx) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _build_s_frame(v, ctx);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_TX, err, t0);
+    return err;
+}
+
+bool edge_iec104_window_open(edge_iec104_context_t *ctx) {
+    if (!ctx) return false;
+    uint16_t outstanding = (uint16_t)((ctx->v_s - ctx->v_a) & 0x7FFF);
+    uint8_t k = ctx->k ? ctx->k : 12;
+    if (outstanding < k) return true;
+    EDGE_STATS_ADD(ctx, EDGE_STAT_WINDOW_STALLS, 1);
+    return false;
+}
+
 /**
  * @brief 工业级解析 APCI - 使用小端读取控制域
  */
@@ -29,3 +46,31 @@ edge_error_t edge_iec104_parse_apci(edge_cursor_t *c, uint16_t *ctrl1, uint16_t
     
     return EP_OK;
 }
+
+/**
+ * @brief [零拷贝] 解析 APCI，并以 asdu 子 cursor 指向长度域界定的 ASDU (U/S 帧为空)
+ */
+edge_error_t edge_iec104_parse_apdu(edge_cursor_t *c, uint16_t *ctrl1, uint16_t *ctrl2, edge_cursor_t *asdu) {
+    uint8_t start, len;
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &start));
+    if (start != 0x68) return EP_ERR_INVALID_FRAME;
+    EP_ASSERT_OK(edge_cursor_read_u8(c, &len));
+    if (len < 4) return EP_ERR_INVALID_FRAME;
+    EP_ASSERT_OK(edge_cursor_read_le16(c, ctrl1));
+    EP_ASSERT_OK(edge_cursor_read_le16(c, ctrl2));
+    return edge_cursor_slice(c, (size_t)len - 4, asdu);
+}
+
+edge_error_t edge_iec104_template_s_frame(edge_iec104_context_t *ctx, edge_frame_template_t *t) {
+    if (!ctx || !t) return EP_ERR_INVALID_ARG;
+    struct iovec iov[2]; edge_vector_t v; edge_vector_init(&v, iov, 2);
+    EP_ASSERT_OK(_build_s_frame(&v, ctx));
+    EP_ASSERT_OK(edge_template_capture(t, &v));
+    return edge_template_add_field(t, 4, 2, false);
+}
+
+edge_error_t edge_iec104_template_emit_s(edge_iec104_context_t *ctx, edge_frame_template_t *t, edge_vector_t *v) {
+    if (!ctx) return EP_ERR_INVALID_ARG;
+    EP_ASSERT_OK(edge_template_set(t, 0, (uint32_t)(ctx->v_r << 1)));
+    return edge_template_emit(t, v);
+}
@@ -1,14 +1,18 @@
 #include "libedge/edge_iec104.h"
+#include "common/stats.h"
 #include <string.h>
 
 /**
  * @brief 处理接收到的有效控制域
  */
-edge_error_t edge_iec104_session_on_recv(edge_iec104_context_t *ctx, edge_cursor_t *c, edge_vector_t *resp) {
+static edge_error_t _session_on_recv(edge_iec104_context_t *ctx, edge_cursor_t *c, edge_vector_t *resp, edge_cursor_t *asdu_out) {
     uint16_t ctrl1, ctrl2;
+    edge_cursor_t asdu;
     
-    // 1. 调用高质量解析器提取控制域 (内部处理小端转换)
-    EP_ASSERT_OK(edge_iec104_parse_apci(c, &ctrl1, &ctrl2));
+    // 1. 调用高质量解析器提取控制域 (内部处理小端转换)，同时整帧出队
+    EP_ASSERT_OK(edge_iec104_parse_apdu(c, &ctrl1, &ctrl2, &asdu));
+    // ASDU 以子 cursor 交给上层 (S/U 帧为空)
+    if (asdu_out) *asdu_out = asdu;
 
     if (ctrl1 & 0x01) {
         if (ctrl1 & 0x02) { // U-Frame
@@ -27,3 +31,10 @@ edge_error_t edge_iec104_session_on_recv(edge_iec104_context_t *ctx, edge_cursor
     
     return EP_OK;
 }
+
+edge_error_t edge_iec104_session_on_recv(edge_iec104_context_t *ctx, edge_cursor_t *c, edge_vector_t *resp, edge_cursor_t *asdu_out) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _session_on_recv(ctx, c, resp, asdu_out);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
@@ -1,5 +1,5 @@
 #include "protocols/edge_modbus.h"
-#include "common/crc.h"
+#include "common/stats.h"
 #include <string.h>
 
 void edge_modbus_init(edge_modbus_context_t *ctx, uint8_t slave_id, bool is_tcp) {
@@ -7,11 +7,12 @@ void edge_modbus_init(edge_modbus_context_t *ctx, uint8_t slave_id, bool is_tcp)
     ctx->slave_id = slave_id;
     ctx->is_tcp = is_tcp;
     ctx->transaction_id = 0;
+#if EDGE_ENABLE_STATS
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+#endif
 }
 
-edge_error_t edge_modbus_build_read_holding_req(edge_modbus_context_t *ctx, edge_vector_t *v, uint16_t addr, uint16_t quantity) {
-    if (!ctx || !v) return EP_ERR_INVALID_ARG;
-
+static edge_error_t _build_read(edge_modbus_context_t *ctx, edge_vector_t *v, uint8_t fc, uint16_t addr, uint16_t quantity) {
     if (ctx->is_tcp) {
         ctx->transaction_id++;
         EP_ASSERT_OK(edge_vector_put_be16(v, ctx->transaction_id));
@@ -19,23 +20,37 @@ edge_error_t edge_modbus_build_read_holding_req(edge_modbus_context_t *ctx, edge
         EP_ASSERT_OK(edge_vector_put_be16(v, 6));
     }
 
+    if (!ctx->is_tcp) edge_vector_check_begin(v, EDGE_CHECK_CRC16_MODBUS);
     EP_ASSERT_OK(edge_vector_put_u8(v, ctx->slave_id));
-    EP_ASSERT_OK(edge_vector_put_u8(v, MODBUS_FC_READ_HOLDING_REGISTERS));
+    EP_ASSERT_OK(edge_vector_put_u8(v, fc));
     EP_ASSERT_OK(edge_vector_put_be16(v, addr));
     EP_ASSERT_OK(edge_vector_put_be16(v, quantity));
 
     if (!ctx->is_tcp) {
-        uint16_t crc = 0xFFFF;
-        for (int i = 0; i < v->used_count; i++) {
-            crc = edge_crc16_modbus_update(crc, v->iovs[i].iov_base, v->iovs[i].iov_len);
-        }
-        uint8_t crc_bytes[2] = { (uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8) };
-        EP_ASSERT_OK(edge_vector_append_copy(v, crc_bytes, 2));
+        uint16_t crc = edge_vector_check_value(v);
+        edge_vector_check_end(v);
+        EP_ASSERT_OK(edge_vector_put_le16(v, crc));
     }
     return EP_OK;
 }
 
-edge_error_t edge_modbus_parse_response(edge_modbus_context_t *ctx, edge_cursor_t *c, uint8_t *out_fc, const uint8_t **out_data, size_t *out_len) {
+edge_error_t edge_modbus_build_read_holding_req(edge_modbus_context_t *ctx, edge_vector_t *v, uint16_t addr, uint16_t quantity) {
+    if (!ctx || !v) return EP_ERR_INVALID_ARG;
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _build_read(ctx, v, MODBUS_FC_READ_HOLDING_REGISTERS, addr, quantity);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_TX, err, t0);
+    return err;
+}
+
+edge_error_t edge_modbus_build_read_req(edge_modbus_context_t *ctx, edge_vector_t *v, uint8_t fc, uint16_t addr, uint16_t quantity) {
+    if (!ctx || !v || fc < MODBUS_FC_READ_COILS || fc > MODBUS_FC_READ_INPUT_REGISTERS) return EP_ERR_INVALID_ARG;
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _build_read(ctx, v, fc, addr, quantity);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_TX, err, t0);
+    return err;
+}
+
+static edge_error_t _parse_response(edge_modbus_context_t *ctx, edge_cursor_t *c, uint8_t *out_fc, const uint8_t **out_data, size_t *out_len) {
     if (ctx->is_tcp) {
         uint16_t tid, pid, len;
         EP_ASSERT_OK(edge_cursor_read_be16(c, &tid));
@@ -62,3 +77,35 @@ edge_error_t edge_modbus_parse_response(edge_modbus_context_t *ctx, edge_cursor_
     *out_data = edge_cursor_get_ptr(c, byte_count);
     return EP_OK;
 }
+
+edge_error_t edge_modbus_parse_response(edge_modbus_context_t *ctx, edge_cursor_t *c, uint8_t *out_fc, const uint8_t **out_data, size_t *out_len) {
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _parse_response(ctx, c, out_fc, out_data, out_len);
+    EDGE_STATS_END(ctx, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
+
+edge_error_t edge_modbus_template_read_holding(edge_modbus_context_t *ctx, edge_frame_template_t *t, uint16_t addr, uint16_t quantity) {
+    if (!ctx || !t) return EP_ERR_INVALID_ARG;
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    uint16_t tid = ctx->transaction_id;
+    EP_ASSERT_OK(_build_read(ctx, &v, MODBUS_FC_READ_HOLDING_REGISTERS, addr, quantity));
+    ctx->transaction_id = tid;
+    EP_ASSERT_OK(edge_template_capture(t, &v));
+
+    size_t pdu = ctx->is_tcp ? 7 : 1; // PDU (功能码) 起始偏移
+    if (ctx->is_tcp) EP_ASSERT_OK(edge_template_add_field(t, 0, 2, true));
+    EP_ASSERT_OK(edge_template_add_field(t, pdu + 1, 2, true));
+    EP_ASSERT_OK(edge_template_add_field(t, pdu + 3, 2, true));
+    if (!ctx->is_tcp) EP_ASSERT_OK(edge_template_add_check(t, EDGE_CHECK_CRC16_MODBUS, 0, 6, 6));
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_template_emit(edge_modbus_context_t *ctx, edge_frame_template_t *t, uint16_t addr, uint16_t quantity, edge_vector_t *v) {
+    if (!ctx || !t) return EP_ERR_INVALID_ARG;
+    int f = 0;
+    if (ctx->is_tcp) EP_ASSERT_OK(edge_template_set(t, f++, ++ctx->transaction_id));
+    EP_ASSERT_OK(edge_template_set(t, f++, addr));
+    EP_ASSERT_OK(edge_template_set(t, f, quantity));
+    return edge_template_emit(t, v);
+}
@@ -0,0 +1,143 @@
+#include "protocols/edge_modbus.h"
+#include "common/stats.h"
+#include <string.h>
+
+#define _PIPE_MASK (EDGE_MODBUS_PIPE_SLOTS - 1)
+#define _NO_DEADLINE UINT64_MAX
+
+void edge_modbus_pipeline_init(edge_modbus_pipeline_t *p, uint16_t max_inflight, uint8_t unit_limit, uint32_t timeout_ms) {
+    if (!p) return;
+    memset(p, 0, sizeof(*p));
+    p->max_inflight = (max_inflight == 0 || max_inflight > EDGE_MODBUS_PIPE_SLOTS) ? EDGE_MODBUS_PIPE_SLOTS : max_inflight;
+    p->unit_limit = unit_limit;
+    p->timeout_ms = timeout_ms;
+    p->next_deadline = _NO_DEADLINE;
+}
+
+bool edge_modbus_pipeline_can_send(const edge_modbus_pipeline_t *p, uint8_t unit_id) {
+    if (!p || p->inflight >= p->max_inflight) return false;
+    return p->unit_limit == 0 || p->unit_inflight[unit_id] < p->unit_limit;
+}
+
+static void _release(edge_modbus_pipeline_t *p, edge_modbus_txn_t *t) {
+    t->in_use = false;
+    p->inflight--;
+    p->unit_inflight[t->unit_id]--;
+}
+
+static edge_error_t _pipeline_send(edge_modbus_pipeline_t *p, edge_vector_t *v, uint8_t unit_id, uint8_t fc,
+                                   uint16_t addr, uint16_t quantity, uint64_t now_ms, void *user, uint16_t *out_tid) {
+    // 在途数小于槽数，线性探测必能找到空槽；通常第一次即命中
+    uint16_t tid;
+    do { tid = p->next_tid++; } while (p->slots[tid & _PIPE_MASK].in_use);
+
+    EP_ASSERT_OK(edge_vector_put_be16(v, tid));
+    EP_ASSERT_OK(edge_vector_put_be16(v, 0));
+    EP_ASSERT_OK(edge_vector_put_be16(v, 6));
+    EP_ASSERT_OK(edge_vector_put_u8(v, unit_id));
+    EP_ASSERT_OK(edge_vector_put_u8(v, fc));
+    EP_ASSERT_OK(edge_vector_put_be16(v, addr));
+    EP_ASSERT_OK(edge_vector_put_be16(v, quantity));
+
+    edge_modbus_txn_t *t = &p->slots[tid & _PIPE_MASK];
+    t->tid = tid; t->unit_id = unit_id; t->fc = fc;
+    t->addr = addr; t->quantity = quantity;
+    t->deadline_ms = p->timeout_ms ? now_ms + p->timeout_ms : _NO_DEADLINE;
+    t->user = user;
+    t->in_use = true;
+    p->inflight++;
+    p->unit_inflight[unit_id]++;
+    if (t->deadline_ms < p->next_deadline) p->next_deadline = t->deadline_ms;
+    if (out_tid) *out_tid = tid;
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_pipeline_send(edge_modbus_pipeline_t *p, edge_vector_t *v, uint8_t unit_id, uint8_t fc,
+                                       uint16_t addr, uint16_t quantity, uint64_t now_ms, void *user, uint16_t *out_tid) {
+    if (!p || !v || fc < MODBUS_FC_READ_COILS || fc > MODBUS_FC_WRITE_SINGLE_REGISTER) return EP_ERR_INVALID_ARG;
+    if (!edge_modbus_pipeline_can_send(p, unit_id)) {
+        EDGE_STATS_ADD(p, EDGE_STAT_WINDOW_STALLS, 1);
+        return EP_ERR_OVERFLOW;
+    }
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _pipeline_send(p, v, unit_id, fc, addr, quantity, now_ms, user, out_tid);
+    EDGE_STATS_END(p, EDGE_STAT_FRAMES_TX, err, t0);
+    return err;
+}
+
+static edge_error_t _pipeline_on_response(edge_modbus_pipeline_t *p, edge_cursor_t *c, edge_modbus_pipe_result_t *out) {
+    edge_cursor_t t = *c;
+    uint16_t tid, pid, len;
+    uint8_t unit;
+    if (edge_cursor_remaining(&t) < EDGE_MODBUS_MBAP_LEN) return EP_ERR_INCOMPLETE_DATA;
+    EP_ASSERT_OK(edge_cursor_read_be16(&t, &tid));
+    EP_ASSERT_OK(edge_cursor_read_be16(&t, &pid));
+    EP_ASSERT_OK(edge_cursor_read_be16(&t, &len));
+    EP_ASSERT_OK(edge_cursor_read_u8(&t, &unit));
+    if (pid != 0 || len < 3 || len > 254) return EP_ERR_INVALID_FRAME;
+
+    // 整帧到齐后才消费，PDU 以子 cursor 界定
+    edge_cursor_t pdu;
+    EP_ASSERT_OK(edge_cursor_slice(&t, len - 1, &pdu));
+    *c = t;
+
+    edge_modbus_txn_t *txn = &p->slots[tid & _PIPE_MASK];
+    if (!txn->in_use || txn->tid != tid) return EP_ERR_INVALID_STATE;
+
+    uint8_t fc;
+    EP_ASSERT_OK(edge_cursor_read_u8(&pdu, &fc));
+    if (unit != txn->unit_id || (fc & 0x7F) != txn->fc) return EP_ERR_INVALID_FRAME;
+
+    memset(out, 0, sizeof(*out));
+    out->fc = fc & 0x7F;
+    if (fc & 0x80) {
+        EP_ASSERT_OK(edge_cursor_read_u8(&pdu, &out->exception));
+    } else if (fc <= MODBUS_FC_READ_INPUT_REGISTERS) {
+        uint8_t byte_count;
+        EP_ASSERT_OK(edge_cursor_read_u8(&pdu, &byte_count));
+        // 01/02 按位打包，03/04 每寄存器 2 字节；字节计数须与请求数量一致
+        size_t expect = (fc <= MODBUS_FC_READ_DISCRETE_INPUTS) ? ((size_t)txn->quantity + 7) / 8 : (size_t)txn->quantity * 2;
+        if (byte_count != expect || edge_cursor_remaining(&pdu) != byte_count) return EP_ERR_INVALID_FRAME;
+        EP_ASSERT_OK(edge_cursor_slice(&pdu, byte_count, &out->data));
+    } else {
+        if (edge_cursor_remaining(&pdu) != 4) return EP_ERR_INVALID_FRAME;
+        // 05/06 回显须与请求的地址和写入值逐字一致
+        edge_cursor_t echo = pdu;
+        uint16_t addr, value;
+        EP_ASSERT_OK(edge_cursor_read_be16(&echo, &addr));
+        EP_ASSERT_OK(edge_cursor_read_be16(&echo, &value));
+        if (addr != txn->addr || value != txn->quantity) return EP_ERR_INVALID_FRAME;
+        EP_ASSERT_OK(edge_cursor_slice(&pdu, 4, &out->data));
+    }
+
+    out->txn = *txn;
+    _release(p, txn);
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_pipeline_on_response(edge_modbus_pipeline_t *p, edge_cursor_t *c, edge_modbus_pipe_result_t *out) {
+    if (!p || !c || !out) return EP_ERR_INVALID_ARG;
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _pipeline_on_response(p, c, out);
+    EDGE_STATS_END(p, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
+
+size_t edge_modbus_pipeline_expire(edge_modbus_pipeline_t *p, uint64_t now_ms, edge_modbus_txn_t *out, size_t max) {
+    if (!p || now_ms < p->next_deadline) return 0;
+    size_t n = 0;
+    uint64_t next = _NO_DEADLINE;
+    for (int i = 0; i < EDGE_MODBUS_PIPE_SLOTS; i++) {
+        edge_modbus_txn_t *t = &p->slots[i];
+        if (!t->in_use) continue;
+        if (t->deadline_ms <= now_ms && (!out || n < max)) {
+            if (out) out[n] = *t;
+            n++;
+            _release(p, t);
+        } else if (t->deadline_ms < next) {
+            next = t->deadline_ms;
+        }
+    }
+    p->next_deadline = next;
+    return n;
+}
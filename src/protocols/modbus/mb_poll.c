@@ -0,0 +1,113 @@
+#include "protocols/edge_modbus.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool _is_bit_table(uint8_t fc) { return fc == MODBUS_FC_READ_COILS || fc == MODBUS_FC_READ_DISCRETE_INPUTS; }
+
+static uint16_t _point_width(uint8_t type) {
+    return (type >= EDGE_MODBUS_POINT_U32 && type <= EDGE_MODBUS_POINT_F32) ? 2 : 1;
+}
+
+static int _poll_cmp(const void *a, const void *b) {
+    const edge_modbus_decode_t *x = a, *y = b;
+    if (x->unit_id != y->unit_id) return x->unit_id < y->unit_id ? -1 : 1;
+    if (x->table != y->table) return x->table < y->table ? -1 : 1;
+    if (x->addr != y->addr) return x->addr < y->addr ? -1 : 1;
+    return x->point < y->point ? -1 : (x->point > y->point);
+}
+
+void edge_modbus_poll_plan_init(edge_modbus_poll_plan_t *plan, edge_modbus_poll_req_t *reqs, size_t req_cap,
+                                edge_modbus_decode_t *map, size_t map_cap) {
+    if (!plan) return;
+    memset(plan, 0, sizeof(*plan));
+    plan->reqs = reqs; plan->req_cap = req_cap;
+    plan->map = map; plan->map_cap = map_cap;
+    plan->max_regs = EDGE_MODBUS_MAX_READ_REGS;
+    plan->max_bits = EDGE_MODBUS_MAX_READ_BITS;
+}
+
+edge_error_t edge_modbus_poll_plan_compile(edge_modbus_poll_plan_t *plan, const edge_modbus_point_t *points, size_t count) {
+    if (!plan || (!points && count)) return EP_ERR_INVALID_ARG;
+    // 上限超过协议允许值会生成从站必然拒绝、解码缓冲也容纳不下的请求
+    if (plan->max_regs < 2 || plan->max_regs > EDGE_MODBUS_MAX_READ_REGS) return EP_ERR_INVALID_ARG;
+    if (plan->max_bits == 0 || plan->max_bits > EDGE_MODBUS_MAX_READ_BITS) return EP_ERR_INVALID_ARG;
+    if (count > plan->map_cap || count > UINT16_MAX) return EP_ERR_BUFFER_TOO_SMALL;
+    plan->req_count = plan->map_count = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const edge_modbus_point_t *pt = &points[i];
+        if (pt->table < MODBUS_FC_READ_COILS || pt->table > MODBUS_FC_READ_INPUT_REGISTERS) return EP_ERR_INVALID_ARG;
+        if (_is_bit_table(pt->table) != (pt->type == EDGE_MODBUS_POINT_BIT)) return EP_ERR_INVALID_ARG;
+        if (pt->type > EDGE_MODBUS_POINT_F32) return EP_ERR_INVALID_ARG;
+        if ((uint32_t)pt->addr + _point_width(pt->type) > 0x10000) return EP_ERR_OUT_OF_BOUNDS;
+        plan->map[i] = (edge_modbus_decode_t){ .point = (uint16_t)i, .addr = pt->addr, .unit_id = pt->unit_id,
+                                               .table = pt->table, .type = pt->type, .word_swap = pt->word_swap };
+    }
+    qsort(plan->map, count, sizeof(plan->map[0]), _poll_cmp);
+
+    // 贪心合并：同一单元/功能码内，空洞不超过阈值且总量不超过上限时并入当前请求
+    edge_modbus_poll_req_t *r = NULL;
+    uint32_t end = 0;
+    for (size_t i = 0; i < count; i++) {
+        edge_modbus_decode_t *d = &plan->map[i];
+        bool bits = _is_bit_table(d->table);
+        uint32_t d_end = (uint32_t)d->addr + _point_width(d->type);
+        uint32_t new_end = d_end > end ? d_end : end;
+        if (!r || r->unit_id != d->unit_id || r->fc != d->table ||
+            d->addr > end + (bits ? plan->bit_gap : plan->reg_gap) ||
+            new_end - r->addr > (bits ? plan->max_bits : plan->max_regs)) {
+            if (plan->req_count == plan->req_cap) return EP_ERR_BUFFER_TOO_SMALL;
+            r = &plan->reqs[plan->req_count++];
+            *r = (edge_modbus_poll_req_t){ .unit_id = d->unit_id, .fc = d->table, .addr = d->addr, .first_map = (uint16_t)i };
+            new_end = d_end;
+        }
+        end = new_end;
+        r->quantity = (uint16_t)(end - r->addr);
+        r->map_count++;
+        d->offset = (uint16_t)(d->addr - r->addr);
+    }
+    plan->map_count = count;
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_poll_build(const edge_modbus_poll_plan_t *plan, size_t index, edge_modbus_context_t *ctx, edge_vector_t *v) {
+    if (!plan || !ctx || index >= plan->req_count) return EP_ERR_INVALID_ARG;
+    const edge_modbus_poll_req_t *r = &plan->reqs[index];
+    uint8_t saved = ctx->slave_id;
+    ctx->slave_id = r->unit_id;
+    edge_error_t err = edge_modbus_build_read_req(ctx, v, r->fc, r->addr, r->quantity);
+    ctx->slave_id = saved;
+    return err;
+}
+
+edge_error_t edge_modbus_poll_decode(const edge_modbus_poll_plan_t *plan, size_t index, edge_cursor_t *data, edge_modbus_value_t *values) {
+    if (!plan || !data || !values || index >= plan->req_count) return EP_ERR_INVALID_ARG;
+    const edge_modbus_poll_req_t *r = &plan->reqs[index];
+    bool bits = _is_bit_table(r->fc);
+    size_t len = bits ? (r->quantity + 7u) / 8u : r->quantity * 2u;
+    if (edge_cursor_remaining(data) != len) return EP_ERR_INVALID_FRAME;
+
+    // 单次响应至多 250 字节：拷贝到栈上以便按偏移随机访问 (点可以重叠)
+    uint8_t buf[EDGE_MODBUS_MAX_READ_REGS * 2];
+    if (len > sizeof(buf)) return EP_ERR_BUFFER_TOO_SMALL;
+    EP_ASSERT_OK(edge_cursor_read_bytes(data, buf, len));
+
+    for (size_t i = r->first_map; i < (size_t)r->first_map + r->map_count; i++) {
+        const edge_modbus_decode_t *d = &plan->map[i];
+        edge_modbus_value_t *out = &values[d->point];
+        if (bits) { out->bit = (buf[d->offset >> 3] >> (d->offset & 7)) & 1; continue; }
+
+        const uint8_t *p = buf + d->offset * 2u;
+        uint16_t w0 = (uint16_t)((p[0] << 8) | p[1]);
+        if (_point_width(d->type) == 1) {
+            if (d->type == EDGE_MODBUS_POINT_I16) out->i16 = (int16_t)w0;
+            else out->u16 = w0;
+            continue;
+        }
+        uint16_t w1 = (uint16_t)((p[2] << 8) | p[3]);
+        uint32_t u = d->word_swap ? ((uint32_t)w1 << 16) | w0 : ((uint32_t)w0 << 16) | w1;
+        if (d->type == EDGE_MODBUS_POINT_F32) memcpy(&out->f32, &u, sizeof(u));
+        else out->u32 = u;  // I32 与 U32 共享存储
+    }
+    return EP_OK;
+}
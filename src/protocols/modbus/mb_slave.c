@@ -1,53 +1,262 @@
 #include "protocols/edge_modbus.h"
+#include "common/stats.h"
 #include <string.h>
 
+static bool _slave_is_bits(edge_modbus_table_t table) {
+    return table == EDGE_MODBUS_TABLE_COILS || table == EDGE_MODBUS_TABLE_DISCRETE_INPUTS;
+}
+
 /**
- * @brief 从站 PDU 处理器
- * 自动处理 03, 04, 06, 16 等核心功能码
+ * @brief 二分查找完整包含 [addr, addr + qty) 的段，跨段或越界返回 NULL
  */
-edge_error_t edge_modbus_slave_handle_pdu(edge_modbus_context_t *ctx, edge_cursor_t *req, edge_vector_t *resp, 
-                                          uint16_t *holding_regs, size_t reg_count) {
+static edge_modbus_block_t *_slave_find(const edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, uint32_t qty) {
+    const edge_modbus_unit_map_t *u = s->by_unit[unit_id];
+    if (!u || table >= EDGE_MODBUS_TABLE_COUNT) return NULL;
+    edge_modbus_block_t *b = u->blocks[table];
+    size_t lo = 0, hi = u->block_count[table];
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (b[mid].start <= addr) lo = mid + 1; else hi = mid;
+    }
+    if (lo == 0) return NULL;
+    b = &b[lo - 1];
+    return ((uint32_t)addr + qty <= (uint32_t)b->start + b->count) ? b : NULL;
+}
+
+static bool _slave_get_bit(const edge_modbus_block_t *b, uint32_t i) { return (b->data[i >> 3] >> (i & 7)) & 1; }
+
+static void _slave_put_bit(edge_modbus_block_t *b, uint32_t i, bool v) {
+    if (v) b->data[i >> 3] |= (uint8_t)(1u << (i & 7));
+    else b->data[i >> 3] &= (uint8_t)~(1u << (i & 7));
+}
+
+edge_error_t edge_modbus_slave_init(edge_modbus_slave_t *s, edge_modbus_unit_map_t *units, size_t count) {
+    if (!s || (!units && count)) return EP_ERR_INVALID_ARG;
+    memset(s, 0, sizeof(*s));
+    for (size_t i = 0; i < count; i++) {
+        edge_modbus_unit_map_t *u = &units[i];
+        if (s->by_unit[u->unit_id]) return EP_ERR_INVALID_ARG;
+        for (int t = 0; t < EDGE_MODBUS_TABLE_COUNT; t++) {
+            uint32_t next = 0;
+            for (uint16_t k = 0; k < u->block_count[t]; k++) {
+                const edge_modbus_block_t *b = &u->blocks[t][k];
+                if (!b->data || b->count == 0 || b->start < next || (uint32_t)b->start + b->count > 0x10000) return EP_ERR_INVALID_ARG;
+                next = (uint32_t)b->start + b->count;
+            }
+        }
+        s->by_unit[u->unit_id] = u;
+    }
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_slave_set_regs(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, const uint16_t *vals, size_t n) {
+    if (!s || !vals || _slave_is_bits(table)) return EP_ERR_INVALID_ARG;
+    edge_modbus_block_t *b = _slave_find(s, unit_id, table, addr, n);
+    if (!b) return EP_ERR_OUT_OF_BOUNDS;
+    uint8_t *p = b->data + (size_t)(addr - b->start) * 2;
+    for (size_t i = 0; i < n; i++) { p[i * 2] = (uint8_t)(vals[i] >> 8); p[i * 2 + 1] = (uint8_t)vals[i]; }
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_slave_get_regs(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, uint16_t *vals, size_t n) {
+    if (!s || !vals || _slave_is_bits(table)) return EP_ERR_INVALID_ARG;
+    edge_modbus_block_t *b = _slave_find(s, unit_id, table, addr, n);
+    if (!b) return EP_ERR_OUT_OF_BOUNDS;
+    const uint8_t *p = b->data + (size_t)(addr - b->start) * 2;
+    for (size_t i = 0; i < n; i++) vals[i] = (uint16_t)((p[i * 2] << 8) | p[i * 2 + 1]);
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_slave_set_bit(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, bool val) {
+    if (!s || !_slave_is_bits(table)) return EP_ERR_INVALID_ARG;
+    edge_modbus_block_t *b = _slave_find(s, unit_id, table, addr, 1);
+    if (!b) return EP_ERR_OUT_OF_BOUNDS;
+    _slave_put_bit(b, addr - b->start, val);
+    return EP_OK;
+}
+
+edge_error_t edge_modbus_slave_get_bit(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, bool *val) {
+    if (!s || !val || !_slave_is_bits(table)) return EP_ERR_INVALID_ARG;
+    edge_modbus_block_t *b = _slave_find(s, unit_id, table, addr, 1);
+    if (!b) return EP_ERR_OUT_OF_BOUNDS;
+    *val = _slave_get_bit(b, addr - b->start);
+    return EP_OK;
+}
+
+static edge_error_t _slave_exception(edge_vector_t *resp, uint8_t fc, uint8_t code) {
+    EP_ASSERT_OK(edge_vector_put_u8(resp, fc | 0x80));
+    return edge_vector_put_u8(resp, code);
+}
+
+/* 位读取：段内字节对齐时整字节直接引用镜像，仅末字节按数量清零高位；否则移位打包到 bit_buf */
+static edge_error_t _slave_read_bits(edge_modbus_slave_t *s, const edge_modbus_block_t *b, uint16_t addr, uint16_t qty, edge_vector_t *resp) {
+    uint32_t off = (uint32_t)(addr - b->start);
+    size_t full = qty / 8u, tail = qty & 7u;
+    if ((off & 7) == 0) {
+        const uint8_t *src = b->data + (off >> 3);
+        if (full) EP_ASSERT_OK(edge_vector_append_ref(resp, src, full));
+        if (tail) EP_ASSERT_OK(edge_vector_put_u8(resp, src[full] & (uint8_t)((1u << tail) - 1)));
+        return EP_OK;
+    }
+    size_t nbytes = (qty + 7u) / 8u;
+    memset(s->bit_buf, 0, nbytes);
+    for (uint32_t i = 0; i < qty; i++)
+        if (_slave_get_bit(b, off + i)) s->bit_buf[i >> 3] |= (uint8_t)(1u << (i & 7));
+    return edge_vector_append_ref(resp, s->bit_buf, nbytes);
+}
+
+static void _slave_notify(edge_modbus_slave_t *s, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, uint16_t count) {
+    if (s->on_write) s->on_write(s->user, unit_id, table, addr, count);
+}
+
+static edge_error_t _slave_handle_pdu(edge_modbus_slave_t *s, uint8_t unit_id, edge_cursor_t *req, edge_vector_t *resp) {
     uint8_t fc;
-    EP_ASSERT_OK(edge_cursor_read_u8(req, &fc));
-    
-    uint16_t addr, qty;
+    uint16_t addr, qty, val;
+    edge_modbus_block_t *b;
+    if (edge_cursor_read_u8(req, &fc) != EP_OK) return EP_ERR_INVALID_FRAME;
+
     switch (fc) {
-        case 0x03: // Read Holding Registers
-            EP_ASSERT_OK(edge_cursor_read_be16(req, &addr));
-            EP_ASSERT_OK(edge_cursor_read_be16(req, &qty));
-            
-            if (addr + qty > reg_count) {
-                edge_vector_put_u8(resp, fc | 0x80);
-                edge_vector_put_u8(resp, 0x02); // Illegal Address
-                return EP_OK;
+        case MODBUS_FC_READ_COILS:
+        case MODBUS_FC_READ_DISCRETE_INPUTS:
+        case MODBUS_FC_READ_HOLDING_REGISTERS:
+        case MODBUS_FC_READ_INPUT_REGISTERS: {
+            edge_modbus_table_t table = (edge_modbus_table_t)(fc - 1);
+            bool bits = _slave_is_bits(table);
+            if (edge_cursor_read_be16(req, &addr) != EP_OK || edge_cursor_read_be16(req, &qty) != EP_OK ||
+                qty == 0 || qty > (bits ? EDGE_MODBUS_MAX_READ_BITS : EDGE_MODBUS_MAX_READ_REGS))
+                return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_VALUE);
+            if (!(b = _slave_find(s, unit_id, table, addr, qty))) return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+            EP_ASSERT_OK(edge_vector_put_u8(resp, fc));
+            if (bits) {
+                EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)((qty + 7u) / 8u)));
+                return _slave_read_bits(s, b, addr, qty, resp);
             }
-            
-            edge_vector_put_u8(resp, fc);
-            edge_vector_put_u8(resp, (uint8_t)(qty * 2));
-            for (int i = 0; i < qty; i++) {
-                edge_vector_put_be16(resp, holding_regs[addr + i]);
+            EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)(qty * 2u)));
+            return edge_vector_append_ref(resp, b->data + (size_t)(addr - b->start) * 2, qty * 2u);
+        }
+
+        case MODBUS_FC_WRITE_SINGLE_COIL:
+        case MODBUS_FC_WRITE_SINGLE_REGISTER:
+            if (edge_cursor_read_be16(req, &addr) != EP_OK || edge_cursor_read_be16(req, &val) != EP_OK ||
+                (fc == MODBUS_FC_WRITE_SINGLE_COIL && val != 0xFF00 && val != 0x0000))
+                return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_VALUE);
+            if (fc == MODBUS_FC_WRITE_SINGLE_COIL) {
+                if (!(b = _slave_find(s, unit_id, EDGE_MODBUS_TABLE_COILS, addr, 1))) return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+                _slave_put_bit(b, addr - b->start, val != 0);
+                _slave_notify(s, unit_id, EDGE_MODBUS_TABLE_COILS, addr, 1);
+            } else {
+                if (!(b = _slave_find(s, unit_id, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, addr, 1))) return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+                uint8_t *p = b->data + (size_t)(addr - b->start) * 2;
+                p[0] = (uint8_t)(val >> 8); p[1] = (uint8_t)val;
+                _slave_notify(s, unit_id, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, addr, 1);
             }
+            EP_ASSERT_OK(edge_vector_put_u8(resp, fc));
+            EP_ASSERT_OK(edge_vector_put_be16(resp, addr));
+            return edge_vector_put_be16(resp, val);
+
+        case MODBUS_FC_WRITE_MULTIPLE_COILS: {
+            uint8_t bc;
+            if (edge_cursor_read_be16(req, &addr) != EP_OK || edge_cursor_read_be16(req, &qty) != EP_OK ||
+                edge_cursor_read_u8(req, &bc) != EP_OK || qty == 0 || qty > 1968 ||
+                bc != (qty + 7u) / 8u || edge_cursor_remaining(req) != bc)
+                return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_VALUE);
+            if (!(b = _slave_find(s, unit_id, EDGE_MODBUS_TABLE_COILS, addr, qty))) return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+            uint8_t src[1968 / 8];
+            EP_ASSERT_OK(edge_cursor_read_bytes(req, src, bc));
+            for (uint32_t i = 0; i < qty; i++) _slave_put_bit(b, addr - b->start + i, (src[i >> 3] >> (i & 7)) & 1);
+            _slave_notify(s, unit_id, EDGE_MODBUS_TABLE_COILS, addr, qty);
             break;
-            
-        case 0x06: // Write Single Register
-            EP_ASSERT_OK(edge_cursor_read_be16(req, &addr));
-            uint16_t val;
-            EP_ASSERT_OK(edge_cursor_read_be16(req, &val));
-            
-            if (addr >= reg_count) return EP_ERR_OUT_OF_BOUNDS;
-            holding_regs[addr] = val;
-            
-            // Echo back for 06
-            edge_vector_put_u8(resp, fc);
-            edge_vector_put_be16(resp, addr);
-            edge_vector_put_be16(resp, val);
+        }
+
+        case MODBUS_FC_WRITE_MULTIPLE_REGISTERS: {
+            uint8_t bc;
+            if (edge_cursor_read_be16(req, &addr) != EP_OK || edge_cursor_read_be16(req, &qty) != EP_OK ||
+                edge_cursor_read_u8(req, &bc) != EP_OK || qty == 0 || qty > 123 ||
+                bc != qty * 2u || edge_cursor_remaining(req) != bc)
+                return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_VALUE);
+            if (!(b = _slave_find(s, unit_id, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, addr, qty))) return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+            // 请求与镜像同为线路序，直接拷入
+            EP_ASSERT_OK(edge_cursor_read_bytes(req, b->data + (size_t)(addr - b->start) * 2, bc));
+            _slave_notify(s, unit_id, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, addr, qty);
             break;
-            
+        }
+
+        case MODBUS_FC_READ_WRITE_MULTIPLE_REGISTERS: {
+            uint16_t waddr, wqty;
+            uint8_t bc;
+            if (edge_cursor_read_be16(req, &addr) != EP_OK || edge_cursor_read_be16(req, &qty) != EP_OK ||
+                edge_cursor_read_be16(req, &waddr) != EP_OK || edge_cursor_read_be16(req, &wqty) != EP_OK ||
+                edge_cursor_read_u8(req, &bc) != EP_OK || qty == 0 || qty > EDGE_MODBUS_MAX_READ_REGS ||
+                wqty == 0 || wqty > 121 || bc != wqty * 2u || edge_cursor_remaining(req) != bc)
+                return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_VALUE);
+            edge_modbus_block_t *rb = _slave_find(s, unit_id, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, addr, qty);
+            edge_modbus_block_t *wb = _slave_find(s, unit_id, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, waddr, wqty);
+            if (!rb || !wb) return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_DATA_ADDRESS);
+            // 规范要求先写后读
+            EP_ASSERT_OK(edge_cursor_read_bytes(req, wb->data + (size_t)(waddr - wb->start) * 2, bc));
+            _slave_notify(s, unit_id, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, waddr, wqty);
+            EP_ASSERT_OK(edge_vector_put_u8(resp, fc));
+            EP_ASSERT_OK(edge_vector_put_u8(resp, (uint8_t)(qty * 2u)));
+            return edge_vector_append_ref(resp, rb->data + (size_t)(addr - rb->start) * 2, qty * 2u);
+        }
+
         default:
-            edge_vector_put_u8(resp, fc | 0x80);
-            edge_vector_put_u8(resp, 0x01); // Illegal Function
-            break;
+            return _slave_exception(resp, fc, MODBUS_EX_ILLEGAL_FUNCTION);
+    }
+
+    // 0F / 10 回显起始地址与数量
+    EP_ASSERT_OK(edge_vector_put_u8(resp, fc));
+    EP_ASSERT_OK(edge_vector_put_be16(resp, addr));
+    return edge_vector_put_be16(resp, qty);
+}
+
+edge_error_t edge_modbus_slave_handle_pdu(edge_modbus_slave_t *s, uint8_t unit_id, edge_cursor_t *req, edge_vector_t *resp) {
+    if (!s || !req || !resp) return EP_ERR_INVALID_ARG;
+    if (!s->by_unit[unit_id]) return EP_ERR_NOT_SUPPORTED;
+    EDGE_STATS_BEGIN(t0);
+    edge_error_t err = _slave_handle_pdu(s, unit_id, req, resp);
+    EDGE_STATS_END(s, EDGE_STAT_FRAMES_RX, err, t0);
+    return err;
+}
+
+edge_error_t edge_modbus_slave_handle_tcp(edge_modbus_slave_t *s, edge_cursor_t *c, edge_vector_t *resp) {
+    if (!s || !c || !resp) return EP_ERR_INVALID_ARG;
+    edge_cursor_t t = *c;
+    uint16_t tid, pid, len;
+    uint8_t unit;
+    if (edge_cursor_remaining(&t) < EDGE_MODBUS_MBAP_LEN) return EP_ERR_INCOMPLETE_DATA;
+    EP_ASSERT_OK(edge_cursor_read_be16(&t, &tid));
+    EP_ASSERT_OK(edge_cursor_read_be16(&t, &pid));
+    EP_ASSERT_OK(edge_cursor_read_be16(&t, &len));
+    EP_ASSERT_OK(edge_cursor_read_u8(&t, &unit));
+    if (pid != 0 || len < 2 || len > 254) return EP_ERR_INVALID_FRAME;
+    edge_cursor_t pdu;
+    EP_ASSERT_OK(edge_cursor_slice(&t, len - 1, &pdu));
+
+    // MBAP 长度先占位，PDU 写完后回填；任何一步失败都截回原长度，输入 cursor 不前进
+    size_t base = edge_vector_length(resp);
+    edge_error_t err = edge_vector_put_be16(resp, tid);
+    if (err == EP_OK) err = edge_vector_put_be16(resp, 0);
+    if (err == EP_OK) err = edge_vector_put_be16(resp, 0);
+    if (err == EP_OK) err = edge_vector_put_u8(resp, unit);
+    if (err != EP_OK) {
+        // 头部都写不下，交给下方统一截回
+    } else if (!s->by_unit[unit]) {
+        uint8_t fc = 0;
+        edge_cursor_read_u8(&pdu, &fc);
+        err = _slave_exception(resp, fc, MODBUS_EX_GATEWAY_TARGET_FAILED);
+    } else {
+        EDGE_STATS_BEGIN(t0);
+        err = _slave_handle_pdu(s, unit, &pdu, resp);
+        EDGE_STATS_END(s, EDGE_STAT_FRAMES_RX, err, t0);
+    }
+    if (err != EP_OK) {
+        edge_vector_truncate(resp, base);
+        return err;
     }
-    
+    size_t n = edge_vector_length(resp) - base - 6;
+    uint8_t be_len[2] = { (uint8_t)(n >> 8), (uint8_t)n };
+    EP_ASSERT_OK(edge_vector_patch(resp, base + 4, be_len, 2));
+    *c = t;
     return EP_OK;
 }
@@ -6,6 +6,7 @@
 #include <string.h>
 #include "cmocka.h"
 #include "edge_core.h"
+#include "common/crc.h"
 
 static void test_vector_scratch_overflow(void **state) {
     (void)state;
@@ -14,11 +15,93 @@ static void test_vector_scratch_overflow(void **state) {
     uint8_t large[100]; memset(large, 0xAA, 100);
     // 第一次 Copy 消耗 100 字节 (Scratchpad 剩余 28)
     assert_int_equal(edge_vector_append_copy(&v, large, 100), EP_OK);
+#if EDGE_VECTOR_SCRATCH_SIZE > 0
     // 第二次 Copy 50 字节，应当报错由于 Scratchpad 溢出
     assert_int_equal(edge_vector_append_copy(&v, large, 50), EP_ERR_BUFFER_TOO_SMALL);
+#else
+    // 线程 arena 模式：续写由 arena 授予，不受内联容量限制
+    assert_int_equal(edge_vector_append_copy(&v, large, 50), EP_OK);
+    assert_int_equal(v.total_len, 150);
+#endif
     assert_int_equal(v.used_count, 1);
 }
 
+static void test_vector_bump_arena_large_frame(void **state) {
+    (void)state;
+    static uint8_t mem[1024];
+    edge_arena_bump_t arena; edge_arena_bump_init(&arena, mem, sizeof(mem));
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init_arena(&v, iov, 4, &arena.base);
+
+    // 200 个寄存器远超内联 scratch，连续授予的块合并为单一 iovec
+    for (int i = 0; i < 200; i++) assert_int_equal(edge_vector_put_be16(&v, (uint16_t)i), EP_OK);
+    assert_int_equal(v.used_count, 1);
+    assert_int_equal(v.total_len, 400);
+    assert_int_equal(edge_vector_get_ptr(&v, 399)[0], 199);
+
+    // 按帧 reset 后复用同一块缓冲区
+    edge_arena_reset(&arena.base);
+    edge_vector_init_arena(&v, iov, 4, &arena.base);
+    assert_int_equal(edge_vector_put_u8(&v, 0x5A), EP_OK);
+    assert_ptr_equal(v.iovs[0].iov_base, mem);
+}
+
+static void test_vector_slab_arena_chaining(void **state) {
+    (void)state;
+    static uint8_t pool[4 * 32];
+    edge_arena_slab_t slabs; edge_arena_slab_init(&slabs, pool, 32, 4);
+    struct iovec ia[4], ib[4]; edge_vector_t a, b;
+    edge_vector_init_arena(&a, ia, 4, &slabs.base);
+    edge_vector_init_arena(&b, ib, 4, &slabs.base);
+
+    // a: slab0, b: slab1, a 溢出后链到不相邻的 slab2 (新 iovec 段)
+    uint8_t chunk[24];
+    memset(chunk, 0xA0, sizeof(chunk));
+    assert_int_equal(edge_vector_append_copy(&a, chunk, sizeof(chunk)), EP_OK);
+    memset(chunk, 0xB0, sizeof(chunk));
+    assert_int_equal(edge_vector_append_copy(&b, chunk, sizeof(chunk)), EP_OK);
+    memset(chunk, 0xA1, sizeof(chunk));
+    assert_int_equal(edge_vector_append_copy(&a, chunk, sizeof(chunk)), EP_OK);
+    assert_int_equal(a.used_count, 2);
+    assert_ptr_equal(a.iovs[1].iov_base, pool + 64);
+    assert_int_equal(*edge_vector_get_ptr(&a, 47), 0xA1);
+    assert_int_equal(*edge_vector_get_ptr(&b, 23), 0xB0);
+
+    // 单次请求不得超过 slab 大小；slab 耗尽后报错
+    uint8_t big[40] = {0};
+    assert_int_equal(edge_vector_append_copy(&b, big, sizeof(big)), EP_ERR_BUFFER_TOO_SMALL);
+    assert_int_equal(edge_vector_append_copy(&b, chunk, sizeof(chunk)), EP_OK);   // slab3
+    assert_int_equal(edge_vector_append_copy(&a, chunk, sizeof(chunk)), EP_ERR_BUFFER_TOO_SMALL);
+}
+
+static void test_vector_thread_arena(void **state) {
+    (void)state;
+    edge_arena_t *arena = edge_arena_thread();
+    edge_arena_reset(arena);
+    struct iovec iov[2]; edge_vector_t a, b;
+    edge_vector_init_arena(&a, iov, 1, arena);
+    edge_vector_init_arena(&b, iov + 1, 1, arena);
+    // 两个 vector 交替使用同一 arena，互不覆盖
+    assert_int_equal(edge_vector_put_be32(&a, 0x11111111), EP_OK);
+    assert_int_equal(edge_vector_put_be32(&b, 0x22222222), EP_OK);
+    assert_int_equal(edge_vector_put_be32(&a, 0x33333333), EP_OK);
+    assert_int_equal(edge_vector_get_ptr(&a, 0)[0], 0x11);
+    assert_int_equal(edge_vector_get_ptr(&a, 4)[0], 0x33);
+    assert_int_equal(edge_vector_get_ptr(&b, 0)[0], 0x22);
+    edge_arena_reset(arena);
+
+    // 每帧开头回收：远超 EDGE_ARENA_THREAD_SIZE 的累计写入量下每帧仍从 arena 起点取得存储
+    uint8_t payload[200]; memset(payload, 0x5A, sizeof(payload));
+    const uint8_t *first = NULL;
+    for (int frame = 0; frame < 4 * EDGE_ARENA_THREAD_SIZE / (int)sizeof(payload); frame++) {
+        edge_arena_thread_frame_begin();
+        edge_vector_init_arena(&a, iov, 1, arena);
+        assert_int_equal(edge_vector_append_copy(&a, payload, sizeof(payload)), EP_OK);
+        if (!first) first = a.iovs[0].iov_base;
+        assert_ptr_equal(a.iovs[0].iov_base, first);
+    }
+    edge_arena_thread_frame_begin();
+}
+
 static void test_cursor_fragmented_read(void **state) {
     (void)state;
     uint8_t d1 = 0x12, d2 = 0x34;
@@ -43,11 +126,446 @@ static void test_cursor_empty_iovec(void **state) {
     assert_int_equal(val, 0xFF);
 }
 
+static void test_cursor_remaining_and_fast_path(void **state) {
+    (void)state;
+    uint8_t a[] = { 0x01, 0x02, 0x03 }, b[] = { 0x04, 0x05, 0x06, 0x07, 0x08 };
+    struct iovec iov[] = { {a, 3}, {NULL, 0}, {b, 5} };
+    edge_cursor_t c; edge_cursor_init(&c, iov, 3);
+    assert_int_equal(edge_cursor_remaining(&c), 8);
+
+    uint16_t v16; uint32_t v32; uint8_t v8;
+    assert_int_equal(edge_cursor_read_le16(&c, &v16), EP_OK); // 段内快速路径
+    assert_int_equal(v16, 0x0201);
+    assert_int_equal(edge_cursor_read_be32(&c, &v32), EP_OK); // 跨段 (含空段) 慢路径
+    assert_int_equal(v32, 0x03040506);
+    assert_int_equal(edge_cursor_remaining(&c), 2);
+    assert_int_equal(edge_cursor_read_be16(&c, &v16), EP_OK);
+    assert_int_equal(v16, 0x0708);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+    assert_int_equal(edge_cursor_read_u8(&c, &v8), EP_ERR_INCOMPLETE_DATA);
+}
+
+static void test_cursor_scan_patterns(void **state) {
+    (void)state;
+    static const uint8_t sync[2] = { 0x05, 0x64 };
+    uint8_t a[] = { 0x00, 0x05, 0x11, 0x05 }, b[] = { 0x64, 0x10 };
+    struct iovec iov[] = { {a, 4}, {NULL, 0}, {b, 2} };
+    edge_cursor_t c; edge_cursor_init(&c, iov, 3);
+    size_t skipped;
+
+    // 跨段匹配：停在 a[3]
+    assert_int_equal(edge_cursor_scan(&c, sync, 2, &skipped), EP_OK);
+    assert_int_equal(skipped, 3);
+    assert_int_equal(edge_cursor_remaining(&c), 3);
+
+    // 末尾半个同步头：保留 0x05 等待后续数据
+    uint8_t tail[] = { 0x64, 0x64, 0x05 };
+    struct iovec iov2 = { tail, 3 };
+    edge_cursor_init(&c, &iov2, 1);
+    assert_int_equal(edge_cursor_scan(&c, sync, 2, &skipped), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(skipped, 2);
+
+    static const uint8_t flag = 0x7E;
+    edge_cursor_init(&c, &iov2, 1);
+    assert_int_equal(edge_cursor_scan(&c, &flag, 1, &skipped), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+}
+
+static void test_cursor_scan_long_buffers(void **state) {
+    (void)state;
+    static const uint8_t sync[2] = { 0x05, 0x64 };
+    static uint8_t buf[300];
+    for (size_t pos = 0; pos + 1 < sizeof(buf); pos += 7) {
+        for (size_t i = 0; i < sizeof(buf); i++) buf[i] = (i % 3) ? 0x05 : 0x63; // 大量伪首字节
+        buf[pos] = 0x05; buf[pos + 1] = 0x64;
+        size_t split = (pos * 13) % sizeof(buf);
+        struct iovec iov[] = { {buf, split}, {buf + split, sizeof(buf) - split} };
+        edge_cursor_t c; edge_cursor_init(&c, iov, 2);
+        size_t skipped;
+        assert_int_equal(edge_cursor_scan(&c, sync, 2, &skipped), EP_OK);
+        assert_int_equal(skipped, pos);
+    }
+}
+
+static void check_vector_patch_many_segments(bool indexed) {
+    enum { SEGS = 200 };
+    static uint8_t chunks[SEGS][3];
+    struct iovec iov[SEGS]; size_t offsets[SEGS];
+    edge_vector_t v; edge_vector_init(&v, iov, SEGS);
+    if (indexed) edge_vector_attach_index(&v, offsets);
+    for (int i = 0; i < SEGS; i++) {
+        memset(chunks[i], 0, 3);
+        assert_int_equal(edge_vector_append_ref(&v, chunks[i], (size_t)(i % 3) + 1), EP_OK);
+    }
+    // 逆序逐字节回填，覆盖头/中/尾与缓存位置
+    for (size_t off = v.total_len; off-- > 0;) {
+        uint8_t b = (uint8_t)(off * 7);
+        assert_int_equal(edge_vector_patch(&v, off, &b, 1), EP_OK);
+    }
+    for (size_t off = 0; off < v.total_len; off++) {
+        assert_int_equal(*edge_vector_get_ptr(&v, off), (uint8_t)(off * 7));
+    }
+    // 跨段 patch
+    uint8_t be[2] = { 0xAB, 0xCD };
+    assert_int_equal(edge_vector_patch(&v, 2, be, 2), EP_OK); // 段 1 (2 字节) 尾 + 段 2 首
+    assert_int_equal(chunks[1][1], 0xAB);
+    assert_int_equal(chunks[2][0], 0xCD);
+    assert_int_equal(edge_vector_patch(&v, v.total_len - 1, be, 2), EP_ERR_OUT_OF_BOUNDS);
+}
+
+static void test_vector_patch_lookup(void **state) {
+    (void)state;
+    check_vector_patch_many_segments(false);
+    check_vector_patch_many_segments(true);
+}
+
+static void test_vector_incremental_checksum(void **state) {
+    (void)state;
+    struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8);
+    static const uint8_t pdu[] = { 0x03, 0x00, 0x64, 0x00, 0x05 };
+
+    // Modbus RTU: 01 03 00 64 00 05 -> CRC C4 16 (跨 copy/ref 两种段)
+    edge_vector_check_begin(&v, EDGE_CHECK_CRC16_MODBUS);
+    assert_int_equal(edge_vector_put_u8(&v, 0x01), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, pdu, sizeof(pdu)), EP_OK);
+    assert_int_equal(edge_vector_check_value(&v), 0x16C4);
+
+    uint16_t ranged;
+    assert_int_equal(edge_vector_checksum(&v, EDGE_CHECK_CRC16_MODBUS, 0, 6, &ranged), EP_OK);
+    assert_int_equal(ranged, 0x16C4);
+    assert_int_equal(edge_vector_checksum(&v, EDGE_CHECK_CRC16_MODBUS, 4, 3, &ranged), EP_ERR_OUT_OF_BOUNDS);
+
+    // patch 跟踪区间后退化为区间重算
+    uint8_t qty = 0x0A;
+    assert_int_equal(edge_vector_patch(&v, 0, &qty, 1), EP_OK);
+    assert_int_equal(edge_vector_checksum(&v, EDGE_CHECK_CRC16_MODBUS, 0, 6, &ranged), EP_OK);
+    assert_int_equal(edge_vector_check_value(&v), ranged);
+}
+
+static void test_cursor_checksum_fragmented(void **state) {
+    (void)state;
+    uint8_t a[] = { 0x68, 0x11 }, b[] = { 0x22, 0x33 };
+    struct iovec iov[] = { {a, 2}, {NULL, 0}, {b, 2} };
+    edge_cursor_t c; edge_cursor_init(&c, iov, 3);
+
+    uint8_t skip; assert_int_equal(edge_cursor_read_u8(&c, &skip), EP_OK);
+    uint16_t cs;
+    assert_int_equal(edge_cursor_checksum(&c, EDGE_CHECK_SUM8, 3, &cs), EP_OK);
+    assert_int_equal(cs, 0x66);
+    assert_int_equal(edge_cursor_remaining(&c), 3); // 不移动 cursor
+    assert_int_equal(edge_cursor_checksum(&c, EDGE_CHECK_SUM8, 4, &cs), EP_ERR_INCOMPLETE_DATA);
+}
+
+static void test_vector_finalize_coalesce(void **state) {
+    (void)state;
+    static uint8_t big[300];
+    static const uint8_t hdr[] = { 0x05, 0x64, 0x0A }, tag[] = { 0xAA, 0xBB };
+    for (size_t i = 0; i < sizeof(big); i++) big[i] = (uint8_t)i;
+    struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8);
+
+    // ref / copy 交替产生 5 个小段 + 1 个大 ref 段 + 2 个小段
+    assert_int_equal(edge_vector_append_ref(&v, hdr, 3), EP_OK);
+    assert_int_equal(edge_vector_put_be16(&v, 0x1234), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, tag, 2), EP_OK);
+    assert_int_equal(edge_vector_put_u8(&v, 0x55), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, hdr, 1), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, big, sizeof(big)), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, tag, 2), EP_OK);
+    assert_int_equal(edge_vector_put_le16(&v, 0xBEEF), EP_OK);
+    assert_int_equal(v.used_count, 8);
+
+    uint8_t before[512], after[512]; size_t n1, n2;
+    assert_int_equal(edge_vector_flatten(&v, before, sizeof(before), &n1), EP_OK);
+    assert_int_equal(edge_vector_finalize(&v, NULL), EP_OK);
+    assert_int_equal(v.used_count, 3);
+    assert_ptr_equal(v.iovs[1].iov_base, big); // 大段保持零拷贝
+    assert_int_equal(edge_vector_flatten(&v, after, sizeof(after), &n2), EP_OK);
+    assert_int_equal(n1, n2);
+    assert_memory_equal(before, after, n1);
+    assert_int_equal(edge_vector_flatten(&v, after, 8, &n2), EP_ERR_BUFFER_TOO_SMALL);
+
+    // 合并后仍可继续追加/回填；max_iovs = 1 时整帧压平，内联 scratch 不足则保持原样
+    assert_int_equal(edge_vector_put_u8(&v, 0x16), EP_OK);
+    assert_int_equal(v.used_count, 3);
+    assert_int_equal(*edge_vector_get_ptr(&v, v.total_len - 1), 0x16);
+    const edge_vector_cost_t serial = { 64, 1 };
+#if EDGE_VECTOR_SCRATCH_SIZE > 0
+    assert_int_equal(edge_vector_finalize(&v, &serial), EP_ERR_BUFFER_TOO_SMALL);
+    assert_int_equal(v.used_count, 3);
+#else
+    assert_int_equal(edge_vector_finalize(&v, &serial), EP_OK);
+    assert_int_equal(v.used_count, 1);
+#endif
+
+    static uint8_t mem[1024];
+    edge_arena_bump_t arena; edge_arena_bump_init(&arena, mem, sizeof(mem));
+    edge_vector_init_arena(&v, iov, 8, &arena.base);
+    assert_int_equal(edge_vector_put_u8(&v, 0x68), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, big, sizeof(big)), EP_OK);
+    assert_int_equal(edge_vector_put_u8(&v, 0x16), EP_OK);
+    assert_int_equal(edge_vector_finalize(&v, &serial), EP_OK);
+    assert_int_equal(v.used_count, 1);
+    assert_int_equal(v.iovs[0].iov_len, sizeof(big) + 2);
+    assert_memory_equal((uint8_t *)v.iovs[0].iov_base + 1, big, sizeof(big));
+}
+
+/**
+ * @brief 取段可写地址：引用段换成 scratch 副本，调用方内存不变；副本之后的追加不与中间段合并
+ */
+static void test_vector_own_segment(void **state) {
+    (void)state;
+    static uint8_t mem[256];
+    static const uint8_t hdr[] = { 0x01, 0x02 };
+    uint8_t body[40]; memset(body, 0x3C, sizeof(body));
+    edge_arena_bump_t arena; edge_arena_bump_init(&arena, mem, sizeof(mem));
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init_arena(&v, iov, 4, &arena.base);
+    assert_int_equal(edge_vector_append_copy(&v, hdr, 2), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, body, sizeof(body)), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, hdr, 1), EP_OK);
+
+    uint8_t *p;
+    assert_int_equal(edge_vector_own_segment(&v, 0, &p), EP_OK);
+    assert_ptr_equal(p, v.iovs[0].iov_base);
+    assert_ptr_equal(p, mem);
+    assert_int_equal(edge_vector_own_segment(&v, 1, &p), EP_OK);
+    assert_true(p != body);
+    assert_ptr_equal(p, v.iovs[1].iov_base);
+    memset(p, 0x00, sizeof(body));
+    assert_int_equal(body[0], 0x3C);
+
+    assert_int_equal(edge_vector_put_u8(&v, 0x7E), EP_OK);
+    assert_int_equal(v.used_count, 4);
+    assert_int_equal(v.total_len, 2 + sizeof(body) + 1 + 1);
+    assert_int_equal(*edge_vector_get_ptr(&v, 2 + sizeof(body)), 0x01);
+    assert_int_equal(*edge_vector_get_ptr(&v, 2 + sizeof(body) + 1), 0x7E);
+    assert_int_equal(edge_vector_own_segment(&v, 4, &p), EP_ERR_INVALID_ARG);
+}
+
+/**
+ * @brief 截断：跨界段截短、尾部段丢弃，之后的追加另起新段；增量校验按剩余数据重算
+ */
+static void test_vector_truncate(void **state) {
+    (void)state;
+    static const uint8_t ref[] = { 0xA0, 0xA1, 0xA2, 0xA3 };
+    static uint8_t mem[256];
+    edge_arena_bump_t arena; edge_arena_bump_init(&arena, mem, sizeof(mem));
+    struct iovec iov[6]; edge_vector_t v; edge_vector_init_arena(&v, iov, 6, &arena.base);
+    assert_int_equal(edge_vector_put_be16(&v, 0x0102), EP_OK);
+    edge_vector_check_begin(&v, EDGE_CHECK_CRC16_MODBUS);
+    assert_int_equal(edge_vector_append_ref(&v, ref, sizeof(ref)), EP_OK);
+    assert_int_equal(edge_vector_put_be16(&v, 0x0304), EP_OK);
+
+    assert_int_equal(edge_vector_truncate(&v, 9), EP_ERR_OUT_OF_BOUNDS);
+    assert_int_equal(edge_vector_truncate(&v, 4), EP_OK);
+    assert_int_equal(v.used_count, 2);
+    assert_int_equal(edge_vector_length(&v), 4);
+    assert_int_equal(v.iovs[1].iov_len, 2);
+    assert_int_equal(edge_vector_put_u8(&v, 0x7E), EP_OK);
+    assert_int_equal(v.used_count, 3);
+    assert_int_equal(*edge_vector_get_ptr(&v, 4), 0x7E);
+    uint16_t crc = 0;
+    const uint8_t rest[] = { 0xA0, 0xA1, 0x7E };
+    struct iovec ri = { (void *)rest, sizeof(rest) }; edge_cursor_t rc; edge_cursor_init(&rc, &ri, 1);
+    assert_int_equal(edge_cursor_checksum(&rc, EDGE_CHECK_CRC16_MODBUS, sizeof(rest), &crc), EP_OK);
+    assert_int_equal(edge_vector_check_value(&v), crc);
+
+    // 截到校验起点之前：起点随之前移
+    assert_int_equal(edge_vector_truncate(&v, 1), EP_OK);
+    assert_int_equal(v.used_count, 1);
+    assert_int_equal(edge_vector_check_value(&v), edge_check_final(EDGE_CHECK_CRC16_MODBUS, edge_check_init(EDGE_CHECK_CRC16_MODBUS)));
+    edge_vector_check_end(&v);
+    assert_int_equal(edge_vector_truncate(&v, 0), EP_OK);
+    assert_int_equal(v.used_count, 0);
+}
+
+static void test_cursor_slice_bounded(void **state) {
+    (void)state;
+    uint8_t a[] = { 0x68, 0x01, 0x02 }, b[] = { 0x03, 0x68, 0x16 }, d[] = { 0x7E, 0x7E };
+    struct iovec iov[] = { {a, 3}, {NULL, 0}, {b, 3}, {d, 2} };
+    edge_cursor_t c; edge_cursor_init(&c, iov, 4);
+
+    uint8_t x; assert_int_equal(edge_cursor_read_u8(&c, &x), EP_OK);
+    edge_cursor_t sub;
+    assert_int_equal(edge_cursor_slice(&c, 4, &sub), EP_OK); // 01 02 | 03 68
+    assert_int_equal(edge_cursor_remaining(&c), 3);
+    assert_int_equal(edge_cursor_remaining(&sub), 4);
+    assert_ptr_equal(edge_cursor_get_ptr(&sub, 2), a + 1); // 零拷贝
+    assert_null(edge_cursor_get_ptr(&sub, 3));             // 不越过子 cursor 边界
+    uint16_t w; assert_int_equal(edge_cursor_read_be16(&sub, &w), EP_OK);
+    assert_int_equal(w, 0x0368);
+    assert_int_equal(edge_cursor_read_u8(&sub, &x), EP_ERR_INCOMPLETE_DATA);
+
+    // 边界外的模式不可见；子 cursor 可再切片
+    edge_cursor_init(&c, iov, 4);
+    assert_int_equal(edge_cursor_slice(&c, 5, &sub), EP_OK);  // 68 01 02 03 68
+    edge_cursor_t inner; assert_int_equal(edge_cursor_slice(&sub, 4, &inner), EP_OK);
+    static const uint8_t p1[] = { 0x68 }, p2[] = { 0x68, 0x16 };
+    assert_int_equal(edge_cursor_skip(&inner, 1), EP_OK);
+    size_t skipped;
+    assert_int_equal(edge_cursor_scan(&inner, p1, 1, &skipped), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(skipped, 3);
+    assert_int_equal(edge_cursor_scan(&sub, p2, 2, NULL), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(edge_cursor_remaining(&sub), 1); // 末尾可能的首字节被保留
+    assert_int_equal(edge_cursor_slice(&sub, 2, &inner), EP_ERR_INCOMPLETE_DATA);
+
+    // slice_iov 收集跨段描述并跳过空段
+    edge_cursor_init(&c, iov, 4);
+    struct iovec out[2]; int n;
+    assert_int_equal(edge_cursor_skip(&c, 1), EP_OK);
+    assert_int_equal(edge_cursor_slice_iov(&c, 7, out, 2, &n), EP_ERR_BUFFER_TOO_SMALL);
+    assert_int_equal(edge_cursor_remaining(&c), 7);
+    assert_int_equal(edge_cursor_slice_iov(&c, 4, out, 2, &n), EP_OK);
+    assert_int_equal(n, 2);
+    assert_ptr_equal(out[0].iov_base, a + 1); assert_int_equal(out[0].iov_len, 2);
+    assert_ptr_equal(out[1].iov_base, b);     assert_int_equal(out[1].iov_len, 2);
+}
+
+static void test_bulk_endian_arrays(void **state) {
+    (void)state;
+    static uint8_t mem[1024];
+    uint16_t regs[37]; uint32_t dw[11];
+    for (int i = 0; i < 37; i++) regs[i] = (uint16_t)(0x0102 + i * 0x0101);
+    for (int i = 0; i < 11; i++) dw[i] = 0x01020304u + (uint32_t)i;
+    edge_arena_bump_t arena; edge_arena_bump_init(&arena, mem, sizeof(mem));
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init_arena(&v, iov, 4, &arena.base);
+
+    assert_int_equal(edge_vector_put_u8(&v, 0x03), EP_OK);
+    assert_int_equal(edge_vector_put_be16_array(&v, regs, 37), EP_OK);
+    assert_int_equal(edge_vector_put_le32_array(&v, dw, 11), EP_OK);
+    assert_int_equal(v.used_count, 1);
+    const uint8_t *p = edge_vector_get_ptr(&v, 1);
+    assert_int_equal(p[0], 0x01); assert_int_equal(p[1], 0x02);
+    assert_int_equal(p[72], (regs[36] >> 8)); assert_int_equal(p[73], (regs[36] & 0xFF));
+    assert_int_equal(p[74], 0x04); assert_int_equal(p[77], 0x01);
+
+    // 逐字节拆成 3 段，元素跨段读取
+    uint8_t wire[1 + 74 + 44];
+    size_t n; assert_int_equal(edge_vector_flatten(&v, wire, sizeof(wire), &n), EP_OK);
+    struct iovec rx[] = { { wire, 6 }, { wire + 6, 0 }, { wire + 6, 70 }, { wire + 76, n - 76 } };
+    edge_cursor_t c; edge_cursor_init(&c, rx, 4);
+    uint16_t r16[37]; uint32_t r32[11]; uint8_t fc;
+    assert_int_equal(edge_cursor_read_u8(&c, &fc), EP_OK);
+    assert_int_equal(edge_cursor_read_be16_array(&c, r16, 37), EP_OK);
+    assert_memory_equal(r16, regs, sizeof(regs));
+    assert_int_equal(edge_cursor_read_le32_array(&c, r32, 12), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(edge_cursor_remaining(&c), 44);
+    assert_int_equal(edge_cursor_read_le32_array(&c, r32, 11), EP_OK);
+    assert_memory_equal(r32, dw, sizeof(dw));
+
+    // 原地翻转为线路字节序 (小端主机)，再按 be32 读回
+    uint32_t sw[11]; memcpy(sw, dw, sizeof(dw));
+    edge_bswap32_array(sw, sw, 11);
+    for (int i = 0; i < 11; i++) assert_int_equal(sw[i], __builtin_bswap32(dw[i]));
+    struct iovec one = { sw, sizeof(sw) };
+    edge_cursor_init(&c, &one, 1);
+    assert_int_equal(edge_cursor_read_be32_array(&c, r32, 11), EP_OK);
+    assert_memory_equal(r32, dw, sizeof(dw));
+    struct iovec raw = { regs, sizeof(regs) };
+    edge_cursor_init(&c, &raw, 1);
+    assert_int_equal(edge_cursor_read_le16_array(&c, r16, 37), EP_OK);
+    assert_memory_equal(r16, regs, sizeof(regs));
+}
+
+static void test_frame_template_incremental_checks(void **state) {
+    (void)state;
+    uint8_t frame[40];
+    for (int i = 0; i < 40; i++) frame[i] = (uint8_t)(i * 7);
+    struct iovec iov[2]; edge_vector_t v; edge_vector_init(&v, iov, 2);
+    assert_int_equal(edge_vector_append_ref(&v, frame, sizeof(frame)), EP_OK);
+
+    // 嵌套 CRC (HCS 在 FCS 覆盖区间内) + 独立 SUM8
+    uint8_t buf[64]; edge_frame_template_t t; edge_template_init(&t, buf, sizeof(buf));
+    assert_int_equal(edge_template_capture(&t, &v), EP_OK);
+    assert_int_equal(edge_template_add_field(&t, 2, 2, true), EP_OK);
+    assert_int_equal(edge_template_add_check(&t, EDGE_CHECK_CRC16_CCITT, 1, 5, 6), EP_OK);
+    assert_int_equal(edge_template_add_check(&t, EDGE_CHECK_CRC16_CCITT, 1, 30, 31), EP_OK);
+    assert_int_equal(edge_template_add_check(&t, EDGE_CHECK_SUM8, 0, 4, 35), EP_ERR_OVERFLOW);
+    assert_int_equal(edge_template_add_field(&t, 20, 4, false), EP_OK);
+    assert_int_equal(edge_template_add_field(&t, 3, 1, false), EP_OK);
+
+    uint32_t seed = 7;
+    for (int it = 0; it < 200; it++) {
+        seed = seed * 1103515245u + 12345u;
+        assert_int_equal(edge_template_set(&t, (int)(seed % 3), seed >> 8), EP_OK);
+        assert_int_equal(buf[6] | (buf[7] << 8), edge_crc16_ccitt(buf + 1, 5));
+        assert_int_equal(buf[31] | (buf[32] << 8), edge_crc16_ccitt(buf + 1, 30));
+    }
+
+    // 校验值不得落入先声明校验的区间；DLT645 式 SUM8
+    edge_vector_init(&v, iov, 2);
+    assert_int_equal(edge_vector_append_ref(&v, frame, 16), EP_OK);
+    assert_int_equal(edge_template_capture(&t, &v), EP_OK);
+    assert_int_equal(edge_template_add_check(&t, EDGE_CHECK_CRC16_MODBUS, 0, 12, 12), EP_OK);
+    assert_int_equal(edge_template_add_check(&t, EDGE_CHECK_SUM8, 12, 2, 5), EP_ERR_INVALID_ARG);
+    assert_int_equal(edge_template_add_check(&t, EDGE_CHECK_SUM8, 0, 14, 14), EP_OK);
+    assert_int_equal(edge_template_add_field(&t, 8, 4, false), EP_OK);
+    for (uint32_t di = 0x00010000; di < 0x00010100; di += 0x11) {
+        assert_int_equal(edge_template_set(&t, 0, di * 2654435761u), EP_OK);
+        assert_int_equal(buf[12] | (buf[13] << 8), edge_crc16_modbus(buf, 12));
+        uint8_t cs = 0; for (int i = 0; i < 14; i++) cs = (uint8_t)(cs + buf[i]);
+        assert_int_equal(buf[14], cs);
+    }
+    struct iovec out[2]; edge_vector_t o; edge_vector_init(&o, out, 2);
+    assert_int_equal(edge_template_emit(&t, &o), EP_OK);
+    assert_ptr_equal(o.iovs[0].iov_base, buf);
+    assert_int_equal(o.total_len, 16);
+}
+
+#if EDGE_ENABLE_STATS
+/**
+ * @brief 统计：按错误码归类计数，分位数落在对应对数分桶内，快照与清零
+ */
+static void test_stats_record_snapshot(void **state) {
+    (void)state;
+    static edge_stats_t st, snap;
+    edge_stats_reset(&st);
+    for (uint64_t ns = 1; ns <= 1000; ns++) edge_stats_record(&st, EDGE_STAT_FRAMES_RX, EP_OK, ns);
+    edge_stats_record(&st, EDGE_STAT_FRAMES_RX, EP_ERR_CHECKSUM, 5);
+    edge_stats_record(&st, EDGE_STAT_FRAMES_RX, EP_ERR_INCOMPLETE_DATA, 5);
+    edge_stats_record(&st, EDGE_STAT_FRAMES_TX, EP_ERR_BUFFER_TOO_SMALL, 5);
+    edge_stats_add(&st, EDGE_STAT_RESYNC_BYTES, 7);
+
+    edge_stats_snapshot(&st, &snap);
+    assert_int_equal(snap.seq & 1u, 0);
+    assert_int_equal(snap.counters[EDGE_STAT_FRAMES_RX], 1000);
+    assert_int_equal(snap.counters[EDGE_STAT_CHECKSUM_ERRORS], 1);
+    assert_int_equal(snap.counters[EDGE_STAT_SCRATCH_OVERFLOWS], 1);
+    assert_int_equal(snap.counters[EDGE_STAT_RESYNC_BYTES], 7);
+    uint64_t p50 = edge_stats_percentile(&snap, 0.5), p99 = edge_stats_percentile(&snap, 0.99);
+    assert_true(p50 >= 500 && p50 <= 500 * 5 / 4);
+    assert_true(p99 >= 990 && p99 <= 990 * 5 / 4);
+    assert_true(edge_stats_percentile(&snap, 1.0) >= 1000);
+
+    edge_stats_reset(&st);
+    edge_stats_snapshot(&st, &snap);
+    assert_int_equal(snap.counters[EDGE_STAT_FRAMES_RX], 0);
+    assert_int_equal(edge_stats_percentile(&snap, 0.5), 0);
+}
+#endif
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_vector_scratch_overflow),
+        cmocka_unit_test(test_vector_bump_arena_large_frame),
+        cmocka_unit_test(test_vector_slab_arena_chaining),
+        cmocka_unit_test(test_vector_thread_arena),
         cmocka_unit_test(test_cursor_fragmented_read),
         cmocka_unit_test(test_cursor_empty_iovec),
+        cmocka_unit_test(test_cursor_remaining_and_fast_path),
+        cmocka_unit_test(test_cursor_scan_patterns),
+        cmocka_unit_test(test_cursor_scan_long_buffers),
+        cmocka_unit_test(test_vector_patch_lookup),
+        cmocka_unit_test(test_vector_incremental_checksum),
+        cmocka_unit_test(test_cursor_checksum_fragmented),
+        cmocka_unit_test(test_vector_finalize_coalesce),
+        cmocka_unit_test(test_vector_own_segment),
+        cmocka_unit_test(test_vector_truncate),
+        cmocka_unit_test(test_cursor_slice_bounded),
+        cmocka_unit_test(test_bulk_endian_arrays),
+        cmocka_unit_test(test_frame_template_incremental_checks),
+#if EDGE_ENABLE_STATS
+        cmocka_unit_test(test_stats_record_snapshot),
+#endif
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include "cmocka.h"
+#include "common/crc.h"
+
+static const edge_crc_engine_t k_engines[] = {
+    EDGE_CRC_ENGINE_BITWISE, EDGE_CRC_ENGINE_SLICE4, EDGE_CRC_ENGINE_SLICE8, EDGE_CRC_ENGINE_CLMUL,
+};
+
+/**
+ * @brief 标准校验值 ("123456789")：X-25 / MODBUS / DNP
+ */
+static void test_crc_check_values(void **state) {
+    (void)state;
+    const uint8_t msg[] = "123456789";
+    for (size_t e = 0; e < sizeof(k_engines) / sizeof(k_engines[0]); e++) {
+        if (!edge_crc_set_engine(k_engines[e])) continue;
+        assert_int_equal(edge_crc16_ccitt(msg, 9), 0x906E);
+        assert_int_equal(edge_crc16_modbus(msg, 9), 0x4B37);
+        assert_int_equal(edge_crc16_dnp3(msg, 9), 0xEA82);
+    }
+    assert_true(edge_crc_set_engine(EDGE_CRC_ENGINE_AUTO));
+}
+
+/**
+ * @brief [专家级测试] 各引擎在任意长度/对齐/分段续算下与逐位实现一致
+ */
+static void test_crc_engines_match_bitwise(void **state) {
+    (void)state;
+    static uint8_t buf[1024 + 16];
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < sizeof(buf); i++) { seed = seed * 1103515245u + 12345u; buf[i] = (uint8_t)(seed >> 16); }
+
+    for (size_t len = 0; len <= 1024; len += (len < 200) ? 1 : 37) {
+        for (size_t off = 0; off < 3; off++) {
+            const uint8_t *p = buf + off;
+            assert_true(edge_crc_set_engine(EDGE_CRC_ENGINE_BITWISE));
+            uint16_t ref_ccitt = edge_crc16_ccitt(p, len);
+            uint16_t ref_modbus = edge_crc16_modbus(p, len);
+            uint16_t ref_dnp3 = edge_crc16_dnp3(p, len);
+            for (size_t e = 1; e < sizeof(k_engines) / sizeof(k_engines[0]); e++) {
+                if (!edge_crc_set_engine(k_engines[e])) continue;
+                assert_int_equal(edge_crc16_ccitt(p, len), ref_ccitt);
+                assert_int_equal(edge_crc16_modbus(p, len), ref_modbus);
+                assert_int_equal(edge_crc16_dnp3(p, len), ref_dnp3);
+                // 分两段续算结果不变
+                uint16_t part = edge_crc16_modbus_update(0xFFFF, p, len / 3);
+                assert_int_equal(edge_crc16_modbus_update(part, p + len / 3, len - len / 3), ref_modbus);
+            }
+        }
+    }
+    assert_true(edge_crc_set_engine(EDGE_CRC_ENGINE_AUTO));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_crc_check_values),
+        cmocka_unit_test(test_crc_engines_match_bitwise),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -5,6 +5,7 @@
 #include <string.h>
 #include "cmocka.h"
 #include "protocols/edge_dlms.h"
+#include "common/crc.h"
 
 static void test_dlms_axdr_expert_nesting(void **state) {
     (void)state;
@@ -60,10 +61,648 @@ static void test_dlms_server_dispatch_basic(void **state) {
     assert_int_equal(resp_data[1], 0x01);
 }
 
+/**
+ * @brief [专家级测试] 资源索引：属性精确匹配、属性 0 通配、方法与属性分开登记、重复登记被拒绝
+ */
+static void test_dlms_index_lookup(void **state) {
+    (void)state;
+    static edge_dlms_resource_t res[300];
+    for (int i = 0; i < 300; i++) {
+        res[i] = (edge_dlms_resource_t){ .obj = { .class_id = 3, .obis = { 1, 0, (uint8_t)(i / 64), 8, (uint8_t)(i % 64), 255 },
+                                                  .attribute_index = 2 }, .on_get = mock_get_handler };
+    }
+    res[298].obj = (edge_dlms_object_t){ .class_id = 8, .obis = { 0, 0, 1, 0, 0, 255 }, .attribute_index = 0 };
+    res[299].obj = (edge_dlms_object_t){ .class_id = 8, .obis = { 0, 0, 1, 0, 0, 255 }, .attribute_index = -1 };
+
+    edge_dlms_index_slot_t slots[1024]; edge_dlms_index_t idx;
+    assert_int_equal(edge_dlms_index_build(&idx, slots, 512, res, 300), EP_ERR_BUFFER_TOO_SMALL);
+    assert_int_equal(edge_dlms_index_build(&idx, slots, 1000, res, 300), EP_OK);
+    for (int i = 0; i < 298; i++) assert_ptr_equal(edge_dlms_index_find(&idx, 3, res[i].obj.obis, 2), &res[i]);
+    assert_null(edge_dlms_index_find(&idx, 3, res[0].obj.obis, 3));
+    assert_null(edge_dlms_index_find(&idx, 4, res[0].obj.obis, 2));
+
+    const uint8_t clock[6] = { 0, 0, 1, 0, 0, 255 };
+    assert_ptr_equal(edge_dlms_index_find(&idx, 8, clock, 2), &res[298]);
+    assert_ptr_equal(edge_dlms_index_find(&idx, 8, clock, -1), &res[299]);
+    assert_null(edge_dlms_index_find(&idx, 8, clock, -2));
+
+    res[1].obj = res[0].obj;
+    assert_int_equal(edge_dlms_index_build(&idx, slots, 1024, res, 300), EP_ERR_INVALID_ARG);
+    assert_null(edge_dlms_index_find(&idx, 3, res[0].obj.obis, 2));
+
+    // 分发经索引命中
+    res[1].obj.obis[4] = 1;
+    edge_dlms_context_t ctx = {0};
+    ctx.resources = res; ctx.resource_count = 300;
+    assert_int_equal(edge_dlms_server_build_index(&ctx, slots, 1024), EP_OK);
+    uint8_t req_raw[] = { 192, 0x01, 0x07, 0x00, 0x03, 1,0,4,8,0x29,255, 0x02, 0x00 };
+    struct iovec iov = { .iov_base = req_raw, .iov_len = sizeof(req_raw) };
+    edge_cursor_t c; edge_cursor_init(&c, &iov, 1);
+    struct iovec resp_iov[4]; edge_vector_t v; edge_vector_init(&v, resp_iov, 4);
+    assert_int_equal(edge_dlms_server_dispatch(&ctx, &c, &v), EP_OK);
+    uint8_t out[8]; size_t n;
+    assert_int_equal(edge_vector_flatten(&v, out, sizeof(out), &n), EP_OK);
+    assert_int_equal(n, 5);
+    assert_int_equal(out[2], 0x07);
+    assert_int_equal(out[3], 0x00);
+    assert_int_equal(out[4], DLMS_TAG_NULL_DATA);
+}
+
+static uint32_t g_energy = 123456;
+
+static edge_error_t energy_get(const edge_dlms_object_t *obj, edge_dlms_variant_t *val, void *user) {
+    (void)obj;
+    static uint8_t be[4];
+    uint32_t e = *(uint32_t *)user;
+    be[0] = (uint8_t)(e >> 24); be[1] = (uint8_t)(e >> 16); be[2] = (uint8_t)(e >> 8); be[3] = (uint8_t)e;
+    val->tag = DLMS_TAG_DOUBLE_LONG_UNSIGNED; val->length = 4; val->data = be;
+    return EP_OK;
+}
+
+static edge_error_t energy_set(const edge_dlms_object_t *obj, edge_dlms_variant_t *val, void *user) {
+    (void)obj;
+    if (val->tag != DLMS_TAG_DOUBLE_LONG_UNSIGNED) return EP_ERR_INVALID_ARG;
+    const uint8_t *p = val->data;
+    *(uint32_t *)user = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    return EP_OK;
+}
+
+static edge_error_t name_get(const edge_dlms_object_t *obj, edge_dlms_variant_t *val, void *user) {
+    (void)obj; (void)user;
+    val->tag = DLMS_TAG_OCTET_STRING; val->length = 3; val->data = (const uint8_t *)"ABC";
+    return EP_OK;
+}
+
+static edge_error_t clock_get(const edge_dlms_object_t *obj, edge_dlms_variant_t *val, void *user) {
+    (void)user;
+    static uint8_t attr;
+    attr = (uint8_t)obj->attribute_index;
+    val->tag = DLMS_TAG_UNSIGNED; val->length = 1; val->data = &attr;
+    return EP_OK;
+}
+
+static edge_error_t disconnect_action(const edge_dlms_object_t *obj, const edge_dlms_variant_t *params, edge_dlms_variant_t *ret, void *user) {
+    (void)obj; (void)user;
+    static const uint8_t state = 1;
+    if (params->tag != DLMS_TAG_INTEGER || params->data[0] != 5) return EP_ERR_INVALID_ARG;
+    ret->tag = DLMS_TAG_ENUM; ret->length = 1; ret->data = &state;
+    return EP_OK;
+}
+
+static size_t dispatch_raw(edge_dlms_context_t *ctx, const uint8_t *req, size_t len, uint8_t *out, size_t cap) {
+    struct iovec iov = { .iov_base = (void *)req, .iov_len = len };
+    edge_cursor_t c; edge_cursor_init(&c, &iov, 1);
+    struct iovec resp_iov[32]; edge_vector_t v; edge_vector_init(&v, resp_iov, 32);
+    assert_int_equal(edge_dlms_server_dispatch(ctx, &c, &v), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+    size_t n;
+    assert_int_equal(edge_vector_flatten(&v, out, cap, &n), EP_OK);
+    return n;
+}
+
+/**
+ * @brief [专家级测试] GET-With-List / SET-With-List / ACTION-Normal 逐项结果编码进单个响应
+ */
+static void test_dlms_server_list_services(void **state) {
+    (void)state;
+    const edge_dlms_resource_t res[] = {
+        { .obj = { 3, { 1,0,1,8,0,255 }, 2 }, .on_get = energy_get, .on_set = energy_set, .user_data = &g_energy },
+        { .obj = { 1, { 0,0,96,1,0,255 }, 2 }, .on_get = name_get },
+        { .obj = { 8, { 0,0,1,0,0,255 }, 0 }, .on_get = clock_get },
+        { .obj = { 70, { 0,0,96,3,10,255 }, -1 }, .on_action = disconnect_action },
+    };
+    edge_dlms_context_t ctx = {0};
+    ctx.resources = res; ctx.resource_count = 4;
+    edge_dlms_index_slot_t slots[8];
+    assert_int_equal(edge_dlms_server_build_index(&ctx, slots, 8), EP_OK);
+    uint8_t out[64]; size_t n;
+
+    static const uint8_t get_list[] = { 0xC0, 0x03, 0x81, 0x04,
+        0x00, 0x03, 1,0,1,8,0,255, 0x02, 0x00,
+        0x00, 0x01, 0,0,96,1,0,255, 0x02, 0x00,
+        0x00, 0x03, 1,0,2,8,0,255, 0x02, 0x00,
+        0x00, 0x08, 0,0,1,0,0,255, 0x05, 0x00 };
+    static const uint8_t get_exp[] = { 0xC4, 0x03, 0x81, 0x04,
+        0x00, 0x06, 0x00, 0x01, 0xE2, 0x40,
+        0x00, 0x09, 0x03, 'A', 'B', 'C',
+        0x01, DLMS_DAR_OBJECT_UNDEFINED,
+        0x00, 0x11, 0x05 };
+    n = dispatch_raw(&ctx, get_list, sizeof(get_list), out, sizeof(out));
+    assert_int_equal(n, sizeof(get_exp));
+    assert_memory_equal(out, get_exp, n);
+
+    static const uint8_t set_list[] = { 0xC1, 0x04, 0x82, 0x02,
+        0x00, 0x03, 1,0,1,8,0,255, 0x02, 0x00,
+        0x00, 0x01, 0,0,96,1,0,255, 0x02, 0x00,
+        0x02, 0x06, 0x00, 0x00, 0x00, 0x2A, 0x09, 0x01, 0xFF };
+    static const uint8_t set_exp[] = { 0xC5, 0x05, 0x82, 0x02, DLMS_DAR_SUCCESS, DLMS_DAR_READ_WRITE_DENIED };
+    n = dispatch_raw(&ctx, set_list, sizeof(set_list), out, sizeof(out));
+    assert_int_equal(n, sizeof(set_exp));
+    assert_memory_equal(out, set_exp, n);
+    assert_int_equal(g_energy, 42);
+
+    static const uint8_t set_bad[] = { 0xC1, 0x01, 0x83, 0x00, 0x03, 1,0,1,8,0,255, 0x02, 0x00, 0x12, 0x00, 0x07 };
+    static const uint8_t set_bad_exp[] = { 0xC5, 0x01, 0x83, DLMS_DAR_TYPE_UNMATCHED };
+    n = dispatch_raw(&ctx, set_bad, sizeof(set_bad), out, sizeof(out));
+    assert_int_equal(n, sizeof(set_bad_exp));
+    assert_memory_equal(out, set_bad_exp, n);
+
+    static const uint8_t action[] = { 0xC3, 0x01, 0x84, 0x00, 0x46, 0,0,96,3,10,255, 0x01, 0x01, 0x0F, 0x05 };
+    static const uint8_t action_exp[] = { 0xC7, 0x01, 0x84, DLMS_DAR_SUCCESS, 0x01, 0x00, DLMS_TAG_ENUM, 0x01 };
+    n = dispatch_raw(&ctx, action, sizeof(action), out, sizeof(out));
+    assert_int_equal(n, sizeof(action_exp));
+    assert_memory_equal(out, action_exp, n);
+
+    static const uint8_t action_undef[] = { 0xC3, 0x01, 0x85, 0x00, 0x46, 0,0,96,3,10,255, 0x02, 0x00 };
+    static const uint8_t undef_exp[] = { 0xC7, 0x01, 0x85, DLMS_DAR_OBJECT_UNDEFINED, 0x00 };
+    n = dispatch_raw(&ctx, action_undef, sizeof(action_undef), out, sizeof(out));
+    assert_int_equal(n, sizeof(undef_exp));
+    assert_memory_equal(out, undef_exp, n);
+}
+
+typedef struct { size_t pos, total; } profile_gen_t;
+
+// 负载曲线生成器：octet-string (长度 total) 逐字节为下标低 8 位，每次至多写 37 字节
+static edge_error_t profile_stream(const edge_dlms_object_t *obj, bool first, uint8_t *buf, size_t cap, size_t *len, bool *done, void *user) {
+    (void)obj;
+    profile_gen_t *g = user;
+    if (first) g->pos = 0;
+    size_t n = 0, enc_len = g->total + 4;
+    while (n < cap && n < 37 && g->pos < enc_len) {
+        size_t p = g->pos++;
+        buf[n++] = p == 0 ? DLMS_TAG_OCTET_STRING : p == 1 ? 0x82 : p == 2 ? (uint8_t)(g->total >> 8) : p == 3 ? (uint8_t)g->total : (uint8_t)(p - 4);
+    }
+    *len = n;
+    *done = g->pos == enc_len;
+    return EP_OK;
+}
+
+/**
+ * @brief [专家级测试] 流式 GET：按 max_pdu_send 切块，GET-Request-Next 续传/重传，块号错误终止
+ */
+static void test_dlms_server_stream_blocks(void **state) {
+    (void)state;
+    static profile_gen_t gen = { 0, 1000 };
+    const edge_dlms_resource_t res[] = {
+        { .obj = { 7, { 1,0,99,1,0,255 }, 2 }, .on_stream = profile_stream, .user_data = &gen },
+    };
+    edge_dlms_context_t ctx = {0};
+    ctx.resources = res; ctx.resource_count = 1; ctx.max_pdu_send = 128;
+    static uint8_t block_buf[256];
+    edge_dlms_server_set_block_buffer(&ctx, block_buf, sizeof(block_buf));
+
+    static uint8_t got[1100];
+    uint8_t out[160]; size_t n, total = 0;
+    uint8_t req[13] = { 0xC0, 0x01, 0x41, 0x00, 0x07, 1,0,99,1,0,255, 0x02, 0x00 };
+    n = dispatch_raw(&ctx, req, sizeof(req), out, sizeof(out));
+    for (uint32_t block = 1;; block++) {
+        assert_true(n <= ctx.max_pdu_send);
+        assert_int_equal(out[0], 0xC4);
+        assert_int_equal(out[1], 0x02);
+        assert_int_equal(out[2], 0x41);
+        assert_int_equal(((uint32_t)out[4] << 24) | ((uint32_t)out[5] << 16) | ((uint32_t)out[6] << 8) | out[7], block);
+        assert_int_equal(out[8], 0x00);
+        assert_int_equal(out[9], n - 10);
+        memcpy(got + total, out + 10, n - 10); total += n - 10;
+        if (out[3]) break;
+
+        uint8_t next[7] = { 0xC0, 0x02, 0x41, (uint8_t)(block >> 24), (uint8_t)(block >> 16), (uint8_t)(block >> 8), (uint8_t)block };
+        if (block == 2) {
+            // 客户端未收到第 2 块：以块号 1 重发 Next，应得到同一块
+            uint8_t again[7] = { 0xC0, 0x02, 0x41, 0, 0, 0, 1 }, dup[160];
+            size_t m = dispatch_raw(&ctx, again, sizeof(again), dup, sizeof(dup));
+            assert_int_equal(m, n);
+            assert_memory_equal(dup, out, m);
+        }
+        n = dispatch_raw(&ctx, next, sizeof(next), out, sizeof(out));
+    }
+    assert_int_equal(total, 1004);
+    assert_int_equal(got[0], DLMS_TAG_OCTET_STRING);
+    for (size_t i = 0; i < 1000; i++) assert_int_equal(got[4 + i], (uint8_t)i);
+
+    // 传输结束后再发 Next：no-long-get-in-progress
+    uint8_t stale[7] = { 0xC0, 0x02, 0x41, 0, 0, 0, 9 };
+    n = dispatch_raw(&ctx, stale, sizeof(stale), out, sizeof(out));
+    assert_int_equal(n, 10);
+    assert_int_equal(out[8], 0x01);
+    assert_int_equal(out[9], DLMS_DAR_NO_LONG_GET_IN_PROGRESS);
+
+    // 块号跳跃：data-block-number-invalid 并终止传输
+    n = dispatch_raw(&ctx, req, sizeof(req), out, sizeof(out));
+    uint8_t skip[7] = { 0xC0, 0x02, 0x41, 0, 0, 0, 5 };
+    n = dispatch_raw(&ctx, skip, sizeof(skip), out, sizeof(out));
+    assert_int_equal(out[9], DLMS_DAR_DATA_BLOCK_NUMBER_INVALID);
+    uint8_t first_ack[7] = { 0xC0, 0x02, 0x41, 0, 0, 0, 1 };
+    n = dispatch_raw(&ctx, first_ack, sizeof(first_ack), out, sizeof(out));
+    assert_int_equal(out[9], DLMS_DAR_NO_LONG_GET_IN_PROGRESS);
+
+    // 一个 PDU 装得下时直接回 GET-Response-Normal
+    gen.total = 20;
+    n = dispatch_raw(&ctx, req, sizeof(req), out, sizeof(out));
+    assert_int_equal(n, 4 + 24);
+    assert_int_equal(out[1], 0x01);
+    assert_int_equal(out[3], 0x00);
+    assert_int_equal(out[4], DLMS_TAG_OCTET_STRING);
+    assert_int_equal(out[4 + 4 + 19], 19);
+}
+
+/**
+ * @brief [专家级测试] 客户端分块重组：对接流式服务端，块链经池分配，逐块到达即增量解码
+ */
+static void test_dlms_client_block_reassembly(void **state) {
+    (void)state;
+    static profile_gen_t gen = { 0, 1000 };
+    const edge_dlms_resource_t res[] = {
+        { .obj = { 7, { 1,0,99,1,0,255 }, 2 }, .on_stream = profile_stream, .user_data = &gen },
+    };
+    edge_dlms_context_t server = {0};
+    server.resources = res; server.resource_count = 1; server.max_pdu_send = 128;
+    static uint8_t block_buf[256];
+    edge_dlms_server_set_block_buffer(&server, block_buf, sizeof(block_buf));
+
+    static uint8_t pool_mem[16 * 128];
+    edge_pool_t pool; edge_pool_init(&pool, pool_mem, 128, 16);
+    struct iovec chain[16]; edge_dlms_block_rx_t rx;
+    edge_dlms_block_rx_init(&rx, chain, 16, &pool.base);
+
+    struct iovec qi[4]; edge_vector_t q; edge_vector_init(&q, qi, 4);
+    edge_dlms_encoder_t enc; edge_dlms_encoder_init(&enc, &q);
+    const edge_dlms_object_t obj = { 7, { 1,0,99,1,0,255 }, 2 };
+    assert_int_equal(edge_dlms_build_get_request(&enc, DLMS_GET_NORMAL, 0x41, &obj), EP_OK);
+
+    edge_cursor_t stream; uint32_t stream_gen = 0; size_t decoded = 0; int rounds = 0;
+    for (;; rounds++) {
+        edge_cursor_t qc; edge_cursor_init(&qc, q.iovs, q.used_count);
+        struct iovec ri[8]; edge_vector_t r; edge_vector_init(&r, ri, 8);
+        assert_int_equal(edge_dlms_server_dispatch(&server, &qc, &r), EP_OK);
+        edge_cursor_t rc; edge_cursor_init(&rc, r.iovs, r.used_count);
+        edge_error_t err = edge_dlms_block_rx_feed(&rx, &rc);
+
+        if (rounds == 0) {
+            // 首块到达即可解析 octet-string 头部
+            stream_gen = edge_dlms_block_rx_cursor(&rx, &stream);
+            uint8_t tag, lf; uint16_t len;
+            assert_int_equal(edge_cursor_read_u8(&stream, &tag), EP_OK);
+            assert_int_equal(edge_cursor_read_u8(&stream, &lf), EP_OK);
+            assert_int_equal(edge_cursor_read_be16(&stream, &len), EP_OK);
+            assert_int_equal(tag, DLMS_TAG_OCTET_STRING);
+            assert_int_equal(len, 1000);
+        } else {
+            assert_int_equal(edge_dlms_block_rx_extend(&rx, &stream, stream_gen), EP_OK);
+        }
+        uint8_t b;
+        while (edge_cursor_read_u8(&stream, &b) == EP_OK) { assert_int_equal(b, (uint8_t)decoded); decoded++; }
+        if (err == EP_OK) break;
+        assert_int_equal(err, EP_ERR_INCOMPLETE_DATA);
+
+        edge_vector_init(&q, qi, 4); edge_dlms_encoder_init(&enc, &q);
+        assert_int_equal(edge_dlms_block_rx_build_next(&rx, &enc), EP_OK);
+    }
+    assert_int_equal(decoded, 1000);
+    assert_int_equal(rx.block, 9);
+    assert_int_equal(rx.chain_count, 9);
+    assert_int_equal(edge_dlms_block_rx_build_next(&rx, &enc), EP_ERR_INVALID_STATE);
+
+    // 块号 1 重启释放旧链：旧 cursor 不能再延长，须重新创建
+    uint8_t restart[] = { 0xC4, 0x02, 0x41, 0x00, 0, 0, 0, 1, 0x00, 0x01, 0xAA };
+    struct iovec rsi = { restart, sizeof(restart) };
+    edge_cursor_t rsc; edge_cursor_init(&rsc, &rsi, 1);
+    assert_int_equal(edge_dlms_block_rx_feed(&rx, &rsc), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(edge_dlms_block_rx_extend(&rx, &stream, stream_gen), EP_ERR_INVALID_STATE);
+    stream_gen = edge_dlms_block_rx_cursor(&rx, &stream);
+    assert_int_equal(edge_dlms_block_rx_extend(&rx, &stream, stream_gen), EP_OK);
+    uint8_t first;
+    assert_int_equal(edge_cursor_read_u8(&stream, &first), EP_OK);
+    assert_int_equal(first, 0xAA);
+    assert_int_equal(edge_cursor_remaining(&stream), 0);
+
+    // 跳号被拒绝；服务端以 data-access-result 回应时给出结果码
+    edge_dlms_block_rx_reset(&rx);
+    uint8_t jump[] = { 0xC4, 0x02, 0x41, 0x00, 0, 0, 0, 3, 0x00, 0x01, 0xAA };
+    struct iovec ji = { jump, sizeof(jump) };
+    edge_cursor_t jc; edge_cursor_init(&jc, &ji, 1);
+    assert_int_equal(edge_dlms_block_rx_feed(&rx, &jc), EP_ERR_INVALID_FRAME);
+    uint8_t denied[] = { 0xC4, 0x01, 0x41, 0x01, DLMS_DAR_READ_WRITE_DENIED };
+    struct iovec di = { denied, sizeof(denied) };
+    edge_cursor_t dc; edge_cursor_init(&dc, &di, 1);
+    assert_int_equal(edge_dlms_block_rx_feed(&rx, &dc), EP_ERR_GENERIC);
+    assert_int_equal(rx.dar, DLMS_DAR_READ_WRITE_DENIED);
+
+    // 所有块已归还池
+    void *blocks[16];
+    for (int i = 0; i < 16; i++) assert_non_null(blocks[i] = edge_alloc(&pool.base, 128));
+    for (int i = 0; i < 16; i++) edge_free(&pool.base, blocks[i], 128);
+}
+
+/**
+ * @brief [专家级测试] HDLC I 帧 HCS/FCS 为真实 CRC，且解析可还原 APDU
+ */
+static void test_hdlc_iframe_hcs_fcs(void **state) {
+    (void)state;
+    edge_hdlc_manager_t mgr; edge_hdlc_init(&mgr, 0x10, 0x01);
+    static const uint8_t apdu[] = { 0xC0, 0x01, 0xC1, 0x00, 0x08 };
+    struct iovec iov[16]; edge_vector_t v; edge_vector_init(&v, iov, 16);
+    assert_int_equal(edge_hdlc_build_iframe(&mgr, &v, apdu, sizeof(apdu), true), EP_OK);
+
+    uint8_t frame[64]; size_t n = 0;
+    for (int i = 0; i < v.used_count; i++) { memcpy(frame + n, v.iovs[i].iov_base, v.iovs[i].iov_len); n += v.iovs[i].iov_len; }
+    assert_int_equal(n, sizeof(apdu) + 11);
+    assert_int_equal(((frame[1] & 0x07) << 8) | frame[2], n - 2);
+    uint16_t hcs = edge_crc16_ccitt(frame + 1, 5), fcs = edge_crc16_ccitt(frame + 1, n - 4);
+    assert_int_equal(frame[6] | (frame[7] << 8), hcs);
+    assert_int_equal(frame[n - 3] | (frame[n - 2] << 8), fcs);
+
+    struct iovec rx = { .iov_base = frame, .iov_len = n };
+    edge_cursor_t c; edge_cursor_init(&c, &rx, 1);
+    uint8_t out[16]; size_t out_len = sizeof(out);
+    assert_int_equal(edge_hdlc_parse(&mgr, &c, out, &out_len), EP_OK);
+    assert_int_equal(out_len, sizeof(apdu));
+    assert_memory_equal(out, apdu, sizeof(apdu));
+}
+
+/**
+ * @brief [专家级测试] 直接在发送向量上解析，APDU 子 cursor 指向原始缓冲区；HCS/FCS 校验与流内定位
+ */
+static void test_hdlc_parse_slice_zero_copy(void **state) {
+    (void)state;
+    edge_hdlc_manager_t mgr; edge_hdlc_init(&mgr, 0x10, 0x01);
+    static const uint8_t apdu[] = { 0xC0, 0x01, 0xC1, 0x00, 0x08, 0x00, 0x00, 0x01 };
+    struct iovec iov[16]; edge_vector_t v; edge_vector_init(&v, iov, 16);
+    assert_int_equal(edge_hdlc_build_iframe(&mgr, &v, apdu, sizeof(apdu), true), EP_OK);
+
+    edge_cursor_t c; edge_cursor_init(&c, v.iovs, v.used_count);
+    edge_cursor_t sub;
+    assert_int_equal(edge_hdlc_parse_slice(&mgr, &c, &sub), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&sub), sizeof(apdu));
+    assert_ptr_equal(edge_cursor_get_ptr(&sub, sizeof(apdu)), apdu);
+    assert_int_equal(edge_cursor_remaining(&c), 0); // FCS 与结束标志已消费
+
+    // 两帧首尾相接：逐帧前进
+    uint8_t stream[64]; size_t n, len;
+    assert_int_equal(edge_vector_flatten(&v, stream, sizeof(stream), &len), EP_OK);
+    memcpy(stream + len, stream, len); n = 2 * len;
+    struct iovec si = { stream, n };
+    edge_cursor_init(&c, &si, 1);
+    assert_int_equal(edge_hdlc_parse_slice(&mgr, &c, &sub), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&c), len);
+    assert_int_equal(edge_hdlc_parse_slice(&mgr, &c, &sub), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&sub), sizeof(apdu));
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+
+    // 半帧：不消费起始标志
+    si.iov_len = len - 1; edge_cursor_init(&c, &si, 1);
+    assert_int_equal(edge_hdlc_parse_slice(&mgr, &c, &sub), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(edge_cursor_remaining(&c), len - 1);
+
+    // FCS 损坏：越过整帧，下一帧照常解析
+    si.iov_len = n; stream[len - 4] ^= 0x01;
+    edge_cursor_init(&c, &si, 1);
+    assert_int_equal(edge_hdlc_parse_slice(&mgr, &c, &sub), EP_ERR_CHECKSUM);
+    assert_int_equal(edge_cursor_remaining(&c), len);
+    assert_int_equal(edge_hdlc_parse_slice(&mgr, &c, &sub), EP_OK);
+    stream[len - 4] ^= 0x01;
+
+    // HCS 损坏：只越过起始标志重新搜索
+    stream[5] ^= 0x01;
+    edge_cursor_init(&c, &si, 1);
+    assert_int_equal(edge_hdlc_parse_slice(&mgr, &c, &sub), EP_ERR_CHECKSUM);
+    assert_int_equal(edge_cursor_remaining(&c), n - 1);
+}
+
+/**
+ * @brief [专家级测试] I 帧模板逐帧改写控制字节后与重新构建的帧逐字节一致
+ */
+static void test_hdlc_template_matches_builder(void **state) {
+    (void)state;
+    static const uint8_t apdu[] = { 0xC0, 0x01, 0xC1, 0x00, 0x03, 0x01, 0x00, 0x01, 0x08, 0x00, 0xFF, 0x02, 0x00 };
+    edge_hdlc_manager_t a, b; edge_hdlc_init(&a, 0x10, 0x01); edge_hdlc_init(&b, 0x10, 0x01);
+    uint8_t tbuf[64]; edge_frame_template_t t; edge_template_init(&t, tbuf, sizeof(tbuf));
+    assert_int_equal(edge_hdlc_template_iframe(&a, &t, apdu, sizeof(apdu)), EP_OK);
+
+    for (int i = 0; i < 20; i++) {
+        a.nr = b.nr = (uint8_t)(i * 3 % 8);
+        struct iovec i1[8], i2[8]; edge_vector_t v1, v2;
+        edge_vector_init(&v1, i1, 8); edge_vector_init(&v2, i2, 8);
+        assert_int_equal(edge_hdlc_template_emit(&a, &t, &v1), EP_OK);
+        assert_int_equal(edge_hdlc_build_iframe(&b, &v2, apdu, sizeof(apdu), true), EP_OK);
+        uint8_t f1[64], f2[64]; size_t n1, n2;
+        assert_int_equal(edge_vector_flatten(&v1, f1, sizeof(f1), &n1), EP_OK);
+        assert_int_equal(edge_vector_flatten(&v2, f2, sizeof(f2), &n2), EP_OK);
+        assert_int_equal(n1, n2);
+        assert_memory_equal(f1, f2, n1);
+        assert_int_equal(v1.used_count, 1);
+    }
+}
+
+/**
+ * @brief 安全套件 0：Green Book 示例 (EK 00..0F, AK D0..DF, ST 4D4D4D0000BC614E, IC 01234567)
+ * 明文分散在 scratch 与两个引用段上，原地加密后逐字节比对；接收端在碎片化 cursor 上解密，
+ * 篡改标签时返回 EP_ERR_CHECKSUM 且密文复原。
+ */
+static void test_dlms_security_suite0(void **state) {
+    (void)state;
+    static const uint8_t k_title[8] = { 0x4D, 0x4D, 0x4D, 0x00, 0x00, 0xBC, 0x61, 0x4E };
+    static const uint8_t k_plain[13] = { 0xC0, 0x01, 0x00, 0x00, 0x08, 0x00, 0x00, 0x01, 0x00, 0x00, 0xFF, 0x02, 0x00 };
+    static const uint8_t k_ciphered[] = {
+        0x30, 0x01, 0x23, 0x45, 0x67,
+        0x41, 0x13, 0x12, 0xFF, 0x93, 0x5A, 0x47, 0x56, 0x68, 0x27, 0xC4, 0x67, 0xBC,
+        0x7D, 0x82, 0x5C, 0x3B, 0xE4, 0xA7, 0x7C, 0x3F, 0xCC, 0x05, 0x6B, 0x6B,
+    };
+    static const uint8_t k_auth_tag[12] = { 0x06, 0x72, 0x5D, 0x91, 0x0F, 0x92, 0x21, 0xD2, 0x63, 0x87, 0x75, 0x16 };
+    uint8_t ek[16], ak[16];
+    for (int i = 0; i < 16; i++) { ek[i] = (uint8_t)i; ak[i] = (uint8_t)(0xD0 + i); }
+
+    edge_dlms_security_ctx_t tx = { .policy = EDGE_DLMS_SEC_AUTH_ENCRYPTED, .invocation_counter = 0x01234567 };
+    memcpy(tx.system_title, k_title, 8);
+    edge_dlms_security_set_keys(&tx, ek, ak);
+    edge_dlms_security_ctx_t rx = tx;
+
+    uint8_t part1[6], part2[4], wire[64];
+    memcpy(part1, k_plain + 3, 6);
+    memcpy(part2, k_plain + 9, 4);
+    struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8);
+    assert_int_equal(edge_vector_append_copy(&v, k_plain, 3), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, part1, 6), EP_OK);
+    assert_int_equal(edge_vector_append_ref(&v, part2, 4), EP_OK);
+    assert_int_equal(edge_dlms_encrypt_apdu(&tx, &v, DLMS_SC_AUTHENTICATION | DLMS_SC_ENCRYPTION), EP_OK);
+    assert_int_equal(tx.invocation_counter, 0x01234568);
+    // append_ref 引用的调用方内存保持明文
+    assert_memory_equal(part1, k_plain + 3, 6);
+    assert_memory_equal(part2, k_plain + 9, 4);
+    size_t n = 0;
+    assert_int_equal(edge_vector_flatten(&v, wire, sizeof(wire), &n), EP_OK);
+    assert_int_equal(n, sizeof(k_ciphered));
+    assert_memory_equal(wire, k_ciphered, n);
+
+    // 接收端：SH | 密文 | 标签 跨 3 段，解密后子 cursor 只覆盖明文
+    struct iovec riov[3] = { { wire, 7 }, { wire + 7, 15 }, { wire + 22, n - 22 } };
+    edge_cursor_t c, apdu; edge_cursor_init(&c, riov, 3);
+    uint32_t ic = 0;
+    assert_int_equal(edge_dlms_decrypt_apdu(&rx, k_title, &c, &apdu, &ic), EP_OK);
+    assert_int_equal(ic, 0x01234567);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+    uint8_t plain[13];
+    assert_int_equal(edge_cursor_remaining(&apdu), sizeof(plain));
+    assert_int_equal(edge_cursor_read_bytes(&apdu, plain, sizeof(plain)), EP_OK);
+    assert_memory_equal(plain, k_plain, sizeof(plain));
+
+    // 篡改标签：拒绝且密文复原
+    memcpy(wire, k_ciphered, sizeof(k_ciphered));
+    wire[n - 1] ^= 0x01;
+    edge_cursor_init(&c, riov, 3);
+    assert_int_equal(edge_dlms_decrypt_apdu(&rx, k_title, &c, &apdu, NULL), EP_ERR_CHECKSUM);
+    assert_memory_equal(wire, k_ciphered, n - 1);
+
+    // 仅认证 (SC 0x10)：明文原样发送，标签覆盖 SC || AK || APDU
+    tx.invocation_counter = 0x01234567;
+    edge_vector_init(&v, iov, 8);
+    assert_int_equal(edge_vector_append_copy(&v, k_plain, sizeof(k_plain)), EP_OK);
+    assert_int_equal(edge_dlms_encrypt_apdu(&tx, &v, DLMS_SC_AUTHENTICATION), EP_OK);
+    assert_int_equal(edge_vector_flatten(&v, wire, sizeof(wire), &n), EP_OK);
+    assert_int_equal(n, 5 + sizeof(k_plain) + 12);
+    assert_int_equal(wire[0], 0x10);
+    assert_memory_equal(wire + 5, k_plain, sizeof(k_plain));
+    assert_memory_equal(wire + 18, k_auth_tag, 12);
+    struct iovec aiov = { wire, n };
+    edge_cursor_init(&c, &aiov, 1);
+    assert_int_equal(edge_dlms_decrypt_apdu(&rx, k_title, &c, &apdu, NULL), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&apdu), sizeof(k_plain));
+
+    assert_int_equal(edge_dlms_encrypt_apdu(&tx, &v, 0x31), EP_ERR_NOT_SUPPORTED);
+
+    // 标签追加不下 (段表已满)：密文已生成，所用 IC 仍被消耗，重试不会复用 nonce
+    struct iovec small[2]; edge_vector_init(&v, small, 2);
+    assert_int_equal(edge_vector_append_ref(&v, part1, 6), EP_OK);
+    uint32_t before = tx.invocation_counter;
+    assert_int_equal(edge_dlms_encrypt_apdu(&tx, &v, DLMS_SC_AUTHENTICATION | DLMS_SC_ENCRYPTION), EP_ERR_BUFFER_TOO_SMALL);
+    assert_int_equal(tx.invocation_counter, before + 1);
+}
+
+/**
+ * @brief [专家级测试] 加密分块响应不改写服务端块缓冲区：按块号重发的块解密后与首次发出的一致
+ */
+static void test_dlms_security_block_resend(void **state) {
+    (void)state;
+    static profile_gen_t gen = { 0, 1000 };
+    const edge_dlms_resource_t res[] = {
+        { .obj = { 7, { 1,0,99,1,0,255 }, 2 }, .on_stream = profile_stream, .user_data = &gen },
+    };
+    edge_dlms_context_t ctx = {0};
+    ctx.resources = res; ctx.resource_count = 1; ctx.max_pdu_send = 128;
+    static uint8_t block_buf[256];
+    edge_dlms_server_set_block_buffer(&ctx, block_buf, sizeof(block_buf));
+
+    static const uint8_t k_title[8] = { 0x4D, 0x4D, 0x4D, 0x00, 0x00, 0xBC, 0x61, 0x4E };
+    uint8_t ek[16], ak[16];
+    for (int i = 0; i < 16; i++) { ek[i] = (uint8_t)(0x40 + i); ak[i] = (uint8_t)(0xD0 + i); }
+    edge_dlms_security_ctx_t tx = { .policy = EDGE_DLMS_SEC_AUTH_ENCRYPTED, .invocation_counter = 1 };
+    memcpy(tx.system_title, k_title, 8);
+    edge_dlms_security_set_keys(&tx, ek, ak);
+    edge_dlms_security_ctx_t rx = tx;
+
+    // 第 0 轮 GET-Normal 得到第 1 块；第 1 轮以块号 0 发 Next，服务端重发缓冲区中的第 1 块
+    const uint8_t get[13] = { 0xC0, 0x01, 0x41, 0x00, 0x07, 1,0,99,1,0,255, 0x02, 0x00 };
+    const uint8_t resend[7] = { 0xC0, 0x02, 0x41, 0, 0, 0, 0 };
+    static uint8_t arena_mem[512];
+    uint8_t plain[2][160], wire[200], dec[2][160];
+    size_t plen[2];
+    for (int round = 0; round < 2; round++) {
+        struct iovec qi = { (void *)(round ? resend : get), round ? sizeof(resend) : sizeof(get) };
+        edge_cursor_t q; edge_cursor_init(&q, &qi, 1);
+        edge_arena_bump_t arena; edge_arena_bump_init(&arena, arena_mem, sizeof(arena_mem));
+        struct iovec ri[8]; edge_vector_t r; edge_vector_init_arena(&r, ri, 8, &arena.base);
+        assert_int_equal(edge_dlms_server_dispatch(&ctx, &q, &r), EP_OK);
+        assert_int_equal(edge_vector_flatten(&r, plain[round], sizeof(plain[round]), &plen[round]), EP_OK);
+
+        assert_int_equal(edge_dlms_encrypt_apdu(&tx, &r, DLMS_SC_AUTHENTICATION | DLMS_SC_ENCRYPTION), EP_OK);
+        size_t n;
+        assert_int_equal(edge_vector_flatten(&r, wire, sizeof(wire), &n), EP_OK);
+        assert_int_equal(n, DLMS_SECURITY_HEADER_LEN + plen[round] + DLMS_GCM_TAG_LEN);
+
+        struct iovec wi = { wire, n };
+        edge_cursor_t c, apdu; edge_cursor_init(&c, &wi, 1);
+        assert_int_equal(edge_dlms_decrypt_apdu(&rx, k_title, &c, &apdu, NULL), EP_OK);
+        assert_int_equal(edge_cursor_remaining(&apdu), plen[round]);
+        assert_int_equal(edge_cursor_read_bytes(&apdu, dec[round], plen[round]), EP_OK);
+        assert_memory_equal(dec[round], plain[round], plen[round]);
+    }
+    assert_int_equal(plen[0], plen[1]);
+    assert_memory_equal(plain[1], plain[0], plen[0]);
+    assert_int_equal(plain[1][10], DLMS_TAG_OCTET_STRING);
+    for (size_t i = 14; i < plen[1]; i++) assert_int_equal(plain[1][i], (uint8_t)(i - 14));
+}
+
+#if EDGE_ENABLE_STATS
+// 发 GET-Normal 并以 GET-Next 续取，至多送入 max_blocks 块；返回最后一次 feed 的结果
+static edge_error_t blockrx_fetch(edge_dlms_context_t *server, edge_dlms_block_rx_t *rx, int max_blocks) {
+    const edge_dlms_object_t obj = { 7, { 1,0,99,1,0,255 }, 2 };
+    struct iovec qi[4]; edge_vector_t q; edge_vector_init(&q, qi, 4);
+    edge_dlms_encoder_t enc; edge_dlms_encoder_init(&enc, &q);
+    assert_int_equal(edge_dlms_build_get_request(&enc, DLMS_GET_NORMAL, 0x41, &obj), EP_OK);
+    edge_error_t err = EP_ERR_INCOMPLETE_DATA;
+    for (int n = 0; n < max_blocks && err == EP_ERR_INCOMPLETE_DATA; n++) {
+        if (n) { edge_vector_init(&q, qi, 4); edge_dlms_encoder_init(&enc, &q); assert_int_equal(edge_dlms_block_rx_build_next(rx, &enc), EP_OK); }
+        edge_cursor_t qc; edge_cursor_init(&qc, q.iovs, q.used_count);
+        struct iovec ri[8]; edge_vector_t r; edge_vector_init(&r, ri, 8);
+        assert_int_equal(edge_dlms_server_dispatch(server, &qc, &r), EP_OK);
+        edge_cursor_t rc; edge_cursor_init(&rc, r.iovs, r.used_count);
+        err = edge_dlms_block_rx_feed(rx, &rc);
+    }
+    return err;
+}
+
+/**
+ * @brief [专家级测试] 分块重启统计：连续两次完整读取不计重启，未收完时以块号 1 重来才计一次
+ */
+static void test_dlms_block_rx_restart_stat(void **state) {
+    (void)state;
+    static profile_gen_t gen = { 0, 300 };
+    const edge_dlms_resource_t res[] = {
+        { .obj = { 7, { 1,0,99,1,0,255 }, 2 }, .on_stream = profile_stream, .user_data = &gen },
+    };
+    edge_dlms_context_t server = {0};
+    server.resources = res; server.resource_count = 1; server.max_pdu_send = 128;
+    static uint8_t block_buf[256];
+    edge_dlms_server_set_block_buffer(&server, block_buf, sizeof(block_buf));
+
+    static uint8_t pool_mem[16 * 128];
+    edge_pool_t pool; edge_pool_init(&pool, pool_mem, 128, 16);
+    struct iovec chain[16]; edge_dlms_block_rx_t rx;
+    edge_dlms_block_rx_init(&rx, chain, 16, &pool.base);
+    edge_stats_reset(&rx.stats);
+
+    static edge_stats_t snap;
+    assert_int_equal(blockrx_fetch(&server, &rx, 16), EP_OK);
+    assert_int_equal(blockrx_fetch(&server, &rx, 16), EP_OK);
+    assert_int_equal(rx.total_len, 304);
+    edge_stats_snapshot(&rx.stats, &snap);
+    assert_int_equal(snap.counters[EDGE_STAT_BLOCK_RESTARTS], 0);
+
+    assert_int_equal(blockrx_fetch(&server, &rx, 2), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(blockrx_fetch(&server, &rx, 16), EP_OK);
+    assert_int_equal(rx.total_len, 304);
+    edge_stats_snapshot(&rx.stats, &snap);
+    assert_int_equal(snap.counters[EDGE_STAT_BLOCK_RESTARTS], 1);
+    edge_dlms_block_rx_reset(&rx);
+}
+#endif
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_dlms_axdr_expert_nesting),
         cmocka_unit_test(test_dlms_server_dispatch_basic),
+        cmocka_unit_test(test_dlms_index_lookup),
+        cmocka_unit_test(test_dlms_server_list_services),
+        cmocka_unit_test(test_dlms_server_stream_blocks),
+        cmocka_unit_test(test_dlms_client_block_reassembly),
+#if EDGE_ENABLE_STATS
+        cmocka_unit_test(test_dlms_block_rx_restart_stat),
+#endif
+        cmocka_unit_test(test_dlms_security_suite0),
+        cmocka_unit_test(test_dlms_security_block_resend),
+        cmocka_unit_test(test_hdlc_iframe_hcs_fcs),
+        cmocka_unit_test(test_hdlc_parse_slice_zero_copy),
+        cmocka_unit_test(test_hdlc_template_matches_builder),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -24,9 +24,52 @@ static void test_dnp3_link_layer_segmentation(void **state) {
     assert_int_equal(v.total_len, 34);
 }
 
+/**
+ * @brief [专家级测试] 链路帧剥离 CRC 后逐层以 cursor 下传，无数据拷贝
+ */
+static void test_dnp3_link_unpack_zero_copy(void **state) {
+    (void)state;
+    edge_dnp3_context_t ctx; edge_dnp3_init(&ctx, 0x0001, 0x0400);
+    uint8_t payload[40];
+    payload[0] = 0xC3; // TH: FIR|FIN, seq 3
+    for (int i = 1; i < 40; i++) payload[i] = (uint8_t)i;
+    struct iovec iov[16]; edge_vector_t v; edge_vector_init(&v, iov, 16);
+    assert_int_equal(edge_dnp3_build_link_frame(&ctx, &v, 0x44, payload, sizeof(payload)), EP_OK);
+
+    uint8_t noise[] = { 0x05, 0x00, 0x64 };
+    struct iovec rx[17] = { { noise, sizeof(noise) } };
+    for (int i = 0; i < v.used_count; i++) rx[i + 1] = v.iovs[i];
+    edge_cursor_t c; edge_cursor_init(&c, rx, v.used_count + 1);
+
+    edge_dnp3_link_header_t hdr; struct iovec blocks[EDGE_DNP3_MAX_BLOCKS]; edge_cursor_t user;
+    assert_int_equal(edge_dnp3_link_unpack(&c, &hdr, blocks, EDGE_DNP3_MAX_BLOCKS, &user), EP_OK);
+    assert_int_equal(hdr.length, sizeof(payload) + 5);
+    assert_int_equal(hdr.dest_addr, 0x0400);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+    assert_int_equal(edge_cursor_remaining(&user), sizeof(payload));
+    assert_ptr_equal(blocks[0].iov_base, payload);
+    assert_ptr_equal(blocks[2].iov_base, payload + 32);
+
+    uint8_t th; edge_cursor_t app;
+    assert_int_equal(edge_dnp3_transport_unpack(&user, &th, &app), EP_OK);
+    assert_int_equal(th, 0xC3);
+    uint8_t out[39];
+    assert_int_equal(edge_cursor_read_bytes(&app, out, sizeof(out)), EP_OK);
+    assert_memory_equal(out, payload + 1, sizeof(out));
+
+    // 截断帧不消费；数据块 CRC 错误被拒绝
+    edge_cursor_init(&c, rx, v.used_count);
+    assert_int_equal(edge_dnp3_link_unpack(&c, &hdr, blocks, EDGE_DNP3_MAX_BLOCKS, &user), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(edge_cursor_remaining(&c), v.total_len - 2); // 停在同步头，缺末块 CRC
+    payload[20] ^= 0xFF;
+    edge_cursor_init(&c, v.iovs, v.used_count);
+    assert_int_equal(edge_dnp3_link_unpack(&c, &hdr, blocks, EDGE_DNP3_MAX_BLOCKS, &user), EP_ERR_CHECKSUM);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_dnp3_link_layer_segmentation),
+        cmocka_unit_test(test_dnp3_link_unpack_zero_copy),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -22,7 +22,7 @@ static void test_iec104_expert_session(void **state) {
     struct iovec resp_iov[4]; edge_vector_t resp; edge_vector_init(&resp, resp_iov, 4);
     
     // 执行会话处理
-    assert_int_equal(edge_iec104_session_on_recv(&ctx, &c, &resp), EP_OK);
+    assert_int_equal(edge_iec104_session_on_recv(&ctx, &c, &resp, NULL), EP_OK);
     
     // 验证接收序列号 V(R) 已滚动到 2
     assert_int_equal(ctx.v_r, 2);
@@ -41,10 +41,70 @@ static void test_iec104_invalid_sync(void **state) {
     assert_int_equal(edge_iec104_parse_apci(&c, &c1, &c2), EP_ERR_INVALID_FRAME);
 }
 
+/**
+ * @brief [专家级测试] 连续两帧：ASDU 子 cursor 受长度域约束，cursor 停在下一帧
+ */
+static void test_iec104_apdu_slice(void **state) {
+    (void)state;
+    uint8_t raw[] = { 0x68, 0x0E, 0x02, 0x00, 0x02, 0x00,
+                      0x01, 0x01, 0x03, 0x00, 0x01, 0x00, 0x10, 0x00, 0x00, 0x01,
+                      0x68, 0x04, 0x01, 0x00, 0x04, 0x00 };
+    struct iovec iov[] = { { raw, 9 }, { raw + 9, sizeof(raw) - 9 } };
+    edge_cursor_t c; edge_cursor_init(&c, iov, 2);
+
+    uint16_t c1, c2; edge_cursor_t asdu;
+    assert_int_equal(edge_iec104_parse_apdu(&c, &c1, &c2, &asdu), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&asdu), 10);
+    uint8_t type; assert_int_equal(edge_cursor_read_u8(&asdu, &type), EP_OK);
+    assert_int_equal(type, 0x01);
+    assert_int_equal(edge_iec104_parse_apdu(&c, &c1, &c2, &asdu), EP_OK);
+    assert_int_equal(c1, 0x0001); // S 帧
+    assert_int_equal(edge_cursor_remaining(&asdu), 0);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+}
+
+/**
+ * @brief 会话层把 I 帧的 ASDU 以子 cursor 交出，上层直接按字段解码 (M_SP_NA_1, 自发)
+ */
+static void test_iec104_session_asdu_out(void **state) {
+    (void)state;
+    edge_iec104_context_t ctx = {0};
+    uint8_t raw[] = { 0x68, 0x0E, 0x00, 0x00, 0x00, 0x00,
+                      0x01, 0x01, 0x03, 0x00, 0x01, 0x00, 0x10, 0x20, 0x00, 0x01,
+                      0x68, 0x04, 0x43, 0x00, 0x00, 0x00 };
+    struct iovec iov[] = { { raw, 11 }, { raw + 11, sizeof(raw) - 11 } };
+    edge_cursor_t c; edge_cursor_init(&c, iov, 2);
+    struct iovec resp_iov[4]; edge_vector_t resp; edge_vector_init(&resp, resp_iov, 4);
+
+    edge_cursor_t asdu;
+    assert_int_equal(edge_iec104_session_on_recv(&ctx, &c, &resp, &asdu), EP_OK);
+    assert_int_equal(ctx.v_r, 1);
+    assert_int_equal(edge_cursor_remaining(&asdu), 10);
+    uint8_t type, vsq, siq; uint16_t cot, ca; uint8_t ioa[3];
+    assert_int_equal(edge_cursor_read_u8(&asdu, &type), EP_OK);
+    assert_int_equal(edge_cursor_read_u8(&asdu, &vsq), EP_OK);
+    assert_int_equal(edge_cursor_read_le16(&asdu, &cot), EP_OK);
+    assert_int_equal(edge_cursor_read_le16(&asdu, &ca), EP_OK);
+    assert_int_equal(edge_cursor_read_bytes(&asdu, ioa, 3), EP_OK);
+    assert_int_equal(edge_cursor_read_u8(&asdu, &siq), EP_OK);
+    assert_int_equal(type, 1); assert_int_equal(vsq, 1); assert_int_equal(cot, 3); assert_int_equal(ca, 1);
+    assert_int_equal(ioa[0] | ioa[1] << 8 | ioa[2] << 16, 0x2010);
+    assert_int_equal(siq, 1);
+    assert_int_equal(edge_cursor_remaining(&asdu), 0);
+
+    // 紧随的 TESTFR ACT：ASDU 为空，应答 TESTFR CON
+    assert_int_equal(edge_iec104_session_on_recv(&ctx, &c, &resp, &asdu), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&asdu), 0);
+    assert_int_equal(edge_vector_length(&resp), 6);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_iec104_expert_session),
         cmocka_unit_test(test_iec104_invalid_sync),
+        cmocka_unit_test(test_iec104_apdu_slice),
+        cmocka_unit_test(test_iec104_session_asdu_out),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
\ No newline at end of file
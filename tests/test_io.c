@@ -0,0 +1,120 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "cmocka.h"
+#include "libedge/edge_io.h"
+#include "libedge/edge_iec104.h"
+
+/**
+ * @brief 两条回环 socketpair 上批量发送，逐帧核对结果与内容
+ */
+static void test_io_send_batch_loopback(void **state) {
+    (void)state;
+    int a[2], b[2];
+    assert_int_equal(socketpair(AF_UNIX, SOCK_DGRAM, 0, a), 0);
+    assert_int_equal(socketpair(AF_UNIX, SOCK_DGRAM, 0, b), 0);
+
+    static const uint8_t body[] = { 0x00, 0x01, 0x00, 0x00, 0x00, 0x06 };
+    struct iovec iov[5][4]; edge_vector_t v[5];
+    for (int i = 0; i < 5; i++) {
+        edge_vector_init(&v[i], iov[i], 4);
+        assert_int_equal(edge_vector_put_be16(&v[i], (uint16_t)i), EP_OK);
+        assert_int_equal(edge_vector_append_ref(&v[i], body, sizeof(body)), EP_OK);
+    }
+    edge_vector_t empty; struct iovec eiov[1]; edge_vector_init(&empty, eiov, 1);
+
+    edge_io_frame_t frames[] = {
+        { a[0], &v[0], 0 }, { a[0], &v[1], 0 }, { a[0], &empty, 0 }, { a[0], &v[2], 0 },
+        { -1, &v[3], 0 }, { b[0], &v[4], 0 },
+    };
+    assert_int_equal(edge_io_send_batch(frames, 6, MSG_DONTWAIT), 4);
+    assert_int_equal(frames[0].result, 8);
+    assert_int_equal(frames[2].result, -EINVAL);
+    assert_int_equal(frames[3].result, 8);
+    assert_int_equal(frames[4].result, -EBADF);
+    assert_int_equal(frames[5].result, 8);
+
+    uint8_t buf[16];
+    static const uint16_t order[] = { 0, 1, 2 };
+    for (int i = 0; i < 3; i++) {
+        assert_int_equal(recv(a[1], buf, sizeof(buf), MSG_DONTWAIT), 8);
+        assert_int_equal(buf[1], order[i]);
+        assert_memory_equal(buf + 2, body, sizeof(body));
+    }
+    assert_int_equal(recv(a[1], buf, sizeof(buf), MSG_DONTWAIT), -1);
+    assert_int_equal(recv(b[1], buf, sizeof(buf), MSG_DONTWAIT), 8);
+    assert_int_equal(buf[1], 4);
+    close(a[0]); close(a[1]); close(b[0]); close(b[1]);
+}
+
+/**
+ * @brief 镜像环：跨越环尾的帧在视图中仍连续，按 recv 的任意切分逐帧解析
+ */
+static void test_io_stream_mirror_wrap(void **state) {
+    (void)state;
+    edge_stream_t s;
+    assert_int_equal(edge_stream_init(&s, 1000), 0);
+    assert_true(s.size >= 1000);
+    int sp[2];
+    assert_int_equal(socketpair(AF_UNIX, SOCK_STREAM, 0, sp), 0);
+
+    // 20 字节 I 帧：68 12 | ctrl(4) | ASDU(14)，ASDU 首字节为帧序号
+    uint8_t frame[20] = { 0x68, 0x12 };
+    uint32_t sent = 0, parsed = 0;
+    bool wrapped = false;
+    while (parsed < 2000) {
+        uint8_t chunk[333];
+        size_t n = 0;
+        while (n + sizeof(frame) <= sizeof(chunk) - 13) { // 每次写入带半帧，制造分段
+            frame[6] = (uint8_t)sent;
+            memcpy(chunk + n, frame, sizeof(frame));
+            n += sizeof(frame); sent++;
+        }
+        frame[6] = (uint8_t)sent;
+        memcpy(chunk + n, frame, 13); n += 13;
+        assert_int_equal(write(sp[0], chunk, n), (ssize_t)n);
+        for (int half = 0; half < 2; half++) {
+            if (half) { assert_int_equal(write(sp[0], frame + 13, 7), 7); sent++; }
+            assert_true(edge_stream_recv(&s, sp[1], MSG_DONTWAIT) > 0);
+            if (s.head + s.used > s.size) wrapped = true;
+
+            edge_cursor_t c;
+            edge_stream_view(&s, &c);
+            for (;;) {
+                edge_cursor_t t = c;
+                uint16_t c1, c2; edge_cursor_t asdu;
+                if (edge_iec104_parse_apdu(&t, &c1, &c2, &asdu) != EP_OK) break;
+                const uint8_t *p = edge_cursor_get_ptr(&asdu, 14); // 始终为单段快速路径
+                assert_non_null(p);
+                assert_int_equal(p[0], (uint8_t)parsed);
+                parsed++;
+                c = t;
+            }
+            edge_stream_consume(&s, c.total_read);
+        }
+    }
+    assert_true(wrapped);
+    assert_int_equal(s.used, 0);
+
+    // 写满后拒绝继续接收
+    size_t avail;
+    uint8_t *w = edge_stream_write_ptr(&s, &avail);
+    memset(w, 0x5A, avail);
+    edge_stream_commit(&s, avail);
+    assert_int_equal(edge_stream_recv(&s, sp[1], MSG_DONTWAIT), -ENOBUFS);
+    close(sp[0]); close(sp[1]);
+    edge_stream_destroy(&s);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_io_send_batch_loopback),
+        cmocka_unit_test(test_io_stream_mirror_wrap),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
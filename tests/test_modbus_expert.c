@@ -0,0 +1,299 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include "cmocka.h"
+#include "protocols/edge_modbus.h"
+
+/**
+ * @brief [专家级测试] 流水线主站：乱序响应按 TID 匹配，跨段帧与异常响应，在途上限
+ */
+static void test_modbus_pipeline_out_of_order(void **state) {
+    (void)state;
+    edge_modbus_pipeline_t p;
+    edge_modbus_pipeline_init(&p, 3, 2, 1000);
+
+    struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8);
+    uint16_t tid[3];
+    int tag[3];
+    assert_int_equal(edge_modbus_pipeline_send(&p, &v, 1, MODBUS_FC_READ_HOLDING_REGISTERS, 100, 2, 0, &tag[0], &tid[0]), EP_OK);
+    assert_int_equal(edge_modbus_pipeline_send(&p, &v, 1, MODBUS_FC_WRITE_SINGLE_REGISTER, 7, 0xBEEF, 0, &tag[1], &tid[1]), EP_OK);
+    assert_false(edge_modbus_pipeline_can_send(&p, 1));     // 单元 1 达到上限
+    assert_int_equal(edge_modbus_pipeline_send(&p, &v, 1, MODBUS_FC_READ_COILS, 0, 8, 0, NULL, NULL), EP_ERR_OVERFLOW);
+    assert_int_equal(edge_modbus_pipeline_send(&p, &v, 2, MODBUS_FC_READ_INPUT_REGISTERS, 0, 1, 0, &tag[2], &tid[2]), EP_OK);
+    assert_false(edge_modbus_pipeline_can_send(&p, 3));     // 连接达到上限
+    assert_int_equal(v.total_len, 36);
+
+    // 与记录不符的响应 (字节计数不等于 2*quantity、回显值不同) 被丢弃，记录保留
+    uint8_t bad[] = {
+        (uint8_t)(tid[0] >> 8), (uint8_t)tid[0], 0, 0, 0, 5, 1, 0x03, 0x02, 0x12, 0x34,
+        (uint8_t)(tid[1] >> 8), (uint8_t)tid[1], 0, 0, 0, 6, 1, 0x06, 0x00, 0x07, 0xBE, 0xEE,
+    };
+    struct iovec bad_iov = { bad, sizeof(bad) };
+    edge_cursor_t bc; edge_cursor_init(&bc, &bad_iov, 1);
+    edge_modbus_pipe_result_t r;
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &bc, &r), EP_ERR_INVALID_FRAME);
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &bc, &r), EP_ERR_INVALID_FRAME);
+    assert_int_equal(edge_cursor_remaining(&bc), 0);
+    assert_int_equal(p.inflight, 3);
+
+    // 响应逆序到达，且被切成不规则的段
+    uint8_t rx[] = {
+        (uint8_t)(tid[2] >> 8), (uint8_t)tid[2], 0, 0, 0, 3, 2, 0x84, 0x02,                       // 异常：非法地址
+        (uint8_t)(tid[1] >> 8), (uint8_t)tid[1], 0, 0, 0, 6, 1, 0x06, 0x00, 0x07, 0xBE, 0xEF,     // 写单寄存器回显
+        (uint8_t)(tid[0] >> 8), (uint8_t)tid[0], 0, 0, 0, 7, 1, 0x03, 0x04, 0x12, 0x34, 0x56, 0x78,
+    };
+    struct iovec seg[] = { { rx, 5 }, { rx + 5, 11 }, { rx + 16, 9 }, { rx + 25, sizeof(rx) - 25 } };
+    edge_cursor_t c; edge_cursor_init(&c, seg, 4);
+
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &c, &r), EP_OK);
+    assert_ptr_equal(r.txn.user, &tag[2]);
+    assert_int_equal(r.fc, MODBUS_FC_READ_INPUT_REGISTERS);
+    assert_int_equal(r.exception, 0x02);
+
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &c, &r), EP_OK);
+    assert_ptr_equal(r.txn.user, &tag[1]);
+    uint16_t echo[2];
+    assert_int_equal(edge_cursor_read_be16_array(&r.data, echo, 2), EP_OK);
+    assert_int_equal(echo[1], 0xBEEF);
+
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &c, &r), EP_OK);
+    assert_ptr_equal(r.txn.user, &tag[0]);
+    assert_int_equal(r.txn.addr, 100);
+    uint16_t regs[2];
+    assert_int_equal(edge_cursor_read_be16_array(&r.data, regs, 2), EP_OK);
+    assert_int_equal(regs[0], 0x1234);
+    assert_int_equal(regs[1], 0x5678);
+
+    assert_int_equal(p.inflight, 0);
+    assert_true(edge_modbus_pipeline_can_send(&p, 1));
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &c, &r), EP_ERR_INCOMPLETE_DATA);
+}
+
+/**
+ * @brief [破坏性测试] 超时回收后迟到的响应被丢弃，半帧不消费
+ */
+static void test_modbus_pipeline_timeout(void **state) {
+    (void)state;
+    edge_modbus_pipeline_t p;
+    edge_modbus_pipeline_init(&p, 0, 0, 100);
+
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    uint16_t t_old, t_new;
+    assert_int_equal(edge_modbus_pipeline_send(&p, &v, 1, MODBUS_FC_READ_HOLDING_REGISTERS, 0, 1, 1000, NULL, &t_old), EP_OK);
+    assert_int_equal(edge_modbus_pipeline_send(&p, &v, 1, MODBUS_FC_READ_HOLDING_REGISTERS, 1, 1, 1050, NULL, &t_new), EP_OK);
+
+    edge_modbus_txn_t expired[4];
+    assert_int_equal(edge_modbus_pipeline_expire(&p, 1099, expired, 4), 0);
+    assert_int_equal(edge_modbus_pipeline_expire(&p, 1100, expired, 4), 1);
+    assert_int_equal(expired[0].tid, t_old);
+    assert_int_equal(p.inflight, 1);
+
+    uint8_t late[] = { (uint8_t)(t_old >> 8), (uint8_t)t_old, 0, 0, 0, 5, 1, 0x03, 0x02, 0x00, 0x2A };
+    uint8_t ok[] = { (uint8_t)(t_new >> 8), (uint8_t)t_new, 0, 0, 0, 5, 1, 0x03, 0x02, 0x00, 0x2B };
+    struct iovec seg[] = { { late, sizeof(late) }, { ok, 8 } };
+    edge_cursor_t c; edge_cursor_init(&c, seg, 2);
+    edge_modbus_pipe_result_t r;
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &c, &r), EP_ERR_INVALID_STATE);
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &c, &r), EP_ERR_INCOMPLETE_DATA);
+    assert_int_equal(edge_cursor_remaining(&c), 8);
+
+    seg[1].iov_len = sizeof(ok);
+    edge_cursor_init(&c, &seg[1], 1);
+    assert_int_equal(edge_modbus_pipeline_on_response(&p, &c, &r), EP_OK);
+    assert_int_equal(r.txn.tid, t_new);
+    assert_int_equal(edge_modbus_pipeline_expire(&p, 5000, NULL, 0), 0);
+}
+
+/**
+ * @brief [专家级测试] 轮询计划：按单元/功能码分组，空洞合并，125 寄存器上限拆分，解码表分散写回
+ */
+static void test_modbus_poll_plan(void **state) {
+    (void)state;
+    const edge_modbus_point_t pts[] = {
+        { 1, MODBUS_FC_READ_HOLDING_REGISTERS, 100, EDGE_MODBUS_POINT_U16, false },
+        { 1, MODBUS_FC_READ_HOLDING_REGISTERS, 101, EDGE_MODBUS_POINT_I16, false },
+        { 1, MODBUS_FC_READ_HOLDING_REGISTERS, 105, EDGE_MODBUS_POINT_F32, false },
+        { 1, MODBUS_FC_READ_HOLDING_REGISTERS, 300, EDGE_MODBUS_POINT_U32, true },
+        { 1, MODBUS_FC_READ_COILS, 10, EDGE_MODBUS_POINT_BIT, false },
+        { 1, MODBUS_FC_READ_COILS, 17, EDGE_MODBUS_POINT_BIT, false },
+        { 2, MODBUS_FC_READ_HOLDING_REGISTERS, 100, EDGE_MODBUS_POINT_U16, false },
+        { 1, MODBUS_FC_READ_INPUT_REGISTERS, 0, EDGE_MODBUS_POINT_U16, false },
+        { 1, MODBUS_FC_READ_INPUT_REGISTERS, 130, EDGE_MODBUS_POINT_U16, false },
+    };
+    edge_modbus_poll_req_t reqs[8]; edge_modbus_decode_t map[16];
+    edge_modbus_poll_plan_t plan; edge_modbus_poll_plan_init(&plan, reqs, 8, map, 16);
+    plan.reg_gap = 200; plan.bit_gap = 8;
+    assert_int_equal(edge_modbus_poll_plan_compile(&plan, pts, 9), EP_OK);
+
+    static const struct { uint8_t unit, fc; uint16_t addr, qty, points; } expect[] = {
+        { 1, 0x01, 10, 8, 2 }, { 1, 0x03, 100, 7, 3 }, { 1, 0x03, 300, 2, 1 },
+        { 1, 0x04, 0, 1, 1 }, { 1, 0x04, 130, 1, 1 }, { 2, 0x03, 100, 1, 1 },
+    };
+    assert_int_equal(plan.req_count, 6);
+    for (int i = 0; i < 6; i++) {
+        assert_int_equal(reqs[i].unit_id, expect[i].unit);
+        assert_int_equal(reqs[i].fc, expect[i].fc);
+        assert_int_equal(reqs[i].addr, expect[i].addr);
+        assert_int_equal(reqs[i].quantity, expect[i].qty);
+        assert_int_equal(reqs[i].map_count, expect[i].points);
+    }
+
+    edge_modbus_value_t val[9];
+    uint8_t coils[] = { 0x81 };
+    uint8_t hr[] = { 0x00, 0x01, 0xFF, 0xFE, 0, 0, 0, 0, 0, 0, 0x3F, 0xC0, 0x00, 0x00 };
+    uint8_t swapped[] = { 0x56, 0x78, 0x12, 0x34 };
+    struct iovec iov = { coils, sizeof(coils) }; edge_cursor_t c;
+    edge_cursor_init(&c, &iov, 1);
+    assert_int_equal(edge_modbus_poll_decode(&plan, 0, &c, val), EP_OK);
+    assert_true(val[4].bit); assert_true(val[5].bit);
+    iov = (struct iovec){ hr, sizeof(hr) }; edge_cursor_init(&c, &iov, 1);
+    assert_int_equal(edge_modbus_poll_decode(&plan, 1, &c, val), EP_OK);
+    assert_int_equal(val[0].u16, 1);
+    assert_int_equal(val[1].i16, -2);
+    assert_true(val[2].f32 == 1.5f);
+    iov = (struct iovec){ swapped, sizeof(swapped) }; edge_cursor_init(&c, &iov, 1);
+    assert_int_equal(edge_modbus_poll_decode(&plan, 2, &c, val), EP_OK);
+    assert_int_equal(val[3].u32, 0x12345678);
+    edge_cursor_init(&c, &iov, 1);
+    assert_int_equal(edge_modbus_poll_decode(&plan, 1, &c, val), EP_ERR_INVALID_FRAME);
+
+    // RTU 下按请求的单元号构建，上下文的从站号不变
+    edge_modbus_context_t ctx; edge_modbus_init(&ctx, 9, false);
+    struct iovec tx[4]; edge_vector_t v; edge_vector_init(&v, tx, 4);
+    assert_int_equal(edge_modbus_poll_build(&plan, 5, &ctx, &v), EP_OK);
+    uint8_t frame[8]; size_t n;
+    assert_int_equal(edge_vector_flatten(&v, frame, sizeof(frame), &n), EP_OK);
+    const uint8_t head[] = { 0x02, 0x03, 0x00, 0x64, 0x00, 0x01 };
+    assert_memory_equal(frame, head, sizeof(head));
+    assert_int_equal(ctx.slave_id, 9);
+
+    // 超出协议上限的合并阈值在编译期拒绝
+    plan.max_regs = EDGE_MODBUS_MAX_READ_REGS + 1;
+    assert_int_equal(edge_modbus_poll_plan_compile(&plan, pts, 9), EP_ERR_INVALID_ARG);
+    plan.max_regs = EDGE_MODBUS_MAX_READ_REGS; plan.max_bits = EDGE_MODBUS_MAX_READ_BITS + 1;
+    assert_int_equal(edge_modbus_poll_plan_compile(&plan, pts, 9), EP_ERR_INVALID_ARG);
+}
+
+static int g_writes;
+static void _on_write(void *user, uint8_t unit_id, edge_modbus_table_t table, uint16_t addr, uint16_t count) {
+    (void)user; (void)unit_id; (void)table; (void)addr;
+    g_writes += count;
+}
+
+/* 以 Modbus TCP 发送一条 PDU，返回响应 PDU (去掉 MBAP) 的长度 */
+static size_t _slave_call(edge_modbus_slave_t *s, uint8_t unit, const uint8_t *pdu, size_t n, uint8_t *out) {
+    uint8_t req[300] = { 0x12, 0x34, 0, 0, (uint8_t)((n + 1) >> 8), (uint8_t)(n + 1), unit };
+    memcpy(req + 7, pdu, n);
+    struct iovec in = { req, n + 7 }; edge_cursor_t c; edge_cursor_init(&c, &in, 1);
+    struct iovec iov[8]; edge_vector_t v; edge_vector_init(&v, iov, 8);
+    assert_int_equal(edge_modbus_slave_handle_tcp(s, &c, &v), EP_OK);
+    assert_int_equal(edge_cursor_remaining(&c), 0);
+    uint8_t frame[300]; size_t len;
+    assert_int_equal(edge_vector_flatten(&v, frame, sizeof(frame), &len), EP_OK);
+    assert_int_equal(frame[0], 0x12);
+    assert_int_equal(((size_t)frame[4] << 8 | frame[5]), len - 6);
+    assert_int_equal(frame[6], unit);
+    memcpy(out, frame + 7, len - 7);
+    return len - 7;
+}
+
+/**
+ * @brief [专家级测试] 从站数据模型：稀疏段、多单元、线路序镜像零拷贝读、全功能码与异常
+ */
+static void test_modbus_slave_map(void **state) {
+    (void)state;
+    static uint8_t hr_a[10 * 2], hr_b[4 * 2], coils[3], ir[2 * 2];
+    edge_modbus_block_t hr[] = { { 0, 10, hr_a }, { 100, 4, hr_b } };
+    edge_modbus_block_t co[] = { { 0, 20, coils } };
+    edge_modbus_block_t in[] = { { 0, 2, ir } };
+    edge_modbus_unit_map_t units[] = {
+        { .unit_id = 1, .blocks = { co, NULL, hr, NULL }, .block_count = { 1, 0, 2, 0 } },
+        { .unit_id = 2, .blocks = { NULL, NULL, NULL, in }, .block_count = { 0, 0, 0, 1 } },
+    };
+    edge_modbus_slave_t s;
+    assert_int_equal(edge_modbus_slave_init(&s, units, 2), EP_OK);
+    s.on_write = _on_write;
+    const uint16_t init[] = { 0x1111, 0x2222, 0x3333 };
+    assert_int_equal(edge_modbus_slave_set_regs(&s, 1, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, 100, init, 3), EP_OK);
+    assert_int_equal(edge_modbus_slave_set_regs(&s, 1, EDGE_MODBUS_TABLE_HOLDING_REGISTERS, 9, init, 2), EP_ERR_OUT_OF_BOUNDS);
+
+    // FC03：寄存器数据直接引用镜像
+    uint8_t r[300];
+    const uint8_t rd[] = { 0x03, 0x00, 0x65, 0x00, 0x02 };
+    assert_int_equal(_slave_call(&s, 1, rd, sizeof(rd), r), 6);
+    const uint8_t rd_exp[] = { 0x03, 0x04, 0x22, 0x22, 0x33, 0x33 };
+    assert_memory_equal(r, rd_exp, sizeof(rd_exp));
+    struct iovec iov[4]; edge_vector_t v; edge_vector_init(&v, iov, 4);
+    struct iovec pin = { (void *)rd, sizeof(rd) }; edge_cursor_t pc; edge_cursor_init(&pc, &pin, 1);
+    assert_int_equal(edge_modbus_slave_handle_pdu(&s, 1, &pc, &v), EP_OK);
+    assert_ptr_equal(v.iovs[v.used_count - 1].iov_base, hr_b + 2);
+
+    // 跨段 / 数量非法 / 未知功能码
+    const uint8_t gap[] = { 0x03, 0x00, 0x08, 0x00, 0x04 };
+    const uint8_t zero[] = { 0x04, 0x00, 0x00, 0x00, 0x00 };
+    const uint8_t bad_fc[] = { 0x2B, 0x0E, 0x01, 0x00 };
+    assert_int_equal(_slave_call(&s, 1, gap, sizeof(gap), r), 2);   assert_int_equal(r[0], 0x83); assert_int_equal(r[1], 0x02);
+    assert_int_equal(_slave_call(&s, 2, zero, sizeof(zero), r), 2); assert_int_equal(r[1], 0x03);
+    assert_int_equal(_slave_call(&s, 1, bad_fc, sizeof(bad_fc), r), 2); assert_int_equal(r[0], 0xAB); assert_int_equal(r[1], 0x01);
+
+    // FC0F 写 10 个线圈，再以非对齐 (FC01 起址 3) 和对齐读回
+    const uint8_t wc[] = { 0x0F, 0x00, 0x00, 0x00, 0x0A, 0x02, 0xCD, 0x01 };
+    assert_int_equal(_slave_call(&s, 1, wc, sizeof(wc), r), 5);
+    const uint8_t rc_un[] = { 0x01, 0x00, 0x03, 0x00, 0x07 };
+    assert_int_equal(_slave_call(&s, 1, rc_un, sizeof(rc_un), r), 3);
+    assert_int_equal(r[2], (0x1CD >> 3) & 0x7F);
+    const uint8_t rc_al[] = { 0x01, 0x00, 0x00, 0x00, 0x0A };
+    assert_int_equal(_slave_call(&s, 1, rc_al, sizeof(rc_al), r), 4);
+    assert_int_equal(r[2], 0xCD); assert_int_equal(r[3], 0x01);
+
+    // FC05 / FC06 / FC10 / FC17
+    const uint8_t w5[] = { 0x05, 0x00, 0x0A, 0xFF, 0x00 };
+    const uint8_t w5_bad[] = { 0x05, 0x00, 0x0A, 0x12, 0x34 };
+    const uint8_t w6[] = { 0x06, 0x00, 0x00, 0xBE, 0xEF };
+    const uint8_t w10[] = { 0x10, 0x00, 0x01, 0x00, 0x02, 0x04, 0xAA, 0xBB, 0xCC, 0xDD };
+    const uint8_t rw17[] = { 0x17, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0x01, 0x02, 0x55, 0x66 };
+    assert_int_equal(_slave_call(&s, 1, w5, sizeof(w5), r), 5);     assert_memory_equal(r, w5, 5);
+    assert_int_equal(_slave_call(&s, 1, w5_bad, sizeof(w5_bad), r), 2); assert_int_equal(r[1], 0x03);
+    assert_int_equal(_slave_call(&s, 1, w6, sizeof(w6), r), 5);     assert_memory_equal(r, w6, 5);
+    assert_int_equal(_slave_call(&s, 1, w10, sizeof(w10), r), 5);
+    assert_int_equal(_slave_call(&s, 1, rw17, sizeof(rw17), r), 8);
+    const uint8_t rw_exp[] = { 0x17, 0x06, 0xBE, 0xEF, 0xAA, 0xBB, 0x55, 0x66 };
+    assert_memory_equal(r, rw_exp, sizeof(rw_exp));
+    bool bit;
+    assert_int_equal(edge_modbus_slave_get_bit(&s, 1, EDGE_MODBUS_TABLE_COILS, 10, &bit), EP_OK);
+    assert_true(bit);
+    assert_int_equal(g_writes, 10 + 1 + 1 + 2 + 1);
+
+    // 未登记的单元：TCP 回异常 0B，PDU 级不作应答
+    assert_int_equal(_slave_call(&s, 7, rd, sizeof(rd), r), 2);
+    assert_int_equal(r[0], 0x83); assert_int_equal(r[1], 0x0B);
+    edge_cursor_init(&pc, &pin, 1);
+    assert_int_equal(edge_modbus_slave_handle_pdu(&s, 7, &pc, &v), EP_ERR_NOT_SUPPORTED);
+
+    // 响应段表不足：已写的 MBAP 头与半个 PDU 全部撤回，输入不前进
+    uint8_t req[] = { 0x12, 0x34, 0, 0, 0, 6, 1, 0x03, 0x00, 0x65, 0x00, 0x02 };
+    struct iovec rin = { req, sizeof(req) }; edge_cursor_t rc; edge_cursor_init(&rc, &rin, 1);
+    struct iovec one[1]; edge_vector_init(&v, one, 1);
+    assert_int_equal(edge_vector_put_u8(&v, 0x55), EP_OK);
+    assert_int_equal(edge_modbus_slave_handle_tcp(&s, &rc, &v), EP_ERR_BUFFER_TOO_SMALL);
+    assert_int_equal(edge_vector_length(&v), 1);
+    assert_int_equal(v.iovs[0].iov_len, 1);
+    assert_int_equal(*edge_vector_get_ptr(&v, 0), 0x55);
+    assert_int_equal(edge_cursor_remaining(&rc), sizeof(req));
+    edge_vector_init(&v, iov, 4);
+    assert_int_equal(edge_modbus_slave_handle_tcp(&s, &rc, &v), EP_OK);
+    assert_int_equal(edge_vector_length(&v), 7 + 6);
+    assert_int_equal(edge_cursor_remaining(&rc), 0);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_modbus_pipeline_out_of_order),
+        cmocka_unit_test(test_modbus_pipeline_timeout),
+        cmocka_unit_test(test_modbus_poll_plan),
+        cmocka_unit_test(test_modbus_slave_map),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
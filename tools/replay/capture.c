@@ -0,0 +1,365 @@
+#include "capture.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CAP_MAX_STREAMS   65536u
+#define CAP_OOO_MAX       32     // 每个流方向最多暂存的乱序段
+
+#define LINKTYPE_NULL       0
+#define LINKTYPE_ETHERNET   1
+#define LINKTYPE_RAW        101
+#define LINKTYPE_LINUX_SLL  113
+#define LINKTYPE_LINUX_SLL2 276
+
+typedef struct {
+    uint8_t addr[32];       // src(16) + dst(16)，IPv4 占前 4 字节
+    uint16_t sport;
+    uint16_t dport;
+    uint8_t family;
+} flow_key_t;
+
+typedef struct {
+    uint32_t seq;
+    const uint8_t *data;
+    uint32_t len;
+    uint64_t ts_ns;
+} ooo_seg_t;
+
+typedef struct {
+    flow_key_t key;
+    bool used;
+    bool synced;            // next_seq 已确定
+    bool pending_gap;
+    uint32_t next_seq;
+    uint32_t id;
+    int ooo_count;
+    ooo_seg_t ooo[CAP_OOO_MAX];
+} flow_t;
+
+typedef struct {
+    cap_trace_t *t;
+    flow_t *flows;          // 开放寻址哈希表
+} reasm_t;
+
+/* ---------------- 字节序工具 ---------------- */
+
+static inline uint16_t _be16(const uint8_t *p) { return (uint16_t)((p[0] << 8) | p[1]); }
+static inline uint32_t _be32(const uint8_t *p) { return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]; }
+static inline uint16_t _rd16(const uint8_t *p, bool swap) {
+    uint16_t v; memcpy(&v, p, 2); return swap ? __builtin_bswap16(v) : v;
+}
+static inline uint32_t _rd32(const uint8_t *p, bool swap) {
+    uint32_t v; memcpy(&v, p, 4); return swap ? __builtin_bswap32(v) : v;
+}
+static inline bool _seq_lt(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+/* ---------------- TCP 重组 ---------------- */
+
+static uint32_t _flow_hash(const flow_key_t *k) {
+    uint32_t h = 2166136261u;
+    const uint8_t *p = (const uint8_t *)k;
+    for (size_t i = 0; i < sizeof(*k); i++) { h ^= p[i]; h *= 16777619u; }
+    return h;
+}
+
+static flow_t *_flow_lookup(reasm_t *r, const flow_key_t *k) {
+    uint32_t i = _flow_hash(k) & (CAP_MAX_STREAMS - 1);
+    for (uint32_t n = 0; n < CAP_MAX_STREAMS; n++, i = (i + 1) & (CAP_MAX_STREAMS - 1)) {
+        flow_t *f = &r->flows[i];
+        if (!f->used) {
+            if (r->t->stream_count >= CAP_MAX_STREAMS / 2) return NULL; // 负载因子上限
+            f->used = true;
+            f->key = *k;
+            f->id = r->t->stream_count++;
+            return f;
+        }
+        if (memcmp(&f->key, k, sizeof(*k)) == 0) return f;
+    }
+    return NULL;
+}
+
+static int _emit(reasm_t *r, flow_t *f, const uint8_t *data, uint32_t len, uint64_t ts_ns) {
+    cap_trace_t *t = r->t;
+    if (t->count == t->cap) {
+        size_t cap = t->cap ? t->cap * 2 : 4096;
+        cap_event_t *ev = realloc(t->events, cap * sizeof(*ev));
+        if (!ev) return -1;
+        t->events = ev; t->cap = cap;
+    }
+    cap_event_t *e = &t->events[t->count++];
+    e->stream = f->id;
+    e->sport = f->key.sport;
+    e->dport = f->key.dport;
+    e->data = data;
+    e->len = len;
+    e->ts_ns = ts_ns;
+    e->gap = f->pending_gap;
+    f->pending_gap = false;
+    f->next_seq += len;
+    return 0;
+}
+
+/**
+ * @brief 冲刷已可接续的乱序段
+ */
+static int _flush_ooo(reasm_t *r, flow_t *f) {
+    for (int i = 0; i < f->ooo_count; ) {
+        ooo_seg_t s = f->ooo[i];
+        if (_seq_lt(f->next_seq, s.seq)) { i++; continue; }
+        f->ooo[i] = f->ooo[--f->ooo_count];
+        uint32_t dup = f->next_seq - s.seq;
+        if (dup < s.len && _emit(r, f, s.data + dup, s.len - dup, s.ts_ns) != 0) return -1;
+        i = 0; // next_seq 前进后从头再找
+    }
+    return 0;
+}
+
+/**
+ * @brief 按序交付一段载荷 (剪掉与已交付数据重叠的前缀)
+ */
+static int _deliver(reasm_t *r, flow_t *f, uint32_t seq, const uint8_t *data, uint32_t len, uint64_t ts_ns) {
+    if (_seq_lt(seq, f->next_seq)) {
+        uint32_t dup = f->next_seq - seq;
+        if (dup >= len) { r->t->retransmits++; return 0; }
+        data += dup; len -= dup;
+    }
+    if (_emit(r, f, data, len, ts_ns) != 0) return -1;
+    return _flush_ooo(r, f);
+}
+
+static int _tcp_segment(reasm_t *r, const flow_key_t *k, uint32_t seq, uint8_t flags,
+                        const uint8_t *data, uint32_t len, uint64_t ts_ns) {
+    r->t->tcp_segments++;
+    flow_t *f = _flow_lookup(r, k);
+    if (!f) { r->t->skipped++; return 0; }
+
+    if (flags & 0x02) { // SYN: 新连接 (含端口复用)，丢弃旧状态
+        f->synced = true;
+        f->next_seq = seq + 1;
+        f->ooo_count = 0;
+        seq++;
+    }
+    if (len == 0) return 0;
+    if (!f->synced) { // 捕获起点落在连接中途
+        f->synced = true;
+        f->next_seq = seq;
+    }
+
+    if (!_seq_lt(f->next_seq, seq)) return _deliver(r, f, seq, data, len, ts_ns);
+
+    r->t->out_of_order++;
+    if (f->ooo_count == CAP_OOO_MAX) {
+        // 缓冲耗尽：认定丢包，跳到最早的暂存段继续
+        int first = 0;
+        for (int i = 1; i < f->ooo_count; i++) if (_seq_lt(f->ooo[i].seq, f->ooo[first].seq)) first = i;
+        r->t->gaps++;
+        f->pending_gap = true;
+        f->next_seq = f->ooo[first].seq;
+        if (_flush_ooo(r, f) != 0) return -1;
+        if (!_seq_lt(f->next_seq, seq)) return _deliver(r, f, seq, data, len, ts_ns);
+    }
+    f->ooo[f->ooo_count++] = (ooo_seg_t){ seq, data, len, ts_ns };
+    return 0;
+}
+
+/* ---------------- 链路/网络层 ---------------- */
+
+static int _packet(reasm_t *r, int linktype, const uint8_t *p, uint32_t caplen, uint64_t ts_ns) {
+    r->t->packets++;
+    uint16_t ethertype = 0;
+    const uint8_t *end = p + caplen;
+
+    switch (linktype) {
+    case LINKTYPE_ETHERNET:
+        if (caplen < 14) goto skip;
+        ethertype = _be16(p + 12); p += 14;
+        while ((ethertype == 0x8100 || ethertype == 0x88A8) && end - p >= 4) {
+            ethertype = _be16(p + 2); p += 4;
+        }
+        break;
+    case LINKTYPE_LINUX_SLL:
+        if (caplen < 16) goto skip;
+        ethertype = _be16(p + 14); p += 16;
+        break;
+    case LINKTYPE_LINUX_SLL2:
+        if (caplen < 20) goto skip;
+        ethertype = _be16(p); p += 20;
+        break;
+    case LINKTYPE_NULL:
+        if (caplen < 4) goto skip;
+        p += 4;
+        /* fall through */
+    case LINKTYPE_RAW:
+    case 12: case 14: // 部分平台的 DLT_RAW 取值
+        if (p >= end) goto skip;
+        ethertype = ((p[0] >> 4) == 6) ? 0x86DD : 0x0800;
+        break;
+    default:
+        goto skip;
+    }
+
+    flow_key_t k;
+    memset(&k, 0, sizeof(k));
+    const uint8_t *tcp;
+    const uint8_t *l4_end;
+    if (ethertype == 0x0800) {
+        if (end - p < 20 || (p[0] >> 4) != 4) goto skip;
+        size_t ihl = (size_t)(p[0] & 0x0F) * 4;
+        uint16_t tot = _be16(p + 2);
+        if (p[9] != 6 || ihl < 20 || tot < ihl || (_be16(p + 6) & 0x3FFF)) goto skip; // 非 TCP 或 IP 分片
+        if ((size_t)(end - p) < tot) goto skip;
+        k.family = 4;
+        memcpy(k.addr, p + 12, 4);
+        memcpy(k.addr + 16, p + 16, 4);
+        tcp = p + ihl;
+        l4_end = p + tot;
+    } else if (ethertype == 0x86DD) {
+        if (end - p < 40 || p[6] != 6) goto skip; // 不展开扩展头
+        uint16_t plen = _be16(p + 4);
+        if ((size_t)(end - p) < 40u + plen) goto skip;
+        k.family = 6;
+        memcpy(k.addr, p + 8, 32);
+        tcp = p + 40;
+        l4_end = tcp + plen;
+    } else {
+        goto skip;
+    }
+
+    if (l4_end - tcp < 20) goto skip;
+    size_t doff = (size_t)(tcp[12] >> 4) * 4;
+    if (doff < 20 || (size_t)(l4_end - tcp) < doff) goto skip;
+    k.sport = _be16(tcp);
+    k.dport = _be16(tcp + 2);
+    return _tcp_segment(r, &k, _be32(tcp + 4), tcp[13], tcp + doff, (uint32_t)(l4_end - tcp - doff), ts_ns);
+
+skip:
+    r->t->skipped++;
+    return 0;
+}
+
+/* ---------------- pcap / pcapng ---------------- */
+
+static int _load_pcap(reasm_t *r, const uint8_t *p, size_t n, const char **err) {
+    uint32_t magic; memcpy(&magic, p, 4);
+    bool swap = (magic == 0xD4C3B2A1u || magic == 0x4D3CB2A1u);
+    uint32_t m = swap ? __builtin_bswap32(magic) : magic;
+    uint64_t frac_ns = (m == 0xA1B23C4Du) ? 1 : 1000;
+    if (n < 24) { *err = "truncated pcap header"; return -1; }
+    int linktype = (int)(_rd32(p + 20, swap) & 0x0FFFFFFF);
+
+    size_t off = 24;
+    while (off + 16 <= n) {
+        uint64_t ts = (uint64_t)_rd32(p + off, swap) * 1000000000ull + (uint64_t)_rd32(p + off + 4, swap) * frac_ns;
+        uint32_t caplen = _rd32(p + off + 8, swap);
+        off += 16;
+        if (caplen > n - off) { r->t->skipped++; break; } // 文件尾截断
+        if (_packet(r, linktype, p + off, caplen, ts) != 0) { *err = "out of memory"; return -1; }
+        off += caplen;
+    }
+    return 0;
+}
+
+typedef struct {
+    int linktype;
+    uint64_t ns_per_unit;   // if_tsresol 为 10^-k 时的换算；0 表示需用除法
+    uint64_t units_per_sec;
+} pcapng_if_t;
+
+static int _load_pcapng(reasm_t *r, const uint8_t *p, size_t n, const char **err) {
+    pcapng_if_t ifs[64];
+    int if_count = 0;
+    bool swap = false;
+    size_t off = 0;
+
+    while (off + 12 <= n) {
+        uint32_t type = _rd32(p + off, swap);
+        if (type == 0x0A0D0D0Au) { // SHB 决定本段字节序，接口编号重新开始
+            uint32_t bom; memcpy(&bom, p + off + 8, 4);
+            swap = (bom == 0x4D3C2B1Au);
+            if_count = 0;
+        }
+        uint32_t blen = _rd32(p + off + 4, swap);
+        if (blen < 12 || (blen & 3) || blen > n - off) { *err = "malformed pcapng block"; return -1; }
+        const uint8_t *b = p + off + 8;
+        size_t body = blen - 12;
+
+        if (type == 1 && body >= 8 && if_count < (int)(sizeof(ifs) / sizeof(ifs[0]))) { // IDB
+            pcapng_if_t *ifc = &ifs[if_count++];
+            ifc->linktype = _rd16(b, swap);
+            ifc->ns_per_unit = 1000;
+            ifc->units_per_sec = 1000000;
+            size_t o = 8;
+            while (o + 4 <= body) {
+                uint16_t code = _rd16(b + o, swap), olen = _rd16(b + o + 2, swap);
+                if (code == 0 || o + 4 + olen > body) break;
+                if (code == 9 && olen >= 1) { // if_tsresol
+                    uint8_t v = b[o + 4];
+                    uint64_t ups = 1;
+                    for (int i = 0; i < (v & 0x7F) && i < 19; i++) ups *= (v & 0x80) ? 2 : 10;
+                    ifc->units_per_sec = ups;
+                    ifc->ns_per_unit = (ups <= 1000000000ull && 1000000000ull % ups == 0) ? 1000000000ull / ups : 0;
+                }
+                o += 4 + ((olen + 3u) & ~3u);
+            }
+        } else if (type == 6 && body >= 20) { // EPB
+            uint32_t ifid = _rd32(b, swap);
+            uint64_t ts = ((uint64_t)_rd32(b + 4, swap) << 32) | _rd32(b + 8, swap);
+            uint32_t caplen = _rd32(b + 12, swap);
+            if ((int)ifid < if_count && caplen <= body - 20) {
+                const pcapng_if_t *ifc = &ifs[ifid];
+                uint64_t ns = ifc->ns_per_unit ? ts * ifc->ns_per_unit
+                                               : (ts / ifc->units_per_sec) * 1000000000ull + (ts % ifc->units_per_sec) * 1000000000ull / ifc->units_per_sec;
+                if (_packet(r, ifc->linktype, b + 20, caplen, ns) != 0) { *err = "out of memory"; return -1; }
+            } else {
+                r->t->skipped++;
+            }
+        } else if (type == 3 && body >= 4 && if_count > 0) { // SPB：无时间戳，始终属于接口 0
+            uint32_t orig = _rd32(b, swap);
+            uint32_t caplen = orig < body - 4 ? orig : (uint32_t)(body - 4);
+            if (_packet(r, ifs[0].linktype, b + 4, caplen, 0) != 0) { *err = "out of memory"; return -1; }
+        }
+        off += blen;
+    }
+    return 0;
+}
+
+int cap_load(cap_trace_t *t, const char *path, const char **err) {
+    memset(t, 0, sizeof(*t));
+    *err = NULL;
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp) { *err = "cannot open file"; return -1; }
+    if (fseek(fp, 0, SEEK_END) != 0) { fclose(fp); *err = "cannot seek file"; return -1; }
+    long sz = ftell(fp);
+    rewind(fp);
+    if (sz < 4) { fclose(fp); *err = "file too short"; return -1; }
+    t->file = malloc((size_t)sz);
+    if (!t->file) { fclose(fp); *err = "out of memory"; return -1; }
+    t->file_len = fread(t->file, 1, (size_t)sz, fp);
+    fclose(fp);
+
+    reasm_t r = { t, calloc(CAP_MAX_STREAMS, sizeof(flow_t)) };
+    if (!r.flows) { cap_free(t); *err = "out of memory"; return -1; }
+
+    uint32_t magic; memcpy(&magic, t->file, 4);
+    int rc;
+    if (magic == 0x0A0D0D0Au) {
+        rc = _load_pcapng(&r, t->file, t->file_len, err);
+    } else if (magic == 0xA1B2C3D4u || magic == 0xD4C3B2A1u || magic == 0xA1B23C4Du || magic == 0x4D3CB2A1u) {
+        rc = _load_pcap(&r, t->file, t->file_len, err);
+    } else {
+        *err = "not a pcap/pcapng file";
+        rc = -1;
+    }
+    free(r.flows);
+    if (rc != 0) cap_free(t);
+    return rc;
+}
+
+void cap_free(cap_trace_t *t) {
+    free(t->events);
+    free(t->file);
+    memset(t, 0, sizeof(*t));
+}
@@ -0,0 +1,46 @@
+#ifndef LIBEDGE_REPLAY_CAPTURE_H
+#define LIBEDGE_REPLAY_CAPTURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 一次"recv"：按序重组后交付给某个 TCP 流方向的一段载荷
+ * data 指向整个捕获文件的内存映像，重放期间零拷贝。
+ */
+typedef struct {
+    uint32_t stream;        // 流方向编号 (同一连接的两个方向编号不同)
+    uint16_t sport;
+    uint16_t dport;
+    const uint8_t *data;
+    uint32_t len;
+    uint64_t ts_ns;
+    bool gap;               // 该段之前存在无法补齐的缺失，解析状态需复位
+} cap_event_t;
+
+typedef struct {
+    uint8_t *file;
+    size_t file_len;
+    cap_event_t *events;
+    size_t count;
+    size_t cap;
+    uint32_t stream_count;
+    /* 读取统计 */
+    uint64_t packets;
+    uint64_t tcp_segments;
+    uint64_t retransmits;
+    uint64_t out_of_order;
+    uint64_t gaps;
+    uint64_t skipped;       // 非 IP/TCP、截断或不支持的链路类型
+} cap_trace_t;
+
+/**
+ * @brief 读取 pcap (微秒/纳秒，任意字节序) 或 pcapng 文件并完成 TCP 流重组
+ * 支持 Ethernet(含 VLAN)、Linux SLL/SLL2、Raw IP、BSD loopback；IPv4/IPv6。
+ * @return 0 成功；-1 失败 (err 中给出原因)
+ */
+int cap_load(cap_trace_t *t, const char *path, const char **err);
+void cap_free(cap_trace_t *t);
+
+#endif
@@ -0,0 +1,392 @@
+/**
+ * @file edge_replay.c
+ * @brief 抓包重放工具：把 pcap/pcapng 中的工业协议 TCP 流按 recv 循环的视角
+ * (分段、粘包原样保留为 iovec 链) 灌入解析器，统计吞吐、解析错误与单帧时延分位数。
+ *
+ * 用法: edge_replay [--loops N] [--no-latency] [--json] [--port proto=N]... capture.pcap
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "edge_core.h"
+#include "protocols/edge_modbus.h"
+#include "protocols/edge_dlms.h"
+#include "libedge/edge_iec104.h"
+#include "libedge/edge_dnp3.h"
+#include "../../bench/bench.h"
+#include "capture.h"
+
+#define REPLAY_MAX_PENDING (64 * 1024) // 单流未成帧数据上限，超出视为失步
+
+typedef enum { PROTO_MODBUS, PROTO_IEC104, PROTO_DNP3, PROTO_DLMS, PROTO_COUNT, PROTO_NONE = PROTO_COUNT } proto_t;
+
+/**
+ * @brief 从 c 中解析一帧；to_server 表示客户端到服务端方向。
+ * 帧未收全返回 EP_ERR_INCOMPLETE_DATA (调用方回滚 cursor 等待更多数据)。
+ */
+typedef edge_error_t (*frame_parse_fn)(edge_cursor_t *c, bool to_server);
+
+typedef struct {
+    uint64_t frames;
+    uint64_t errors;
+    uint64_t bytes;
+    uint64_t resyncs;       // 失步/缺口导致丢弃的未成帧数据次数
+    uint64_t parse_ns;
+    uint32_t *lat;          // 单帧解析时延样本 (ns)
+    size_t lat_count;
+    size_t lat_cap;
+} proto_stats_t;
+
+typedef struct {
+    struct iovec *iov;
+    int head;
+    int count;
+    int cap;
+    size_t pending;
+    proto_t proto;
+    bool to_server;
+    bool classified;
+} stream_rx_t;
+
+/* 帧内字段越界是帧格式错误，不能被当作"等待更多数据" */
+#define FRAME_OK(expr) do { \
+    edge_error_t _e = (expr); \
+    if (_e != EP_OK) return (_e == EP_ERR_INCOMPLETE_DATA) ? EP_ERR_INVALID_FRAME : _e; \
+} while (0)
+
+/* ---------------- 各协议成帧与解析 ---------------- */
+
+static edge_error_t _parse_modbus(edge_cursor_t *c, bool to_server) {
+    edge_cursor_t start = *c;
+    uint16_t tid, pid, len;
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &tid));
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &pid));
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &len));
+    if (pid != 0 || len < 2 || len > 254) return EP_ERR_INVALID_FRAME;
+    edge_cursor_t pdu;
+    EP_ASSERT_OK(edge_cursor_slice(c, len, &pdu));
+
+    uint8_t unit, fc;
+    FRAME_OK(edge_cursor_read_u8(&pdu, &unit));
+    FRAME_OK(edge_cursor_read_u8(&pdu, &fc));
+    if (to_server || (fc & 0x80) || fc < 1 || fc > 4) return EP_OK; // 仅读响应走库解析路径
+
+    // 整帧 (MBAP + PDU) 交给库解析
+    edge_cursor_t frame;
+    FRAME_OK(edge_cursor_slice(&start, 6u + len, &frame));
+    edge_modbus_context_t ctx;
+    edge_modbus_init(&ctx, unit, true);
+    uint8_t out_fc;
+    const uint8_t *data;
+    size_t n;
+    FRAME_OK(edge_modbus_parse_response(&ctx, &frame, &out_fc, &data, &n));
+    if (fc >= 3 && n <= 250) { // 寄存器值按大端数组取出 (跨段时亦可)
+        uint16_t regs[125];
+        FRAME_OK(edge_cursor_skip(&pdu, 1));
+        FRAME_OK(edge_cursor_read_be16_array(&pdu, regs, n / 2));
+        if (n >= 2) BENCH_KEEP(regs[0]);
+    }
+    BENCH_KEEP(data);
+    return EP_OK;
+}
+
+static edge_error_t _parse_iec104(edge_cursor_t *c, bool to_server) {
+    (void)to_server;
+    uint16_t ctrl1, ctrl2;
+    edge_cursor_t asdu;
+    EP_ASSERT_OK(edge_iec104_parse_apdu(c, &ctrl1, &ctrl2, &asdu));
+    if ((ctrl1 & 1) == 0 && edge_cursor_remaining(&asdu) > 0) { // I 帧：ASDU 类型/可变结构限定词/传送原因
+        uint8_t hdr[4];
+        FRAME_OK(edge_cursor_read_bytes(&asdu, hdr, sizeof(hdr)));
+        BENCH_KEEP(hdr[0]);
+    }
+    return EP_OK;
+}
+
+static edge_error_t _parse_dnp3(edge_cursor_t *c, bool to_server) {
+    (void)to_server;
+    struct iovec blocks[EDGE_DNP3_MAX_BLOCKS];
+    edge_dnp3_link_header_t hdr;
+    edge_cursor_t user;
+    EP_ASSERT_OK(edge_dnp3_link_unpack(c, &hdr, blocks, EDGE_DNP3_MAX_BLOCKS, &user));
+    if (edge_cursor_remaining(&user) > 0) {
+        uint8_t th;
+        edge_cursor_t app;
+        FRAME_OK(edge_dnp3_transport_unpack(&user, &th, &app));
+        BENCH_KEEP(th);
+    }
+    return EP_OK;
+}
+
+/**
+ * @brief DLMS/COSEM TCP wrapper (IEC 62056-47)：version(2) src(2) dst(2) length(2) + APDU
+ */
+static edge_error_t _parse_dlms(edge_cursor_t *c, bool to_server) {
+    uint16_t version, src, dst, len;
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &version));
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &src));
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &dst));
+    EP_ASSERT_OK(edge_cursor_read_be16(c, &len));
+    if (version != 0x0001 || len == 0) return EP_ERR_INVALID_FRAME;
+    edge_cursor_t apdu;
+    EP_ASSERT_OK(edge_cursor_slice(c, len, &apdu));
+
+    uint8_t tag;
+    FRAME_OK(edge_cursor_read_u8(&apdu, &tag));
+    if (!to_server && tag == 0xC4) { // GET.response-normal：invoke-id、choice 后为 Data
+        uint8_t type, invoke, choice;
+        FRAME_OK(edge_cursor_read_u8(&apdu, &type));
+        FRAME_OK(edge_cursor_read_u8(&apdu, &invoke));
+        FRAME_OK(edge_cursor_read_u8(&apdu, &choice));
+        if (type == 1 && choice == 0) {
+            edge_dlms_variant_t var;
+            FRAME_OK(edge_dlms_decode_variant(&apdu, &var));
+            BENCH_KEEP(var.length);
+        }
+    }
+    return EP_OK;
+}
+
+static struct {
+    const char *name;
+    uint16_t port;
+    frame_parse_fn parse;
+} k_protos[PROTO_COUNT] = {
+    [PROTO_MODBUS] = { "modbus", 502, _parse_modbus },
+    [PROTO_IEC104] = { "iec104", 2404, _parse_iec104 },
+    [PROTO_DNP3] = { "dnp3", 20000, _parse_dnp3 },
+    [PROTO_DLMS] = { "dlms", 4059, _parse_dlms },
+};
+
+/* ---------------- 重放 ---------------- */
+
+static void _lat_push(proto_stats_t *s, uint64_t ns) {
+    if (s->lat_count == s->lat_cap) {
+        size_t cap = s->lat_cap ? s->lat_cap * 2 : 4096;
+        uint32_t *p = realloc(s->lat, cap * sizeof(*p));
+        if (!p) return; // 样本丢失不影响计数
+        s->lat = p; s->lat_cap = cap;
+    }
+    s->lat[s->lat_count++] = ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+}
+
+static void _rx_reset(stream_rx_t *rx) {
+    rx->head = rx->count = 0;
+    rx->pending = 0;
+}
+
+static int _rx_append(stream_rx_t *rx, const uint8_t *data, uint32_t len) {
+    if (rx->head > 0 && rx->count == rx->cap) { // 先回收已消费的段
+        memmove(rx->iov, rx->iov + rx->head, (size_t)(rx->count - rx->head) * sizeof(*rx->iov));
+        rx->count -= rx->head;
+        rx->head = 0;
+    }
+    if (rx->count == rx->cap) {
+        int cap = rx->cap ? rx->cap * 2 : 16;
+        struct iovec *p = realloc(rx->iov, (size_t)cap * sizeof(*p));
+        if (!p) return -1;
+        rx->iov = p; rx->cap = cap;
+    }
+    rx->iov[rx->count++] = (struct iovec){ (void *)data, len };
+    rx->pending += len;
+    return 0;
+}
+
+/**
+ * @brief 丢弃已成帧的前 n 字节 (只调整 iovec 描述，不搬移数据)
+ */
+static void _rx_consume(stream_rx_t *rx, size_t n) {
+    rx->pending -= n;
+    while (n > 0) {
+        struct iovec *v = &rx->iov[rx->head];
+        if (n < v->iov_len) {
+            v->iov_base = (uint8_t *)v->iov_base + n;
+            v->iov_len -= n;
+            return;
+        }
+        n -= v->iov_len;
+        rx->head++;
+    }
+    if (rx->head == rx->count) rx->head = rx->count = 0;
+}
+
+static proto_t _classify(const cap_event_t *e, bool *to_server) {
+    for (int p = 0; p < PROTO_COUNT; p++) {
+        if (e->dport == k_protos[p].port) { *to_server = true; return (proto_t)p; }
+        if (e->sport == k_protos[p].port) { *to_server = false; return (proto_t)p; }
+    }
+    return PROTO_NONE;
+}
+
+/**
+ * @brief 把一次 recv 的数据接到流上，并尽可能多地解析完整帧
+ */
+static void _rx_event(stream_rx_t *rx, proto_stats_t *s, const cap_event_t *e, bool latency) {
+    if (e->gap && rx->pending) { s->resyncs++; _rx_reset(rx); }
+    if (_rx_append(rx, e->data, e->len) != 0) return;
+
+    frame_parse_fn parse = k_protos[rx->proto].parse;
+    edge_cursor_t c;
+    edge_cursor_init(&c, rx->iov + rx->head, rx->count - rx->head);
+
+    size_t done = 0;
+    while (edge_cursor_remaining(&c) > 0) {
+        edge_cursor_t trial = c;
+        uint64_t t0 = bench_now_ns();
+        edge_error_t err = parse(&trial, rx->to_server);
+        uint64_t dt = bench_now_ns() - t0;
+        s->parse_ns += dt;
+
+        if (err == EP_ERR_INCOMPLETE_DATA) break;
+        if (err == EP_OK) {
+            s->frames++;
+            s->bytes += trial.total_read - c.total_read;
+            if (latency) _lat_push(s, dt);
+            c = trial;
+        } else {
+            s->errors++;
+            // 前进到解析器停下的位置 (至少 1 字节) 重新同步
+            size_t adv = trial.total_read > c.total_read ? trial.total_read - c.total_read : 1;
+            edge_cursor_skip(&c, adv);
+        }
+        done = c.total_read;
+    }
+    _rx_consume(rx, done);
+    if (rx->pending > REPLAY_MAX_PENDING) { s->resyncs++; _rx_reset(rx); }
+}
+
+static int _cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t _pct(const proto_stats_t *s, double q) {
+    if (s->lat_count == 0) return 0;
+    size_t i = (size_t)(q * (double)(s->lat_count - 1) + 0.5);
+    return s->lat[i];
+}
+
+static void _usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [--loops N] [--no-latency] [--json] [--port proto=N]... capture.pcap[ng]\n", argv0);
+    fprintf(stderr, "  protocols: modbus(502) iec104(2404) dnp3(20000) dlms(4059)\n");
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    int loops = 1;
+    bool latency = true, json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+            loops = atoi(argv[++i]);
+            if (loops < 1) loops = 1;
+        } else if (strcmp(argv[i], "--no-latency") == 0) {
+            latency = false;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            const char *arg = argv[++i];
+            const char *eq = strchr(arg, '=');
+            int p = 0;
+            for (; eq && p < PROTO_COUNT; p++) {
+                if (strlen(k_protos[p].name) == (size_t)(eq - arg) && strncmp(arg, k_protos[p].name, (size_t)(eq - arg)) == 0) break;
+            }
+            if (!eq || p == PROTO_COUNT) { _usage(argv[0]); return 2; }
+            k_protos[p].port = (uint16_t)atoi(eq + 1);
+        } else if (argv[i][0] == '-' || path) {
+            _usage(argv[0]);
+            return 2;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path) { _usage(argv[0]); return 2; }
+
+    cap_trace_t trace;
+    const char *err;
+    if (cap_load(&trace, path, &err) != 0) {
+        fprintf(stderr, "%s: %s\n", path, err);
+        return 1;
+    }
+
+    stream_rx_t *rx = calloc(trace.stream_count ? trace.stream_count : 1, sizeof(*rx));
+    proto_stats_t stats[PROTO_COUNT];
+    memset(stats, 0, sizeof(stats));
+    if (!rx) { cap_free(&trace); return 1; }
+    for (size_t i = 0; i < trace.count; i++) {
+        stream_rx_t *r = &rx[trace.events[i].stream];
+        if (!r->classified) {
+            r->classified = true;
+            r->proto = _classify(&trace.events[i], &r->to_server);
+        }
+    }
+
+    uint64_t wall0 = bench_now_ns();
+    for (int l = 0; l < loops; l++) {
+        for (uint32_t i = 0; i < trace.stream_count; i++) _rx_reset(&rx[i]);
+        for (size_t i = 0; i < trace.count; i++) {
+            const cap_event_t *e = &trace.events[i];
+            stream_rx_t *r = &rx[e->stream];
+            if (r->proto != PROTO_NONE) _rx_event(r, &stats[r->proto], e, latency);
+        }
+    }
+    uint64_t wall_ns = bench_now_ns() - wall0;
+
+    uint64_t ts_first = 0, ts_last = 0, cap_bytes = 0;
+    for (size_t i = 0; i < trace.count; i++) {
+        if (rx[trace.events[i].stream].proto == PROTO_NONE) continue;
+        if (!ts_first) ts_first = trace.events[i].ts_ns;
+        ts_last = trace.events[i].ts_ns;
+        cap_bytes += trace.events[i].len;
+    }
+    double cap_sec = ts_last > ts_first ? (double)(ts_last - ts_first) / 1e9 : 0;
+    double replay_sec = (double)wall_ns / 1e9 / loops;
+
+    if (json) {
+        printf("{\"file\":\"%s\",\"loops\":%d,\"packets\":%llu,\"tcp_segments\":%llu,\"retransmits\":%llu,"
+               "\"out_of_order\":%llu,\"gaps\":%llu,\"skipped\":%llu,\"capture_sec\":%.6f,\"replay_sec\":%.6f,\"protocols\":[",
+               path, loops, (unsigned long long)trace.packets, (unsigned long long)trace.tcp_segments,
+               (unsigned long long)trace.retransmits, (unsigned long long)trace.out_of_order,
+               (unsigned long long)trace.gaps, (unsigned long long)trace.skipped, cap_sec, replay_sec);
+    } else {
+        printf("%s: %llu packets, %llu TCP segments, %llu retransmits, %llu out-of-order, %llu gaps, %llu skipped\n",
+               path, (unsigned long long)trace.packets, (unsigned long long)trace.tcp_segments,
+               (unsigned long long)trace.retransmits, (unsigned long long)trace.out_of_order,
+               (unsigned long long)trace.gaps, (unsigned long long)trace.skipped);
+        printf("capture span %.3f s, replay %.6f s/loop (%.1fx real time), %llu stream bytes\n\n",
+               cap_sec, replay_sec, replay_sec > 0 && cap_sec > 0 ? cap_sec / replay_sec : 0, (unsigned long long)cap_bytes);
+        printf("%-8s %10s %8s %8s %12s %10s %12s %8s %8s %8s %8s\n",
+               "proto", "frames", "errors", "resyncs", "bytes", "MB/s", "frames/s", "p50ns", "p99ns", "p999ns", "maxns");
+    }
+
+    bool first = true;
+    for (int p = 0; p < PROTO_COUNT; p++) {
+        proto_stats_t *s = &stats[p];
+        if (s->frames == 0 && s->errors == 0) continue;
+        qsort(s->lat, s->lat_count, sizeof(*s->lat), _cmp_u32);
+        double sec = (double)s->parse_ns / 1e9;
+        double mbps = sec > 0 ? (double)s->bytes / sec / 1e6 : 0;
+        double fps = sec > 0 ? (double)s->frames / sec : 0;
+        uint32_t p50 = _pct(s, 0.50), p99 = _pct(s, 0.99), p999 = _pct(s, 0.999);
+        uint32_t max = s->lat_count ? s->lat[s->lat_count - 1] : 0;
+        if (json) {
+            printf("%s{\"proto\":\"%s\",\"port\":%u,\"frames\":%llu,\"errors\":%llu,\"resyncs\":%llu,\"bytes\":%llu,"
+                   "\"mb_per_sec\":%.2f,\"frames_per_sec\":%.0f,\"p50_ns\":%u,\"p99_ns\":%u,\"p999_ns\":%u,\"max_ns\":%u}",
+                   first ? "" : ",", k_protos[p].name, k_protos[p].port, (unsigned long long)s->frames,
+                   (unsigned long long)s->errors, (unsigned long long)s->resyncs, (unsigned long long)s->bytes,
+                   mbps, fps, p50, p99, p999, max);
+        } else {
+            printf("%-8s %10llu %8llu %8llu %12llu %10.1f %12.0f %8u %8u %8u %8u\n",
+                   k_protos[p].name, (unsigned long long)s->frames, (unsigned long long)s->errors,
+                   (unsigned long long)s->resyncs, (unsigned long long)s->bytes, mbps, fps, p50, p99, p999, max);
+        }
+        first = false;
+        free(s->lat);
+    }
+    if (json) printf("]}\n");
+
+    for (uint32_t i = 0; i < trace.stream_count; i++) free(rx[i].iov);
+    free(rx);
+    cap_free(&trace);
+    return 0;
+}